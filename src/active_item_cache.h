@@ -7,6 +7,7 @@
 
 #include "point.h"
 #include "safe_reference.h"
+#include "timing_wheel.h"
 
 class item;
 
@@ -26,17 +27,34 @@ struct hash<special_item_type> {
 };
 } // namespace std
 
+/**
+ * Active items of a submap or vehicle, scheduled to be processed every
+ * item::processing_speed() calls of @ref get_for_processing.
+ */
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::pair<int, std::vector<cache_reference<item>>>> active_items;
+        struct entry {
+            cache_reference<item> ref;
+            // Address of the item when it was added, so the entry can be found again
+            // after the item is gone
+            const item *key = nullptr;
+            int speed = 1;
+        };
+        using wheel_type = timing_wheel<entry>;
+
+        wheel_type schedule;
+        std::unordered_map<const item *, wheel_type::handle> handles;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
+        // Reused between calls, so processing doesn't allocate
+        std::vector<wheel_type::handle> due;
+        std::vector<item *> items_to_process;
+
+        void forget( wheel_type::handle h );
 
     public:
         /**
          * Removes the item if it is in the cache. Does nothing if the item is not in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
-         * Also removes any items that have been destroyed in the list containing it
          */
         void remove( const item *it );
 
@@ -58,18 +76,17 @@ class active_item_cache
         std::vector<item *> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
-         * Broken references encountered when collecting the items to be processed are removed from
-         * the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
+         * Moves on by one turn and returns the items due for processing in it. Every item
+         * is due once per item::processing_speed() calls. Items added since the last call
+         * are due in the next one if their interval is a single turn, otherwise their first
+         * turn is spread over the interval, but they are never left out longer than it.
+         * Broken references encountered when collecting the items are removed from the cache.
+         * The returned vector is reused by the next call.
          */
-        std::vector<item *> get_for_processing();
+        const std::vector<item *> &get_for_processing();
 
         /**
          * Returns the currently tracked list of special active items.
          */
         std::vector<item *> get_special( special_item_type type );
 };
-
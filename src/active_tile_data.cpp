@@ -70,6 +70,11 @@ void furn_transform::deserialize( JsonIn &jsin )
 
 active_tile_data::~active_tile_data() = default;
 
+std::optional<time_point> active_tile_data::next_event( time_point to ) const
+{
+    return to + 1_turns;
+}
+
 void active_tile_data::serialize( JsonOut &jsout ) const
 {
     jsout.member( "last_updated", last_updated );
@@ -87,6 +92,9 @@ class null_tile_data : public active_tile_data
 {
         void update_internal( time_point, const tripoint_abs_ms &, distribution_grid & ) override
         {}
+        std::optional<time_point> next_event( time_point ) const override {
+            return std::nullopt;
+        }
         active_tile_data *clone() const override {
             return new null_tile_data( *this );
         }
@@ -110,11 +118,13 @@ inline int ticks_between( const time_point &from, const time_point &to,
             ( from ) / to_turns<int>( tick_length ) );
 }
 
+// Solar panels produce power in chunks of this length
+static constexpr int solar_tick_turns = to_turns<int>( 10_minutes );
+
 void solar_tile::update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid )
 {
     constexpr time_point zero = time_point::from_turn( 0 );
-    constexpr time_duration tick_length = 10_minutes;
-    constexpr int tick_turns = to_turns<int>( tick_length );
+    constexpr int tick_turns = solar_tick_turns;
     time_duration till_then = get_last_updated() - zero;
     time_duration till_now = to - zero;
     // This is just for rounding to nearest tick
@@ -135,6 +145,12 @@ void solar_tile::update_internal( time_point to, const tripoint_abs_ms &p, distr
     grid.mod_resource( static_cast<int>( std::min( static_cast<std::int64_t>( INT_MAX ), produced ) ) );
 }
 
+std::optional<time_point> solar_tile::next_event( time_point to ) const
+{
+    const int next_tick = to_turn<int>( to ) / solar_tick_turns + 1;
+    return time_point::from_turn( next_tick * solar_tick_turns );
+}
+
 active_tile_data *solar_tile::clone() const
 {
     return new solar_tile( *this );
@@ -167,6 +183,11 @@ void battery_tile::update_internal( time_point, const tripoint_abs_ms &, distrib
     // TODO: Shouldn't have this function!
 }
 
+std::optional<time_point> battery_tile::next_event( time_point ) const
+{
+    return std::nullopt;
+}
+
 active_tile_data *battery_tile::clone() const
 {
     return new battery_tile( *this );
@@ -220,6 +241,12 @@ void charge_watcher_tile::update_internal( time_point /*to*/, const tripoint_abs
     }
 }
 
+std::optional<time_point> charge_watcher_tile::next_event( time_point ) const
+{
+    // The grid is updated whenever its charge could have gone up
+    return std::nullopt;
+}
+
 active_tile_data *charge_watcher_tile::clone() const
 {
     return new charge_watcher_tile( *this );
@@ -326,6 +353,12 @@ void steady_consumer_tile::update_internal( time_point to, const tripoint_abs_ms
     get_distribution_grid_tracker().get_transform_queue().add( p, transform.id, transform.msg );
 }
 
+std::optional<time_point> steady_consumer_tile::next_event( time_point ) const
+{
+    // The grid keeps track of when its consumers run dry
+    return std::nullopt;
+}
+
 active_tile_data *steady_consumer_tile::clone() const
 {
     return new steady_consumer_tile( *this );
@@ -356,6 +389,11 @@ void vehicle_connector_tile::update_internal( time_point, const tripoint_abs_ms
 {
 }
 
+std::optional<time_point> vehicle_connector_tile::next_event( time_point ) const
+{
+    return std::nullopt;
+}
+
 active_tile_data *vehicle_connector_tile::clone() const
 {
     return new vehicle_connector_tile( *this );
@@ -393,6 +431,11 @@ void countdown_tile::update_internal( time_point to, const tripoint_abs_ms &p,
 
 }
 
+std::optional<time_point> countdown_tile::next_event( time_point to ) const
+{
+    return to + time_duration::from_turns( std::max( ticks, 1 ) );
+}
+
 active_tile_data *countdown_tile::clone() const
 {
     return new countdown_tile( *this );
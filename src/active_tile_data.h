@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include "calendar.h"
 #include "coordinates.h"
@@ -39,6 +40,14 @@ class active_tile_data
             last_updated = t;
         }
 
+        /**
+         * When the tile has to be updated next after an update to @p to, as long as the energy
+         * in its grid only changes through the grid's own tiles. Updating it earlier is fine,
+         * updating it later catches up on the time in between.
+         * @returns std::nullopt if the tile has nothing to do by itself. The default is every turn.
+         */
+        virtual std::optional<time_point> next_event( time_point to ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
@@ -23,6 +23,7 @@ class battery_tile : public active_tile_data
         int max_stored;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -40,6 +41,7 @@ class charge_watcher_tile : public active_tile_data
         active_tiles::furn_transform transform;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -66,6 +68,7 @@ class solar_tile : public active_tile_data
         int power;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -81,6 +84,7 @@ class steady_consumer_tile : public active_tile_data
         active_tiles::furn_transform transform;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -93,6 +97,7 @@ class vehicle_connector_tile : public active_tile_data
         std::vector<tripoint_abs_ms> connected_vehicles;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -107,6 +112,7 @@ class countdown_tile : public active_tile_data
         int ticks = -1;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        std::optional<time_point> next_event( time_point to ) const override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
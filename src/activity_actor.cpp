@@ -1607,7 +1607,7 @@ void lockpick_activity_actor::finish( player_activity &act, Character &who )
     }
     who.practice( skill_mechanics, xp_gain );
 
-    if( !perfect && get_map().has_flag( "ALARMED", target ) &&
+    if( !perfect && get_map().has_flag( TER_FURN_FLAG( "ALARMED" ), target ) &&
         ( lock_roll + dice( 1, 30 ) ) > pick_roll ) {
         sounds::sound( who.pos(), 40, sounds::sound_t::alarm, _( "an alarm sound!" ),
                        true, "environment", "alarm" );
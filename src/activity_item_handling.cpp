@@ -80,6 +80,8 @@
 #include "weather.h"
 #include "map_utils.h"
 
+static const ter_furn_flag_id ter_furn_flag_MINEABLE( "MINEABLE" );
+
 namespace views = std::views;
 
 static const activity_id ACT_BUTCHER_FULL( "ACT_BUTCHER_FULL" );
@@ -1437,7 +1439,7 @@ static activity_reason_info can_do_activity_there( const activity_id &act, playe
         return activity_reason_info::fail( do_activity_reason::NO_ZONE );
     }
     if( act == ACT_MULTIPLE_MINE ) {
-        if( !here.has_flag( "MINEABLE", src_loc ) ) {
+        if( !here.has_flag( ter_furn_flag_MINEABLE, src_loc ) ) {
             return activity_reason_info::fail( do_activity_reason::NO_ZONE );
         }
         std::vector<item *> mining_inv = p.items_with( []( const item & itm ) {
@@ -2383,7 +2385,7 @@ static bool mine_activity( player &p, const tripoint &src_loc )
                ( itm.type->can_use( "JACKHAMMER" ) && itm.ammo_sufficient() );
     } );
     if( mining_inv.empty() || p.is_mounted() || p.is_underwater() || here.veh_at( src_loc ) ||
-        !here.has_flag( "MINEABLE", src_loc ) ) {
+        !here.has_flag( ter_furn_flag_MINEABLE, src_loc ) ) {
         return false;
     }
     item *chosen_item = nullptr;
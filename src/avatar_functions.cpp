@@ -43,6 +43,9 @@ static const itype_id itype_small_repairkit( "small_repairkit" );
 
 static const skill_id skill_weapon( "weapon" );
 
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag_id ter_furn_flag_SWIMMABLE( "SWIMMABLE" );
+
 namespace avatar_funcs
 {
 
@@ -77,7 +80,7 @@ void try_to_sleep( avatar &you, const time_duration &dur )
         }
     } else if( you.has_trait( trait_M_SKIN3 ) ) {
         fungaloid_cosplay = true;
-        if( here.has_flag_ter_or_furn( "FUNGUS", you.pos() ) ) {
+        if( here.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, you.pos() ) ) {
             you.add_msg_if_player( m_good,
                                    _( "Our fibers meld with the ground beneath us.  The gills on our neck begin to seed the air with spores as our awareness fades." ) );
         }
@@ -124,7 +127,7 @@ void try_to_sleep( avatar &you, const time_duration &dur )
             you.add_msg_if_player( m_good,
                                    _( "You lay beneath the waves' embrace, gazing up through the water's surface�" ) );
             watersleep = true;
-        } else if( here.has_flag_ter( "SWIMMABLE", you.pos() ) ) {
+        } else if( here.has_flag_ter( ter_furn_flag_SWIMMABLE, you.pos() ) ) {
             you.add_msg_if_player( m_good, _( "You settle into the water and begin to drowse�" ) );
             watersleep = true;
         }
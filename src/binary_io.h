@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Minimal helpers for compact binary save data.
+ *
+ * Unsigned integers are written as LEB128 varints (7 bits per byte, high bit set
+ * on all but the last byte), signed ones are zigzag encoded first so that small
+ * negative numbers stay small. Strings are a varint length followed by the bytes.
+ * Reading past the end of the data or an overlong varint throws std::runtime_error.
+ */
+namespace binary_io
+{
+
+inline void write_varint( std::ostream &out, std::uint64_t value )
+{
+    char buf[10];
+    int len = 0;
+    while( value >= 0x80 ) {
+        buf[len++] = static_cast<char>( ( value & 0x7f ) | 0x80 );
+        value >>= 7;
+    }
+    buf[len++] = static_cast<char>( value );
+    out.write( buf, len );
+}
+
+inline void write_svarint( std::ostream &out, std::int64_t value )
+{
+    write_varint( out, ( static_cast<std::uint64_t>( value ) << 1 ) ^ static_cast<std::uint64_t>
+                  ( value >> 63 ) );
+}
+
+inline void write_string( std::ostream &out, const std::string &str )
+{
+    write_varint( out, str.size() );
+    out.write( str.data(), str.size() );
+}
+
+inline std::uint64_t read_varint( std::istream &in )
+{
+    std::uint64_t value = 0;
+    for( int shift = 0; shift < 64; shift += 7 ) {
+        const int byte = in.get();
+        if( byte == std::char_traits<char>::eof() ) {
+            throw std::runtime_error( "unexpected end of binary data" );
+        }
+        value |= static_cast<std::uint64_t>( byte & 0x7f ) << shift;
+        if( !( byte & 0x80 ) ) {
+            return value;
+        }
+    }
+    throw std::runtime_error( "malformed varint in binary data" );
+}
+
+inline std::int64_t read_svarint( std::istream &in )
+{
+    const std::uint64_t value = read_varint( in );
+    return static_cast<std::int64_t>( value >> 1 ) ^ -static_cast<std::int64_t>( value & 1 );
+}
+
+inline std::string read_string( std::istream &in )
+{
+    const std::uint64_t len = read_varint( in );
+    // Anything this long is garbage, don't try to allocate it
+    if( len > 1u << 30 ) {
+        throw std::runtime_error( "malformed string in binary data" );
+    }
+    std::string str( len, '\0' );
+    if( !in.read( str.data(), len ) ) {
+        throw std::runtime_error( "unexpected end of binary data" );
+    }
+    return str;
+}
+
+} // namespace binary_io
@@ -20,6 +20,12 @@ int fov_3d_z_range;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
+bool parallel_lightmap = false;
+bool parallel_map_cache = false;
+bool use_legacy_pathfinding = false;
+bool pathfinding_flow_fields = false;
+bool prefetch_submaps = false;
+bool binary_submap_saves = false;
 
 FungalOptions fungal_opt;
 
@@ -80,6 +80,24 @@ extern bool pixel_minimap_option;
 */
 extern int PICKUP_RANGE;
 
+/** Cast light sources on the worker thread pool, see map::generate_lightmap. */
+extern bool parallel_lightmap;
+
+/** Build the per z-level caches on the worker thread pool, see map::build_map_cache. */
+extern bool parallel_map_cache;
+
+/** Monsters route with map::route instead of Pathfinding::route, see monster::move. */
+extern bool use_legacy_pathfinding;
+
+/** Monsters step along Dijkstra maps shared by everyone with the same goal, see Pathfinding::flow_field_step. */
+extern bool pathfinding_flow_fields;
+
+/** Read submaps ahead of the avatar on a background thread, see mapbuffer::prefetch. */
+extern bool prefetch_submaps;
+
+/** Save map quads of sqlite worlds in the compact binary format, see mapbuffer::write_quad. */
+extern bool binary_submap_saves;
+
 /**
  * If true, disables all debug messages. Only used for debugging "weird" saves.
  */
@@ -91,6 +91,11 @@ static const itype_id itype_corpse( "corpse" );
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
+static const ter_furn_flag_id ter_furn_flag_ALIGN_WORKBENCH( "ALIGN_WORKBENCH" );
+static const ter_furn_flag_id ter_furn_flag_DOOR( "DOOR" );
+static const ter_furn_flag_id ter_furn_flag_WALL( "WALL" );
+static const ter_furn_flag_id ter_furn_flag_WINDOW( "WINDOW" );
+
 static const std::array<std::string, 8> multitile_keys = {{
         "center",
         "corner",
@@ -3988,7 +3993,7 @@ void cata_tiles::get_tile_values_with_ter( const tripoint &p, const int t, const
         bool use_furniture = false;
         map &here = get_map();
 
-        if( here.has_flag( "ALIGN_WORKBENCH", p ) ) {
+        if( here.has_flag( ter_furn_flag_ALIGN_WORKBENCH, p ) ) {
             for( int i = 0; i < 4; ++i ) {
                 // align to furniture that has the workbench quality
                 const tripoint &pt = p + four_adjacent_offsets[i];
@@ -4002,8 +4007,8 @@ void cata_tiles::get_tile_values_with_ter( const tripoint &p, const int t, const
         if( val == 0 ) {
             for( int i = 0; i < 4; ++i ) {
                 const tripoint &pt = p + four_adjacent_offsets[i];
-                if( here.has_flag( "WALL", pt ) || here.has_flag( "WINDOW", pt ) ||
-                    here.has_flag( "DOOR", pt ) ) {
+                if( here.has_flag( ter_furn_flag_WALL, pt ) || here.has_flag( ter_furn_flag_WINDOW, pt ) ||
+                    here.has_flag( ter_furn_flag_DOOR, pt ) ) {
                     val += 1 << i;
                 }
             }
@@ -114,6 +114,11 @@
 #include "weather.h"
 #include "weather_gen.h"
 
+static const ter_furn_flag_id ter_furn_flag_DIGGABLE( "DIGGABLE" );
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag_id ter_furn_flag_LIQUID( "LIQUID" );
+static const ter_furn_flag_id ter_furn_flag_ROAD( "ROAD" );
+
 struct dealt_projectile_attack;
 
 static const activity_id ACT_MOVE_ITEMS( "ACT_MOVE_ITEMS" );
@@ -603,6 +608,9 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     cached_moves = source.cached_moves ;
     cached_position = source.cached_position ;
+    crafting_map_inventory = std::move( source.crafting_map_inventory );
+    cached_map_revision = source.cached_map_revision ;
+    cached_items_summary = source.cached_items_summary ;
     cached_crafting_inventory = std::move( source.cached_crafting_inventory );
 
     npc_ai_info_cache = source.npc_ai_info_cache ;
@@ -4320,7 +4328,7 @@ bool Character::in_climate_control()
         return true;
     }
     map &here = get_map();
-    if( has_trait( trait_M_SKIN3 ) && here.has_flag_ter_or_furn( "FUNGUS", pos() ) &&
+    if( has_trait( trait_M_SKIN3 ) && here.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, pos() ) &&
         in_sleep_state() ) {
         return true;
     }
@@ -4990,7 +4998,7 @@ bool Character::is_deaf() const
     return get_effect_int( effect_deaf ) > 2 || worn_with_flag( flag_DEAF ) ||
            has_trait( trait_DEAF ) ||
            ( has_active_bionic( bio_earplugs ) && !has_active_bionic( bio_ears ) ) ||
-           ( has_trait( trait_M_SKIN3 ) && get_map().has_flag_ter_or_furn( "FUNGUS", pos() )
+           ( has_trait( trait_M_SKIN3 ) && get_map().has_flag_ter_or_furn( ter_furn_flag_FUNGUS, pos() )
              && in_sleep_state() );
 }
 
@@ -10748,8 +10756,8 @@ int Character::run_cost( int base_cost, bool diag ) const
     const bool flatground = movecost < 105;
     map &here = get_map();
     // The "FLAT" tag includes soft surfaces, so not a good fit.
-    const bool on_road = flatground && here.has_flag( "ROAD", pos() );
-    const bool on_fungus = here.has_flag_ter_or_furn( "FUNGUS", pos() );
+    const bool on_road = flatground && here.has_flag( ter_furn_flag_ROAD, pos() );
+    const bool on_fungus = here.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, pos() );
 
     if( !is_mounted() ) {
         if( movecost > 100 ) {
@@ -10822,7 +10830,7 @@ int Character::run_cost( int base_cost, bool diag ) const
         // ROOTS3 does slow you down as your roots are probing around for nutrients,
         // whether you want them to or not.  ROOTS1 is just too squiggly without shoes
         // to give you some stability.  Plants are a bit of a slow-mover.  Deal.
-        if( has_trait( trait_ROOTS3 ) && here.has_flag( "DIGGABLE", pos() ) ) {
+        if( has_trait( trait_ROOTS3 ) && here.has_flag( ter_furn_flag_DIGGABLE, pos() ) ) {
             movecost += 10 * footwear_factor();
         }
 
@@ -11723,7 +11731,7 @@ void Character::knock_back_to( const tripoint &to )
     }
 
     // If we're still in the function at this point, we're actually moving a tile!
-    if( g->m.has_flag( "LIQUID", to ) && g->m.has_flag( TFLAG_DEEP_WATER, to ) ) {
+    if( g->m.has_flag( ter_furn_flag_LIQUID, to ) && g->m.has_flag( TFLAG_DEEP_WATER, to ) ) {
         if( !is_npc() ) {
             avatar_action::swim( g->m, g->u, to );
         }
@@ -2399,6 +2399,10 @@ class Character : public Creature, public location_visitable<Character>
 
         int cached_moves = 0;
         tripoint cached_position;
+        // What's around cached_position, cached_crafting_inventory adds the character's items
+        map_inventory_cache crafting_map_inventory;
+        int cached_map_revision = -1;
+        size_t cached_items_summary = 0;
         inventory cached_crafting_inventory;
 
         mutable std::array<double, npc_ai_info::num_npc_ai_info> npc_ai_info_cache;
@@ -71,6 +71,9 @@ static const itype_id itype_UPS( "UPS" );
 
 static const skill_id skill_throw( "throw" );
 
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag_id ter_furn_flag_SWIMMABLE( "SWIMMABLE" );
+
 namespace character_funcs
 {
 
@@ -288,9 +291,9 @@ comfort_response_t base_comfort_value( const Character &who, const tripoint &p )
                 }
             }
         }
-        if( fungaloid_cosplay && here.has_flag_ter_or_furn( "FUNGUS", p ) ) {
+        if( fungaloid_cosplay && here.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, p ) ) {
             comfort += static_cast<int>( comfort_level::very_comfortable );
-        } else if( watersleep && here.has_flag_ter( "SWIMMABLE", p ) ) {
+        } else if( watersleep && here.has_flag_ter( ter_furn_flag_SWIMMABLE, p ) ) {
             comfort += static_cast<int>( comfort_level::very_comfortable );
         }
     } else if( plantsleep ) {
@@ -366,7 +369,7 @@ int rate_sleep_spot( const Character &who, const tripoint &p )
         // At this point, the only limit to sleep is tiredness
         sleepy += 100;
     }
-    if( watersleep && get_map().has_flag_ter( "SWIMMABLE", p ) ) {
+    if( watersleep && get_map().has_flag_ter( ter_furn_flag_SWIMMABLE, p ) ) {
         sleepy += 10; //comfy water!
     }
 
@@ -1025,7 +1025,7 @@ void do_pause( Character &who )
                     bodypart_str_id( "hand_r" )
                 }
             }, true );
-        } else if( here.has_flag( "SWIMMABLE", who.pos() ) ) {
+        } else if( here.has_flag( TER_FURN_FLAG( "SWIMMABLE" ), who.pos() ) ) {
             who.drench( 40, { { bodypart_str_id( "foot_l" ), bodypart_str_id( "foot_r" ), bodypart_str_id( "leg_l" ), bodypart_str_id( "leg_r" ) } },
             false );
         }
@@ -1,6 +1,10 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -50,4 +54,193 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+namespace
+{
+
+constexpr int lz4_hash_bits = 14;
+// Matches are at least this long
+constexpr size_t lz4_min_match = 4;
+// The format requires the last literals to cover this many bytes
+constexpr size_t lz4_last_literals = 5;
+// and the last match to start at least this far from the end
+constexpr size_t lz4_match_end_distance = 12;
+constexpr size_t lz4_max_offset = 65535;
+// A length byte of 255 is the most a single input byte can expand to
+constexpr size_t lz4_max_ratio = 255;
+// No save file comes close to this, so a larger size header means the data is corrupt
+constexpr size_t lz4_max_decompressed_size = size_t( 256 ) << 20;
+
+uint32_t read_u32( const unsigned char *p )
+{
+    uint32_t value;
+    std::memcpy( &value, p, sizeof( value ) );
+    return value;
+}
+
+void lz4_write_length( std::vector<std::byte> &output, size_t length )
+{
+    for( ; length >= 255; length -= 255 ) {
+        output.push_back( std::byte{ 255 } );
+    }
+    output.push_back( static_cast<std::byte>( length ) );
+}
+
+void lz4_write_sequence( std::vector<std::byte> &output, const unsigned char *literals,
+                         size_t num_literals, size_t offset, size_t match_length )
+{
+    const size_t match_code = match_length == 0 ? 0 : match_length - lz4_min_match;
+    output.push_back( static_cast<std::byte>( ( std::min<size_t>( num_literals, 15 ) << 4 ) |
+                      std::min<size_t>( match_code, 15 ) ) );
+    if( num_literals >= 15 ) {
+        lz4_write_length( output, num_literals - 15 );
+    }
+    const std::byte *literal_bytes = reinterpret_cast<const std::byte *>( literals );
+    output.insert( output.end(), literal_bytes, literal_bytes + num_literals );
+    if( match_length == 0 ) {
+        return;
+    }
+    output.push_back( static_cast<std::byte>( offset & 0xff ) );
+    output.push_back( static_cast<std::byte>( offset >> 8 ) );
+    if( match_code >= 15 ) {
+        lz4_write_length( output, match_code - 15 );
+    }
+}
+
+size_t lz4_read_length( const unsigned char *&in, const unsigned char *in_end )
+{
+    size_t length = 0;
+    unsigned char byte;
+    do {
+        if( in == in_end ) {
+            throw std::runtime_error( "LZ4 data is truncated" );
+        }
+        byte = *in++;
+        length += byte;
+    } while( byte == 255 );
+    return length;
+}
+
+} // namespace
+
+void lz4_compress( const std::string &input, std::vector<std::byte> &output )
+{
+    const size_t size = input.size();
+    if( size > std::numeric_limits<uint32_t>::max() ) {
+        throw std::runtime_error( "LZ4 input is too large" );
+    }
+    output.clear();
+    output.reserve( 4 + size + size / 255 + 16 );
+    for( int shift = 0; shift < 32; shift += 8 ) {
+        output.push_back( static_cast<std::byte>( ( size >> shift ) & 0xff ) );
+    }
+
+    const unsigned char *src = reinterpret_cast<const unsigned char *>( input.data() );
+    size_t anchor = 0;
+    if( size > lz4_match_end_distance ) {
+        // Position + 1 of the last occurrence of each hashed 4 byte sequence, 0 if none
+        std::vector<uint32_t> table( size_t( 1 ) << lz4_hash_bits, 0 );
+        const size_t match_start_limit = size - lz4_match_end_distance;
+        const size_t match_end_limit = size - lz4_last_literals;
+        size_t pos = 0;
+        while( pos < match_start_limit ) {
+            const uint32_t sequence = read_u32( src + pos );
+            uint32_t &entry = table[( sequence * 2654435761u ) >> ( 32 - lz4_hash_bits )];
+            const size_t candidate = entry;
+            entry = static_cast<uint32_t>( pos + 1 );
+            if( candidate == 0 || pos - ( candidate - 1 ) > lz4_max_offset ||
+                read_u32( src + candidate - 1 ) != sequence ) {
+                pos++;
+                continue;
+            }
+            const size_t match_pos = candidate - 1;
+            size_t length = lz4_min_match;
+            while( pos + length < match_end_limit && src[match_pos + length] == src[pos + length] ) {
+                length++;
+            }
+            lz4_write_sequence( output, src + anchor, pos - anchor, pos - match_pos, length );
+            pos += length;
+            anchor = pos;
+        }
+    }
+    lz4_write_sequence( output, src + anchor, size - anchor, 0, 0 );
+}
+
+void lz4_decompress( const void *compressed_data, int compressed_size, std::string &output )
+{
+    const unsigned char *in = static_cast<const unsigned char *>( compressed_data );
+    const unsigned char *const in_end = in + compressed_size;
+    if( compressed_size < 5 ) {
+        throw std::runtime_error( "LZ4 data is truncated" );
+    }
+    size_t size = 0;
+    for( int shift = 0; shift < 32; shift += 8 ) {
+        size |= static_cast<size_t>( *in++ ) << shift;
+    }
+    if( size > lz4_max_decompressed_size ||
+        size > static_cast<size_t>( compressed_size ) * lz4_max_ratio ) {
+        throw std::runtime_error( "LZ4 data is corrupt" );
+    }
+    output.resize( size );
+    unsigned char *const out = reinterpret_cast<unsigned char *>( output.data() );
+
+    size_t pos = 0;
+    while( true ) {
+        if( in == in_end ) {
+            throw std::runtime_error( "LZ4 data is truncated" );
+        }
+        const unsigned char token = *in++;
+        size_t num_literals = token >> 4;
+        if( num_literals == 15 ) {
+            num_literals += lz4_read_length( in, in_end );
+        }
+        if( num_literals > static_cast<size_t>( in_end - in ) || num_literals > size - pos ) {
+            throw std::runtime_error( "LZ4 data is corrupt" );
+        }
+        std::memcpy( out + pos, in, num_literals );
+        in += num_literals;
+        pos += num_literals;
+        // The last sequence has no match
+        if( in == in_end ) {
+            break;
+        }
+
+        if( in_end - in < 2 ) {
+            throw std::runtime_error( "LZ4 data is truncated" );
+        }
+        const size_t offset = in[0] | ( in[1] << 8 );
+        in += 2;
+        size_t length = token & 0x0f;
+        if( length == 15 ) {
+            length += lz4_read_length( in, in_end );
+        }
+        length += lz4_min_match;
+        if( offset == 0 || offset > pos || length > size - pos ) {
+            throw std::runtime_error( "LZ4 data is corrupt" );
+        }
+        if( offset >= length ) {
+            std::memcpy( out + pos, out + pos - offset, length );
+            pos += length;
+        } else {
+            // Overlapping copy repeats the last `offset` bytes
+            for( const size_t end = pos + length; pos < end; pos++ ) {
+                out[pos] = out[pos - offset];
+            }
+        }
+    }
+    if( pos != size ) {
+        throw std::runtime_error( "LZ4 data is corrupt" );
+    }
+}
+
+void compress_with( const std::string &compression, const std::string &input,
+                    std::vector<std::byte> &output )
+{
+    if( compression == "lz4-block-v1" ) {
+        lz4_compress( input, output );
+    } else if( compression == "zlib" ) {
+        zlib_compress( input, output );
+    } else {
+        throw std::runtime_error( "Unknown compression format: " + compression );
+    }
+}
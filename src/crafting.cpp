@@ -36,6 +36,7 @@
 #include "game_constants.h"
 #include "game_inventory.h"
 #include "handle_liquid.h"
+#include "hash_utils.h"
 #include "inventory.h"
 #include "item.h"
 #include "item_contents.h"
@@ -537,6 +538,24 @@ const inventory &Character::crafting_inventory( bool clear_path )
     return crafting_inventory( tripoint_zero, PICKUP_RANGE, clear_path );
 }
 
+// Changes when the items the character has on them or their bionic tools change
+static size_t summarize_crafting_items( const Character &who )
+{
+    size_t seed = 0;
+    who.visit_items( [&seed]( const item * e ) {
+        cata::hash_combine( seed, e );
+        cata::hash_combine( seed, e->typeId() );
+        cata::hash_combine( seed, e->charges );
+        return VisitResponse::NEXT;
+    } );
+    cata::hash_combine( seed, units::to_kilojoule( who.get_power_level() ) );
+    for( const bionic &bio : who.get_bionic_collection() ) {
+        cata::hash_combine( seed, bio.powered );
+    }
+    cata::hash_combine( seed, who.has_trait( trait_BURROW ) );
+    return seed;
+}
+
 const inventory &Character::crafting_inventory( const tripoint &src_pos, int radius,
         bool clear_path )
 {
@@ -544,12 +563,27 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     if( src_pos == tripoint_zero ) {
         inv_pos = pos();
     }
+    // Checking for changes means looking at every tile in range, so don't do it more than once
+    // per move.  Anything that changes items without spending moves invalidates the cache.
     if( cached_moves == moves
         && cached_time == calendar::turn
         && cached_position == inv_pos ) {
         return cached_crafting_inventory;
     }
-    cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
+    cached_moves = moves;
+    // The map part only changes by what changed on the map since the last call
+    const inventory &around = crafting_map_inventory.update( get_map(), inv_pos, radius, this,
+                              clear_path );
+    const size_t items_summary = summarize_crafting_items( *this );
+    // Bionic and mutation tools only live until the end of the turn
+    if( cached_time == calendar::turn
+        && cached_position == inv_pos
+        && cached_map_revision == crafting_map_inventory.get_revision()
+        && cached_items_summary == items_summary ) {
+        return cached_crafting_inventory;
+    }
+    cached_crafting_inventory = around;
+    cached_crafting_inventory.build_items_type_cache();
     cached_crafting_inventory.add_items( inv, true );
     cached_crafting_inventory.add_item( primary_weapon(), true );
     cached_crafting_inventory.add_items( worn, true );
@@ -566,9 +600,10 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
         cached_crafting_inventory.add_item( *item::spawn_temporary( "shovel", calendar::turn ), true );
     }
 
-    cached_moves = moves;
     cached_time = calendar::turn;
     cached_position = inv_pos;
+    cached_map_revision = crafting_map_inventory.get_revision();
+    cached_items_summary = items_summary;
     // cache the qualities of the items in cached_crafting_inventory
     cached_crafting_inventory.update_quality_cache();
     return cached_crafting_inventory;
@@ -578,6 +613,7 @@ void Character::invalidate_crafting_inventory()
 {
     cached_time = calendar::before_time_starts;
     cached_position = tripoint_min;
+    crafting_map_inventory.invalidate();
 }
 
 void Character::make_craft( const recipe_id &id_to_make, int batch_size, const tripoint &loc )
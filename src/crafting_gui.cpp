@@ -44,6 +44,8 @@
 static const std::string flag_BLIND_EASY( "BLIND_EASY" );
 static const std::string flag_BLIND_HARD( "BLIND_HARD" );
 
+static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
+
 class npc;
 
 enum TAB_MODE {
@@ -134,19 +136,30 @@ void reset_recipe_categories()
 namespace
 {
 struct availability {
-    explicit availability( const recipe *r, int batch_size, bool known ) {
+    /**
+     * Recipes that @p candidates rules out are known to be missing something, so the exact
+     * checks only run for the rest.
+     */
+    availability( const recipe *r, int batch_size, bool known, const inventory &inv,
+                  const recipe_candidates &candidates ) {
         this->known = known;
-        const inventory &inv = get_avatar().crafting_inventory();
+        const bool debug_hammerspace = get_player_character().has_trait( trait_DEBUG_HS );
         auto all_items_filter = r->get_component_filter( recipe_filter_flags::none );
         auto no_rotten_filter = r->get_component_filter( recipe_filter_flags::no_rotten );
         const deduped_requirement_data &req = r->deduped_requirements();
-        could_craft_if_knew = req.can_make_with_inventory(
-                                  inv, all_items_filter, batch_size, cost_adjustment::start_only );
+        if( debug_hammerspace || candidates.may_make( *r ) ) {
+            could_craft_if_knew = req.can_make_with_inventory(
+                                      inv, all_items_filter, batch_size, cost_adjustment::start_only );
+            can_craft_non_rotten = could_craft_if_knew && req.can_make_with_inventory(
+                                       inv, no_rotten_filter, batch_size, cost_adjustment::start_only );
+        } else {
+            could_craft_if_knew = false;
+            can_craft_non_rotten = false;
+        }
         can_craft = known && could_craft_if_knew;
-        can_craft_non_rotten = req.can_make_with_inventory(
-                                   inv, no_rotten_filter, batch_size, cost_adjustment::start_only );
         const requirement_data &simple_req = r->simple_requirements();
-        apparently_craftable = simple_req.can_make_with_inventory(
+        apparently_craftable = ( debug_hammerspace || candidates.may_make_simple( *r ) ) &&
+                               simple_req.can_make_with_inventory(
                                    inv, all_items_filter, batch_size, cost_adjustment::start_only );
         has_all_skills = r->skill_used.is_null() ||
                          get_player_character().get_skill_level( r->skill_used ) >= r->difficulty;
@@ -266,6 +279,10 @@ static std::vector<std::string> recipe_info(
     std::vector<std::string> result = foldstring( oss.str(), fold_width );
 
     const requirement_data &req = recp.simple_requirements();
+    // The availability of the recipe may have been worked out without checking each
+    // requirement, the colors below need them checked
+    req.can_make_with_inventory( crafting_inv, recp.get_component_filter(), batch_size,
+                                 cost_adjustment::start_only );
     const std::vector<std::string> tools = req.get_folded_tools_list(
             fold_width, color, crafting_inv, batch_size );
     const std::vector<std::string> comps = req.get_folded_components_list(
@@ -481,6 +498,9 @@ const recipe *select_crafting_recipe( int &batch_size_out )
 
     const auto &available_recipes = u.get_available_recipes( crafting_inv, &helpers );
     std::unordered_map<const recipe *, availability> availability_cache( available_recipes.size() );
+    // Kept between menus, so reopening it only looks at the items that came or went
+    static recipe_candidates candidates;
+    candidates.update( crafting_inv );
 
     std::vector<const recipe *> all_recipes_flat;
     for( const auto &pr : recipe_dict ) {
@@ -615,7 +635,8 @@ const recipe *select_crafting_recipe( int &batch_size_out )
                 for( int i = 1; i <= 50; i++ ) {
                     current.push_back( chosen );
                     available.emplace_back( chosen, i,
-                                            !show_unavailable || available_recipes.contains( *chosen ) );
+                                            !show_unavailable || available_recipes.contains( *chosen ),
+                                            crafting_inv, candidates );
                 }
             } else {
                 std::vector<const recipe *> picking;
@@ -716,7 +737,8 @@ const recipe *select_crafting_recipe( int &batch_size_out )
                 for( const recipe *e : current ) {
                     if( !availability_cache.contains( e ) ) {
                         availability_cache.emplace( e, availability( e, 1,
-                                                    !show_unavailable || available_recipes.contains( *e ) ) );
+                                                    !show_unavailable || available_recipes.contains( *e ),
+                                                    crafting_inv, candidates ) );
                     }
                 }
 
@@ -7,6 +7,8 @@
 #include <utility>
 
 #include "debug.h"
+#include "game_constants.h"
+#include "line.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "mtype.h"
@@ -88,21 +90,24 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.pos()] = critter_ptr;
     add_to_faction_map( critter_ptr );
+    add_to_grid( critter, critter.pos() );
     return true;
 }
 
-void Creature_tracker::add_to_faction_map( const shared_ptr_fast<monster> &critter_ptr )
+mfaction_id Creature_tracker::tracked_faction( const monster &critter )
 {
-    assert( critter_ptr );
-    monster &critter = *critter_ptr;
-
     // Only 1 faction per mon at the moment.
     if( critter.friendly == 0 ) {
-        monster_faction_map_[ critter.faction ].insert( critter_ptr );
-    } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
+        return critter.faction;
     }
+    static const mfaction_str_id playerfaction( "player" );
+    return playerfaction;
+}
+
+void Creature_tracker::add_to_faction_map( const shared_ptr_fast<monster> &critter_ptr )
+{
+    assert( critter_ptr );
+    monster_faction_map_[ tracked_faction( *critter_ptr ) ].insert( critter_ptr );
 }
 
 void Creature_tracker::update_faction( const monster &critter )
@@ -131,6 +136,7 @@ void Creature_tracker::update_faction( const monster &critter )
     // finally, rely on existing logic to re-add critter to the appropriate faction
     // in the monster_faction_map
     add_to_faction_map( *critter_ptr );
+    add_to_grid( **critter_ptr, critter.pos() );
 }
 
 size_t Creature_tracker::size() const
@@ -144,6 +150,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
         // find ignores dead critters anyway, changing their position in the
         // monsters_by_location map is useless.
         remove_from_location_map( critter );
+        remove_from_grid( critter );
         return true;
     }
 
@@ -166,6 +173,7 @@ bool Creature_tracker::update_pos( const monster &critter, const tripoint &new_p
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( critter.pos() );
         monsters_by_location[new_pos] = *iter;
+        add_to_grid( **iter, new_pos );
         return true;
     } else {
         const tripoint &old_pos = critter.pos();
@@ -199,6 +207,87 @@ void Creature_tracker::remove_from_location_map( const monster &critter )
     }
 }
 
+tripoint Creature_tracker::grid_cell( const tripoint &pos )
+{
+    return tripoint( divide_round_to_minus_infinity( pos.x, SEEX ),
+                     divide_round_to_minus_infinity( pos.y, SEEY ), pos.z );
+}
+
+void Creature_tracker::add_to_grid( monster &critter, const tripoint &pos )
+{
+    const std::pair<mfaction_id, tripoint> location( tracked_faction( critter ), grid_cell( pos ) );
+    const auto iter = monster_grid_cells.find( &critter );
+    if( iter != monster_grid_cells.end() ) {
+        if( iter->second == location ) {
+            return;
+        }
+        remove_from_grid( critter );
+    }
+    monster_grid[location.first][location.second].push_back( &critter );
+    monster_grid_cells.emplace( &critter, location );
+}
+
+void Creature_tracker::remove_from_grid( const monster &critter )
+{
+    const auto iter = monster_grid_cells.find( &critter );
+    if( iter == monster_grid_cells.end() ) {
+        return;
+    }
+    const auto &[faction, cell] = iter->second;
+    std::unordered_map<tripoint, std::vector<monster *>> &cells = monster_grid[faction];
+    std::vector<monster *> &in_cell = cells[cell];
+    in_cell.erase( std::ranges::find( in_cell, &critter ) );
+    if( in_cell.empty() ) {
+        cells.erase( cell );
+    }
+    monster_grid_cells.erase( iter );
+}
+
+std::vector<monster *> Creature_tracker::monsters_in_radius( const tripoint &pos, int radius,
+        const faction_filter &filter ) const
+{
+    std::vector<monster *> result;
+    const tripoint min_cell = grid_cell( pos - tripoint( radius, radius, 0 ) );
+    const tripoint max_cell = grid_cell( pos + tripoint( radius, radius, 0 ) );
+    const int min_z = std::max( pos.z - radius, -OVERMAP_DEPTH );
+    const int max_z = std::min( pos.z + radius, OVERMAP_HEIGHT );
+    const size_t num_cells = static_cast<size_t>( max_cell.x - min_cell.x + 1 ) *
+                             ( max_cell.y - min_cell.y + 1 ) * ( max_z - min_z + 1 );
+    const auto add_from_cell = [&]( const std::vector<monster *> &in_cell ) {
+        for( monster *critter : in_cell ) {
+            if( !critter->is_dead() && square_dist( pos, critter->pos() ) <= radius ) {
+                result.push_back( critter );
+            }
+        }
+    };
+    for( const auto &[faction, cells] : monster_grid ) {
+        if( filter && !filter( faction ) ) {
+            continue;
+        }
+        // Big queries over sparse factions are cheaper the other way around
+        if( cells.size() < num_cells ) {
+            for( const auto &[cell, in_cell] : cells ) {
+                if( cell.x >= min_cell.x && cell.x <= max_cell.x && cell.y >= min_cell.y &&
+                    cell.y <= max_cell.y && cell.z >= min_z && cell.z <= max_z ) {
+                    add_from_cell( in_cell );
+                }
+            }
+            continue;
+        }
+        for( int z = min_z; z <= max_z; z++ ) {
+            for( int x = min_cell.x; x <= max_cell.x; x++ ) {
+                for( int y = min_cell.y; y <= max_cell.y; y++ ) {
+                    const auto iter = cells.find( tripoint( x, y, z ) );
+                    if( iter != cells.end() ) {
+                        add_from_cell( iter->second );
+                    }
+                }
+            }
+        }
+    }
+    return result;
+}
+
 void Creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::ranges::find_if( monsters_list,
@@ -220,6 +309,7 @@ void Creature_tracker::remove( const monster &critter )
         }
     }
     remove_from_location_map( critter );
+    remove_from_grid( critter );
     removed_.push_back( *iter );
     monsters_list.erase( iter );
 }
@@ -229,6 +319,8 @@ void Creature_tracker::clear()
     monsters_list.clear();
     monsters_by_location.clear();
     monster_faction_map_.clear();
+    monster_grid.clear();
+    monster_grid_cells.clear();
     removed_.clear();
 }
 
@@ -236,9 +328,12 @@ void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
     monster_faction_map_.clear();
+    monster_grid.clear();
+    monster_grid_cells.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
         monsters_by_location[mon_ptr->pos()] = mon_ptr;
         add_to_faction_map( mon_ptr );
+        add_to_grid( *mon_ptr, mon_ptr->pos() );
     }
 }
 
@@ -277,6 +372,12 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     if( second_ptr ) {
         monsters_by_location[second.pos()] = second_ptr;
     }
+    if( monster_grid_cells.contains( &first ) ) {
+        add_to_grid( first, first.pos() );
+    }
+    if( monster_grid_cells.contains( &second ) ) {
+        add_to_grid( second, second.pos() );
+    }
 }
 
 bool Creature_tracker::kill_marked_for_death()
@@ -310,6 +411,7 @@ void Creature_tracker::remove_dead()
         const monster &critter = **iter;
         if( critter.is_dead() ) {
             remove_from_location_map( critter );
+            remove_from_grid( critter );
             iter = monsters_list.erase( iter );
         } else {
             ++iter;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "memory_fast.h"
@@ -19,6 +21,8 @@ class Creature_tracker
     private:
 
         void add_to_faction_map( const shared_ptr_fast<monster> &critter );
+        /** The faction @p critter is filed under, friendly monsters count as the player's. */
+        static mfaction_id tracked_faction( const monster &critter );
 
         class weak_ptr_comparator
         {
@@ -91,11 +95,32 @@ class Creature_tracker
             return monster_faction_map_;
         }
 
+        using faction_filter = std::function<bool( const mfaction_id & )>;
+        /**
+         * Living monsters within @p radius of @p pos, measured as the largest of the x, y
+         * and z distances, so anything within @ref rl_dist is included.
+         * Only monsters whose faction (see @ref factions) passes @p filter are returned,
+         * the filter is called once per faction, not per monster.
+         * Served from a grid of submap sized cells, so it only looks at nearby monsters.
+         */
+        std::vector<monster *> monsters_in_radius( const tripoint &pos, int radius,
+                const faction_filter &filter = nullptr ) const;
+
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint, shared_ptr_fast<monster>> monsters_by_location;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+
+        static tripoint grid_cell( const tripoint &pos );
+        /** Files @p critter in @ref monster_grid at @p pos, moving it if it was there already. */
+        void add_to_grid( monster &critter, const tripoint &pos );
+        void remove_from_grid( const monster &critter );
+        /** Monsters by faction and by @ref grid_cell */
+        std::unordered_map<mfaction_id, std::unordered_map<tripoint, std::vector<monster *>>>
+                monster_grid;
+        /** Faction and cell each monster in @ref monster_grid is filed under */
+        std::unordered_map<const monster *, std::pair<mfaction_id, tripoint>> monster_grid_cells;
 };
 
 
@@ -92,6 +92,7 @@
 #include "string_utils.h"
 #include "trait_group.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -188,6 +189,8 @@ enum debug_menu_index {
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_VEHICLE_EXPORT_JSON,
     DEBUG_HOUR_TIMER,
+    DEBUG_TURN_PROFILER,
+    DEBUG_TURN_PROFILER_CSV,
     DEBUG_NESTED_MAPGEN,
     DEBUG_RESET_IGNORED_MESSAGES,
     DEBUG_RELOAD_TILES,
@@ -239,6 +242,8 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER, true, 'P', _( "Toggle turn profiler overlay" ) ) },
+            { uilist_entry( DEBUG_TURN_PROFILER_CSV, true, 'x', _( "Toggle turn profiler CSV log" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
@@ -1868,6 +1873,18 @@ void debug()
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case DEBUG_TURN_PROFILER:
+            turn_profiler::toggle_overlay();
+            break;
+        case DEBUG_TURN_PROFILER_CSV:
+            if( !turn_profiler::toggle_csv_log() ) {
+                popup( _( "Failed to open %s for writing." ), turn_profiler::csv_path() );
+            } else if( turn_profiler::csv_logging() ) {
+                add_msg( m_info, _( "Writing turn times to %s." ), turn_profiler::csv_path() );
+            } else {
+                add_msg( m_info, _( "Stopped writing turn times." ) );
+            }
+            break;
         case DEBUG_CHANGE_TIME: {
             auto set_turn = [&]( const int initial, const time_duration & factor, const char *const msg ) {
                 const auto text = string_input_popup()
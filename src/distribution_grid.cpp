@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_set>
 
 #include "character.h"
@@ -32,6 +33,17 @@ distribution_grid::distribution_grid( const std::vector<tripoint_abs_sm> &global
             const tripoint_abs_ms abs_pos = project_combine( sm_coord, active.first );
             contents[sm_coord].emplace_back( active.first, abs_pos );
             flat_contents.emplace_back( abs_pos );
+            if( const auto *battery = dynamic_cast<const battery_tile *>( active.second.get() ) ) {
+                battery_locations.emplace_back( abs_pos );
+                battery_capacity += battery->max_stored;
+            } else if( dynamic_cast<const vehicle_connector_tile *>( active.second.get() ) ) {
+                connector_locations.emplace_back( abs_pos );
+            } else if( const auto *consumer =
+                           dynamic_cast<const steady_consumer_tile *>( active.second.get() ) ) {
+                const int every = std::max( 1, to_turns<int>( consumer->consume_every ) );
+                drain_per_turn += static_cast<double>( consumer->power ) / every;
+                drain_per_tick += consumer->power;
+            }
         }
     }
 }
@@ -47,6 +59,15 @@ distribution_grid::operator bool() const
 }
 
 void distribution_grid::update( time_point to )
+{
+    updating = true;
+    update_tiles( to );
+    updating = false;
+    last_update = to;
+    schedule( to );
+}
+
+void distribution_grid::update_tiles( time_point to )
 {
     for( const auto &c : contents ) {
         submap *sm = mb.lookup_submap( c.first );
@@ -66,44 +87,103 @@ void distribution_grid::update( time_point to )
     }
 }
 
+void distribution_grid::schedule( time_point to )
+{
+    next_update = to + calendar::INDEFINITELY_LONG_DURATION;
+    const auto before = [this]( const time_point & t ) {
+        next_update = std::min( next_update, t );
+    };
+    for( const auto &c : contents ) {
+        submap *sm = mb.lookup_submap( c.first );
+        if( sm == nullptr ) {
+            before( to + 1_turns );
+            return;
+        }
+        for( const tile_location &loc : c.second ) {
+            const auto active = sm->active_furniture.find( loc.on_submap );
+            if( active == sm->active_furniture.end() || !active->second ) {
+                before( to + 1_turns );
+                return;
+            }
+            if( const std::optional<time_point> event = active->second->next_event( to ) ) {
+                before( *event );
+            }
+        }
+    }
+
+    // Connected vehicles charge and drain on their own, anything that depends on them
+    // has to keep checking
+    for( const tripoint_abs_ms &loc : connector_locations ) {
+        const vehicle_connector_tile *connector =
+            active_tiles::furn_at<vehicle_connector_tile>( loc );
+        if( connector != nullptr && !connector->connected_vehicles.empty() ) {
+            before( to + 1_turns );
+            return;
+        }
+    }
+
+    // Between the events above the charge only goes down, at the rate the consumers drain it.
+    // They can't run dry before the batteries would be empty even if every one of them took
+    // its next tick right away.
+    if( drain_per_tick > 0 && drain_per_turn > 0 ) {
+        std::int64_t spare = -drain_per_tick;
+        for( const tripoint_abs_ms &loc : battery_locations ) {
+            const battery_tile *battery = active_tiles::furn_at<battery_tile>( loc );
+            if( battery != nullptr ) {
+                spare += battery->get_resource();
+            }
+        }
+        const double turns = spare > 0 ? spare / drain_per_turn : 0.0;
+        const double max_turns = to_turns<double>( calendar::INDEFINITELY_LONG_DURATION );
+        const int wait = static_cast<int>( std::clamp( turns, 1.0, max_turns ) );
+        before( to + time_duration::from_turns( wait ) );
+    }
+}
+
 // TODO: Shouldn't be here
 #include "vehicle.h"
 #include "vehicle_part.h"
 static itype_id itype_battery( "battery" );
 int distribution_grid::mod_resource( int amt, bool recurse )
 {
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                int amt_before_battery = amt;
-                amt = battery->mod_resource( amt );
-                if( cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + amt_before_battery - amt;
-                }
-                if( amt == 0 ) {
-                    return 0;
-                }
+    if( !updating ) {
+        schedule_update();
+    }
+    // The batteries only need a look if they aren't all full or all empty already
+    const int stored = get_resource( false );
+    if( ( amt > 0 && stored < battery_capacity ) || ( amt < 0 && stored > 0 ) ) {
+        for( const tripoint_abs_ms &loc : battery_locations ) {
+            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc );
+            if( battery == nullptr ) {
                 continue;
             }
-
-            if( !recurse ) {
-                continue;
+            int amt_before_battery = amt;
+            amt = battery->mod_resource( amt );
+            cached_amount_here = *cached_amount_here + amt_before_battery - amt;
+            if( amt == 0 ) {
+                return 0;
             }
+        }
+    }
+
+    if( !recurse ) {
+        return amt;
+    }
 
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
-                }
+    std::vector<vehicle *> connected_vehicles;
+    for( const tripoint_abs_ms &loc : connector_locations ) {
+        vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc );
+        if( connector == nullptr ) {
+            continue;
+        }
+        for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
+            vehicle *veh = vehicle::find_vehicle( veh_abs );
+            if( veh == nullptr ) {
+                // TODO: Disconnect
+                debugmsg( "lost vehicle at %s", veh_abs.to_string() );
+                continue;
             }
+            connected_vehicles.push_back( veh );
         }
     }
 
@@ -121,42 +201,36 @@ int distribution_grid::mod_resource( int amt, bool recurse )
 
 int distribution_grid::get_resource( bool recurse ) const
 {
-    if( !recurse ) {
-        if( cached_amount_here ) {
-            return *cached_amount_here;
-        } else {
-            cached_amount_here = 0;
-        }
+    if( !recurse && cached_amount_here ) {
+        return *cached_amount_here;
     }
     int res = 0;
-    std::vector<vehicle *> connected_vehicles;
-    for( const auto &c : contents ) {
-        for( const tile_location &loc : c.second ) {
-            battery_tile *battery = active_tiles::furn_at<battery_tile>( loc.absolute );
-            if( battery != nullptr ) {
-                res += battery->get_resource();
-                if( !recurse && cached_amount_here ) {
-                    cached_amount_here = *cached_amount_here + res;
-                }
-                continue;
-            }
+    for( const tripoint_abs_ms &loc : battery_locations ) {
+        const battery_tile *battery = active_tiles::furn_at<battery_tile>( loc );
+        if( battery != nullptr ) {
+            res += battery->get_resource();
+        }
+    }
+    if( !recurse ) {
+        cached_amount_here = res;
+        return res;
+    }
 
-            if( !recurse ) {
+    std::vector<vehicle *> connected_vehicles;
+    for( const tripoint_abs_ms &loc : connector_locations ) {
+        const vehicle_connector_tile *connector =
+            active_tiles::furn_at<vehicle_connector_tile>( loc );
+        if( connector == nullptr ) {
+            continue;
+        }
+        for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
+            vehicle *veh = vehicle::find_vehicle( veh_abs );
+            if( veh == nullptr ) {
+                // TODO: Disconnect
+                debugmsg( "lost vehicle at %s", veh_abs.to_string() );
                 continue;
             }
-
-            vehicle_connector_tile *connector = active_tiles::furn_at<vehicle_connector_tile>( loc.absolute );
-            if( connector != nullptr ) {
-                for( const tripoint_abs_ms &veh_abs : connector->connected_vehicles ) {
-                    vehicle *veh = vehicle::find_vehicle( veh_abs );
-                    if( veh == nullptr ) {
-                        // TODO: Disconnect
-                        debugmsg( "lost vehicle at %s", veh_abs.to_string() );
-                        continue;
-                    }
-                    connected_vehicles.push_back( veh );
-                }
-            }
+            connected_vehicles.push_back( veh );
         }
     }
 
@@ -164,9 +238,6 @@ int distribution_grid::get_resource( bool recurse ) const
     if( !connected_vehicles.empty() ) {
         res = connected_vehicles.front()->fuel_left( itype_battery, true );
     }
-    if( !recurse ) {
-        cached_amount_here = res;
-    }
 
     return res;
 }
@@ -266,7 +337,12 @@ distribution_grid &distribution_grid_tracker::grid_at( const tripoint_abs_ms &p
     tripoint_abs_sm sm_pos = project_to<coords::sm>( p );
     auto iter = parent_distribution_grids.find( sm_pos );
     if( iter != parent_distribution_grids.end() ) {
-        return *iter->second;
+        distribution_grid &grid = *iter->second;
+        // Grids that had nothing to do are behind, bring them up to date before they are used
+        if( !grid.updating && !grid.empty() && grid.last_update < calendar::turn ) {
+            grid.update( calendar::turn );
+        }
+        return grid;
     }
 
     // This is ugly for the const case
@@ -275,6 +351,7 @@ distribution_grid &distribution_grid_tracker::grid_at( const tripoint_abs_ms &p
 
 const distribution_grid &distribution_grid_tracker::grid_at( const tripoint_abs_ms &p ) const
 {
+    // Creating the grid or catching it up with the current turn changes the tracker
     return const_cast<const distribution_grid &>(
                const_cast<distribution_grid_tracker *>( this )->grid_at( p ) );
 }
@@ -349,7 +426,9 @@ std::string grid_furn_transform_queue::to_string() const
 void distribution_grid_tracker::update( time_point to )
 {
     for( const shared_ptr_fast<distribution_grid> &grid : grids_requiring_updates ) {
-        grid->update( to );
+        if( to >= grid->next_update ) {
+            grid->update( to );
+        }
     }
     transform_queue.apply( mb, *this, get_player_character(), get_map() );
     transform_queue.clear();
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <vector>
 #include <map>
+#include <optional>
 #include <unordered_set>
 
 #include "calendar.h"
@@ -43,16 +44,44 @@ class distribution_grid
         std::map<tripoint_abs_sm, std::vector<tile_location>> contents;
         std::vector<tripoint_abs_ms> flat_contents;
         std::vector<tripoint_abs_sm> submap_coords;
+        /** The batteries and the vehicle connectors among the contents. */
+        std::vector<tripoint_abs_ms> battery_locations;
+        std::vector<tripoint_abs_ms> connector_locations;
+        /** Most the batteries of the grid can hold together. */
+        int battery_capacity = 0;
+        /**
+         * What the steady consumers of the grid take per turn on average, and at most
+         * in a single turn.
+         */
+        double drain_per_turn = 0.0;
+        std::int64_t drain_per_tick = 0;
 
         mutable std::optional<int> cached_amount_here;
 
+        /** Time the grid was last updated to. */
+        time_point last_update = calendar::before_time_starts;
+        /**
+         * Nothing happens on the grid before then, unless something from outside changes it.
+         * Updating the grid works out everything up to the time it's updated to at once.
+         */
+        time_point next_update = calendar::before_time_starts;
+        bool updating = false;
+
         mapbuffer &mb;
 
+        void update_tiles( time_point to );
+        /** Works out @ref next_update after an update to @p to. */
+        void schedule( time_point to );
+
     public:
         distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords, mapbuffer &buffer );
         bool empty() const;
         explicit operator bool() const;
         void update( time_point to );
+        /** Updates the grid on the next turn, for changes it can't notice by itself. */
+        void schedule_update() {
+            next_update = calendar::before_time_starts;
+        }
         int mod_resource( int amt, bool recurse = true );
         int get_resource( bool recurse = true ) const;
         const std::vector<tripoint_abs_ms> &get_contents() const {
@@ -142,6 +171,10 @@ class distribution_grid_tracker
         distribution_grid_tracker( distribution_grid_tracker && ) = default;
         /**
          * Gets grid at given global map square coordinate. @ref map::getabs
+         * Grids that were left alone because nothing could happen on them are brought up
+         * to date with the current turn first. That runs the grid simulation and can queue
+         * furniture transforms, even through the const overload, so read the state of
+         * anything on the grid only after calling this.
          */
         /**@{*/
         distribution_grid &grid_at( const tripoint_abs_ms &p );
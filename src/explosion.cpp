@@ -1641,7 +1641,7 @@ void emp_blast( const tripoint &p )
     map &here = get_map();
     Character &u = get_player_character();
     const bool sight = u.sees( p );
-    if( here.has_flag( "CONSOLE", p ) ) {
+    if( here.has_flag( TER_FURN_FLAG( "CONSOLE" ), p ) ) {
         if( sight ) {
             add_msg( _( "The %s is rendered non-functional!" ), here.tername( p ) );
         }
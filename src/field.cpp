@@ -145,6 +145,59 @@ field::field()
 {
 }
 
+field::field( const field &other )
+    : inline_entries( other.inline_entries ),
+      overflow( other.overflow ? std::make_unique<std::deque<value_type>>( *other.overflow ) : nullptr ),
+      _displayed_field_type( other._displayed_field_type ),
+      count( other.count )
+{
+}
+
+field &field::operator=( const field &other )
+{
+    if( this != &other ) {
+        *this = field( other );
+    }
+    return *this;
+}
+
+field::~field() = default;
+
+field::value_type *field::find_slot( const field_type_id &type )
+{
+    for( value_type &entry : inline_entries ) {
+        if( entry.first == type ) {
+            return &entry;
+        }
+    }
+    if( overflow ) {
+        for( value_type &entry : *overflow ) {
+            if( entry.first == type ) {
+                return &entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+const field::value_type *field::find_slot( const field_type_id &type ) const
+{
+    return const_cast<field *>( this )->find_slot( type );
+}
+
+size_t field::next_slot( const field_type_id &type ) const
+{
+    // There are rarely more than a couple of entries, a scan beats keeping them sorted
+    size_t result = npos;
+    for( size_t i = 0; i < slot_count(); i++ ) {
+        const field_type_id &candidate = slot( i ).first;
+        if( candidate && type < candidate && ( result == npos || candidate < slot( result ).first ) ) {
+            result = i;
+        }
+    }
+    return result;
+}
+
 /*
 Function: find_field
 Returns a field entry corresponding to the field_type_id parameter passed in. If no fields are found then returns NULL.
@@ -152,26 +205,20 @@ Good for checking for existence of a field: if(myfield.find_field(fd_fire)) woul
 */
 field_entry *field::find_field( const field_type_id &field_type_to_find )
 {
-    if( !_displayed_field_type ) {
+    if( !_displayed_field_type || !field_type_to_find ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    value_type *entry = find_slot( field_type_to_find );
+    return entry ? &entry->second : nullptr;
 }
 
 const field_entry *field::find_field_c( const field_type_id &field_type_to_find ) const
 {
-    if( !_displayed_field_type ) {
+    if( !_displayed_field_type || !field_type_to_find ) {
         return nullptr;
     }
-    const auto it = _field_type_list.find( field_type_to_find );
-    if( it != _field_type_list.end() ) {
-        return &it->second;
-    }
-    return nullptr;
+    const value_type *entry = find_slot( field_type_to_find );
+    return entry ? &entry->second : nullptr;
 }
 
 const field_entry *field::find_field( const field_type_id &field_type_to_find ) const
@@ -195,15 +242,14 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         debugmsg( "Tried to add null field" );
         return false;
     }
-    auto it = _field_type_list.find( field_type_to_add );
-    if( it != _field_type_list.end() ) {
+    if( field_entry *existing = find_field( field_type_to_add ) ) {
         // Most fields stack intensities, but some add duration instead
-        if( it->first->stacking_type == fields::stacking_type::intensity ) {
-            it->second.set_field_intensity( it->second.get_field_intensity() + new_intensity );
+        if( field_type_to_add->stacking_type == fields::stacking_type::intensity ) {
+            existing->set_field_intensity( existing->get_field_intensity() + new_intensity );
         } else {
             time_duration half_life = field_type_to_add->half_life;
             if( new_age < half_life ) {
-                it->second.mod_field_age( new_age - half_life );
+                existing->mod_field_age( new_age - half_life );
             }
         }
         return false;
@@ -212,29 +258,42 @@ bool field::add_field( const field_type_id &field_type_to_add, const int new_int
         field_type_to_add.obj().priority >= _displayed_field_type.obj().priority ) {
         _displayed_field_type = field_type_to_add;
     }
-    _field_type_list[field_type_to_add] = field_entry( field_type_to_add, new_intensity, new_age );
+    // Fill the first hole, existing entries must not move
+    value_type *hole = find_slot( field_type_id() );
+    if( hole == nullptr ) {
+        if( !overflow ) {
+            overflow = std::make_unique<std::deque<value_type>>();
+        }
+        hole = &overflow->emplace_back();
+    }
+    hole->first = field_type_to_add;
+    hole->second = field_entry( field_type_to_add, new_intensity, new_age );
+    count++;
     return true;
 }
 
-bool field::remove_field( const field_type_id &field_to_remove )
+bool field::remove_field( const field_type_id field_to_remove )
 {
-    const auto it = _field_type_list.find( field_to_remove );
-    if( it == _field_type_list.end() ) {
+    if( !field_to_remove ) {
+        return false;
+    }
+    value_type *entry = find_slot( field_to_remove );
+    if( entry == nullptr ) {
         return false;
     }
-    remove_field( it );
+    remove_field( iterator( this, static_cast<size_t>( entry - &slot( 0 ) ) ) );
     return true;
 }
 
-void field::remove_field( std::map<field_type_id, field_entry>::iterator const it )
+void field::remove_field( const iterator it )
 {
-    _field_type_list.erase( it );
+    value_type &entry = slot( it.index );
+    entry = value_type();
+    count--;
     _displayed_field_type = fd_null;
-    if( !_field_type_list.empty() ) {
-        for( auto &fld : _field_type_list ) {
-            if( !_displayed_field_type || fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
-                _displayed_field_type = fld.first;
-            }
+    for( const value_type &fld : *this ) {
+        if( !_displayed_field_type || fld.first.obj().priority >= _displayed_field_type.obj().priority ) {
+            _displayed_field_type = fld.first;
         }
     }
 }
@@ -245,27 +304,27 @@ Returns the number of fields existing on the current tile.
 */
 unsigned int field::field_count() const
 {
-    return _field_type_list.size();
+    return count;
 }
 
-std::map<field_type_id, field_entry>::iterator field::begin()
+field::iterator field::begin()
 {
-    return _field_type_list.begin();
+    return iterator( this, next_slot( field_type_id() ) );
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::begin() const
+field::const_iterator field::begin() const
 {
-    return _field_type_list.begin();
+    return const_iterator( this, next_slot( field_type_id() ) );
 }
 
-std::map<field_type_id, field_entry>::iterator field::end()
+field::iterator field::end()
 {
-    return _field_type_list.end();
+    return iterator( this, npos );
 }
 
-std::map<field_type_id, field_entry>::const_iterator field::end() const
+field::const_iterator field::end() const
 {
-    return _field_type_list.end();
+    return const_iterator( this, npos );
 }
 
 /*
@@ -285,7 +344,7 @@ description_affix field::displayed_description_affix() const
 int field::total_move_cost() const
 {
     int current_cost = 0;
-    for( auto &fld : _field_type_list ) {
+    for( const value_type &fld : *this ) {
         current_cost += fld.second.move_cost();
     }
     return current_cost;
@@ -1,7 +1,13 @@
 #pragma once
 
-#include <map>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "calendar.h"
@@ -124,11 +130,73 @@ class field_entry
  * Use @ref find_field to get the field entry of a specific type, or iterate over
  * all entries via @ref begin and @ref end (allows range based iteration).
  * There is @ref displayed_field_type to specific which field should be drawn on the map.
+ *
+ * Almost all tiles have no more than a couple of fields, so the first entries are
+ * stored inline and only further ones in a separately allocated list. Entries never
+ * move: removing one leaves a hole that the next added entry fills. That keeps
+ * references and iterators valid while fields are added to the tile that is being
+ * processed, like a node based container would.
 */
 class field
 {
     public:
+        using value_type = std::pair<field_type_id, field_entry>;
+
+        template<typename Value, typename Owner>
+        class basic_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = field::value_type;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Value *;
+                using reference = Value &;
+
+                basic_iterator() = default;
+                basic_iterator( Owner *owner, size_t index ) : owner( owner ), index( index ) {
+                    if( index != npos ) {
+                        type = owner->slot( index ).first;
+                    }
+                }
+
+                reference operator*() const {
+                    return owner->slot( index );
+                }
+                pointer operator->() const {
+                    return &owner->slot( index );
+                }
+                basic_iterator &operator++() {
+                    index = owner->next_slot( type );
+                    type = index != npos ? owner->slot( index ).first : field_type_id();
+                    return *this;
+                }
+                basic_iterator operator++( int ) {
+                    basic_iterator result = *this;
+                    ++*this;
+                    return result;
+                }
+                bool operator==( const basic_iterator &rhs ) const {
+                    return index == rhs.index;
+                }
+
+            private:
+                friend class field;
+
+                Owner *owner = nullptr;
+                size_t index = npos;
+                // Kept apart from the slot, which may be emptied while this points at it
+                field_type_id type;
+        };
+
+        using iterator = basic_iterator<value_type, field>;
+        using const_iterator = basic_iterator<const value_type, const field>;
+
         field();
+        field( const field &other );
+        field( field && ) noexcept = default;
+        field &operator=( const field &other );
+        field &operator=( field && ) noexcept = default;
+        ~field();
 
         /**
          * Returns a field entry corresponding to the field_type_id parameter passed in.
@@ -162,12 +230,13 @@ class field
          * function returns true.
          * @return True if the field was removed, false if it did not exist in the first place.
          */
-        bool remove_field( const field_type_id &field_to_remove );
+        bool remove_field( field_type_id field_to_remove );
         /**
          * Make sure to decrement the field counter in the submap.
-         * Removes the field entry, the iterator must point into @ref _field_type_list and must be valid.
+         * Removes the field entry, the iterator must point into this field and must be valid.
+         * Other iterators stay valid.
          */
-        void remove_field( std::map<field_type_id, field_entry>::iterator );
+        void remove_field( iterator );
 
         // Returns the number of fields existing on the current tile.
         unsigned int field_count() const;
@@ -179,13 +248,13 @@ class field
 
         description_affix displayed_description_affix() const;
 
-        //Returns the vector iterator to begin searching through the list.
-        std::map<field_type_id, field_entry>::iterator begin();
-        std::map<field_type_id, field_entry>::const_iterator begin() const;
+        //Returns the iterator to begin searching through the list.
+        iterator begin();
+        const_iterator begin() const;
 
-        //Returns the vector iterator to end searching through the list.
-        std::map<field_type_id, field_entry>::iterator end();
-        std::map<field_type_id, field_entry>::const_iterator end() const;
+        //Returns the iterator to end searching through the list.
+        iterator end();
+        const_iterator end() const;
 
         /**
          * Returns the total move cost from all fields.
@@ -193,10 +262,35 @@ class field
         int total_move_cost() const;
 
     private:
-        // A pointer lookup table of all field effects on the current tile.
-        std::map<field_type_id, field_entry> _field_type_list;
+        static constexpr size_t inline_size = 2;
+        // Slot index of end()
+        static constexpr size_t npos = SIZE_MAX;
+
+        size_t slot_count() const {
+            return inline_size + ( overflow ? overflow->size() : 0 );
+        }
+        value_type &slot( size_t index ) {
+            return index < inline_size ? inline_entries[index] : ( *overflow )[index - inline_size];
+        }
+        const value_type &slot( size_t index ) const {
+            return index < inline_size ? inline_entries[index] : ( *overflow )[index - inline_size];
+        }
+        value_type *find_slot( const field_type_id &type );
+        const value_type *find_slot( const field_type_id &type ) const;
+        /**
+         * The slot of the entry with the smallest type after @p type, or npos.
+         * Entries are visited in the order of their types, wherever they are stored,
+         * as they were when they lived in a std::map.
+         */
+        size_t next_slot( const field_type_id &type ) const;
+
+        // Holes have a default constructed (null) type.
+        std::array<value_type, inline_size> inline_entries;
+        // Entries that don't fit inline. A deque, so adding to it doesn't move existing entries.
+        std::unique_ptr<std::deque<value_type>> overflow;
         //_displayed_field_type currently is equal to the last field added to the square. You can modify this behavior in the class functions if you wish.
         field_type_id _displayed_field_type;
+        unsigned int count = 0;
 };
 
 
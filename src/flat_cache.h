@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * Fixed capacity key-value cache stored in a single flat array.
+ *
+ * A replacement for @ref lru_cache where lookups need to be cheap: entries are found by
+ * probing a few slots after the one the key hashes to, so a lookup touches one or two
+ * cache lines and never allocates. When all probed slots are taken, the entry in the
+ * first one is evicted, so older entries tend to go first, but there is no strict LRU order.
+ *
+ * @ref clear only bumps a generation counter, entries of older generations are
+ * treated as empty. That makes it cheap enough to call whenever the cached data may
+ * have become stale.
+ *
+ * The storage is allocated on first insertion, so unused caches cost next to nothing.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class flat_cache
+{
+    public:
+        /** The capacity is rounded up to a power of two. */
+        explicit flat_cache( size_t min_capacity ) {
+            while( ( size_t( 1 ) << capacity_bits ) < min_capacity ) {
+                capacity_bits++;
+            }
+        }
+
+        Value get( const Key &key, const Value &default_ ) const {
+            if( slots.empty() ) {
+                return default_;
+            }
+            const size_t home = slot_index( key );
+            for( size_t i = 0; i < max_probes; i++ ) {
+                const slot &s = slots[( home + i ) & mask()];
+                if( s.generation == generation && s.key == key ) {
+                    return s.value;
+                }
+            }
+            return default_;
+        }
+
+        void insert( const Key &key, const Value &value ) {
+            if( slots.empty() ) {
+                slots.resize( size_t( 1 ) << capacity_bits );
+            }
+            const size_t home = slot_index( key );
+            slot *free_slot = nullptr;
+            for( size_t i = 0; i < max_probes; i++ ) {
+                slot &s = slots[( home + i ) & mask()];
+                if( s.generation != generation ) {
+                    if( free_slot == nullptr ) {
+                        free_slot = &s;
+                    }
+                } else if( s.key == key ) {
+                    s.value = value;
+                    return;
+                }
+            }
+            if( free_slot == nullptr ) {
+                // Inserting at the front makes the entries after it older than it
+                free_slot = &slots[home];
+            }
+            free_slot->key = key;
+            free_slot->value = value;
+            free_slot->generation = generation;
+        }
+
+        void remove( const Key &key ) {
+            if( slots.empty() ) {
+                return;
+            }
+            const size_t home = slot_index( key );
+            for( size_t i = 0; i < max_probes; i++ ) {
+                slot &s = slots[( home + i ) & mask()];
+                if( s.generation == generation && s.key == key ) {
+                    s.generation = 0;
+                    return;
+                }
+            }
+        }
+
+        /** Forget all entries. Constant time, except once every 2^32 calls. */
+        void clear() {
+            if( ++generation == 0 ) {
+                for( slot &s : slots ) {
+                    s.generation = 0;
+                }
+                generation = 1;
+            }
+        }
+
+        size_t capacity() const {
+            return size_t( 1 ) << capacity_bits;
+        }
+
+    private:
+        static constexpr size_t max_probes = 8;
+
+        struct slot {
+            Key key{};
+            Value value{};
+            // 0 is never the current generation, so default constructed slots are empty
+            uint32_t generation = 0;
+        };
+
+        size_t mask() const {
+            return capacity() - 1;
+        }
+
+        size_t slot_index( const Key &key ) const {
+            // Fibonacci hashing, std::hash of points leaves the low bits poorly mixed
+            const uint64_t hash = static_cast<uint64_t>( Hash()( key ) ) * 0x9E3779B97F4A7C15ull;
+            return capacity_bits == 0 ? 0 : static_cast<size_t>( hash >> ( 64 - capacity_bits ) );
+        }
+
+        std::vector<slot> slots;
+        uint32_t generation = 1;
+        int capacity_bits = 0;
+};
@@ -45,6 +45,7 @@
 #include "avatar_functions.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "catacharset.h"
@@ -161,10 +162,12 @@
 #include "string_id.h"
 #include "string_input_popup.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_profiler.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -180,6 +183,29 @@
 #include "weather.h"
 #include "worldfactory.h"
 
+static const ter_furn_flag_id ter_furn_flag_BARRICADABLE_DOOR( "BARRICADABLE_DOOR" );
+static const ter_furn_flag_id ter_furn_flag_BARRICADABLE_DOOR_DAMAGED( "BARRICADABLE_DOOR_DAMAGED" );
+static const ter_furn_flag_id ter_furn_flag_BARRICADABLE_DOOR_REINFORCED( "BARRICADABLE_DOOR_REINFORCED" );
+static const ter_furn_flag_id ter_furn_flag_CONSOLE( "CONSOLE" );
+static const ter_furn_flag_id ter_furn_flag_CONTAINER( "CONTAINER" );
+static const ter_furn_flag_id ter_furn_flag_DEEP_WATER( "DEEP_WATER" );
+static const ter_furn_flag_id ter_furn_flag_DESTROY_ITEM( "DESTROY_ITEM" );
+static const ter_furn_flag_id ter_furn_flag_DIFFICULT_Z( "DIFFICULT_Z" );
+static const ter_furn_flag_id ter_furn_flag_FISHABLE( "FISHABLE" );
+static const ter_furn_flag_id ter_furn_flag_FLAT( "FLAT" );
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag_id ter_furn_flag_GOES_DOWN( "GOES_DOWN" );
+static const ter_furn_flag_id ter_furn_flag_GOES_UP( "GOES_UP" );
+static const ter_furn_flag_id ter_furn_flag_LIQUID( "LIQUID" );
+static const ter_furn_flag_id ter_furn_flag_MOUNTABLE( "MOUNTABLE" );
+static const ter_furn_flag_id ter_furn_flag_NOITEM( "NOITEM" );
+static const ter_furn_flag_id ter_furn_flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+static const ter_furn_flag_id ter_furn_flag_ROUGH( "ROUGH" );
+static const ter_furn_flag_id ter_furn_flag_SEALED( "SEALED" );
+static const ter_furn_flag_id ter_furn_flag_SHARP( "SHARP" );
+static const ter_furn_flag_id ter_furn_flag_SWIMMABLE( "SWIMMABLE" );
+static const ter_furn_flag_id ter_furn_flag_UNSTABLE( "UNSTABLE" );
+
 class computer;
 
 #if defined(TILES)
@@ -1355,12 +1381,65 @@ void game::calc_driving_offset( vehicle *veh )
     set_driving_view_offset( point( offset.x, offset.y ) );
 }
 
+// Start reading the submaps the reality bubble is about to move into, so that
+// shifting the map finds them loaded instead of waiting for the disk
+static void prefetch_submaps_ahead( const avatar &you )
+{
+    // How many turns of movement to look ahead
+    static constexpr int lookahead_turns = 3;
+    static tripoint last_pos = tripoint_min;
+
+    map &here = get_map();
+    const tripoint pos = you.global_square_location();
+    // In tiles per turn
+    float vel_x = 0.0f;
+    float vel_y = 0.0f;
+    const optional_vpart_position vp = here.veh_at( you.pos() );
+    if( you.controlling_vehicle && vp ) {
+        const vehicle &veh = vp->vehicle();
+        const float speed = veh.velocity / vehicles::vmiph_per_tile;
+        vel_x = speed * units::cos( veh.move.dir() );
+        vel_y = speed * units::sin( veh.move.dir() );
+    } else if( last_pos != tripoint_min && square_dist( pos, last_pos ) <= 2 ) {
+        vel_x = pos.x - last_pos.x;
+        vel_y = pos.y - last_pos.y;
+    }
+    last_pos = pos;
+
+    MAPBUFFER.load_prefetched( 2 );
+    if( vel_x == 0.0f && vel_y == 0.0f ) {
+        return;
+    }
+
+    // Look one more submap past the edge the bubble moves towards
+    const tripoint ahead(
+        pos.x + static_cast<int>( vel_x * lookahead_turns ) + ( vel_x > 0 ? SEEX : vel_x < 0 ? -SEEX : 0 ),
+        pos.y + static_cast<int>( vel_y * lookahead_turns ) + ( vel_y > 0 ? SEEY : vel_y < 0 ? -SEEY : 0 ),
+        pos.z );
+    const tripoint ahead_sm = ms_to_sm_copy( ahead );
+    const int min_z = here.has_zlevels() ? -OVERMAP_DEPTH : pos.z;
+    const int max_z = here.has_zlevels() ? OVERMAP_HEIGHT : pos.z;
+
+    std::vector<tripoint> submap_addrs;
+    for( int z = min_z; z <= max_z; z++ ) {
+        for( int x = ahead_sm.x - HALF_MAPSIZE; x <= ahead_sm.x + HALF_MAPSIZE; x++ ) {
+            for( int y = ahead_sm.y - HALF_MAPSIZE; y <= ahead_sm.y + HALF_MAPSIZE; y++ ) {
+                submap_addrs.emplace_back( x, y, z );
+            }
+        }
+    }
+    MAPBUFFER.prefetch( submap_addrs );
+}
+
 // MAIN GAME LOOP
 // Returns true if game is over (death, saved, quit, etc)
 bool game::do_turn()
 {
     ZoneScoped;
+    turn_profiler::begin_turn();
     cleanup_arenas();
+    // Results of background work that have to be applied to the game state
+    get_thread_pool().run_main_thread_tasks();
     if( is_game_over() ) {
         return cleanup_at_end();
     }
@@ -1368,7 +1447,10 @@ bool game::do_turn()
     if( new_game ) {
         new_game = false;
     } else {
-        gamemode->per_turn();
+        // Headless runs like the benchmarks never start a game mode
+        if( gamemode ) {
+            gamemode->per_turn();
+        }
         calendar::turn += 1_turns;
     }
 
@@ -1413,6 +1495,7 @@ bool game::do_turn()
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
+        TURN_STAGE_TIMER( autosave );
         autosave();
     }
 
@@ -1422,15 +1505,18 @@ bool game::do_turn()
     perhaps_add_random_npc();
     process_voluntary_act_interrupt();
     process_activity();
-    // Process NPC sound events before they move or they hear themselves talking
-    for( npc &guy : all_npcs() ) {
-        if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
-            sounds::process_sound_markers( &guy );
+    {
+        TURN_STAGE_TIMER( sounds );
+        // Process NPC sound events before they move or they hear themselves talking
+        for( npc &guy : all_npcs() ) {
+            if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
+                sounds::process_sound_markers( &guy );
+            }
         }
-    }
 
-    // Process sound events into sound markers for display to the player.
-    sounds::process_sound_markers( &u );
+        // Process sound events into sound markers for display to the player.
+        sounds::process_sound_markers( &u );
+    }
 
     if( u.is_deaf() ) {
         sfx::do_hearing_loss();
@@ -1460,7 +1546,13 @@ bool game::do_turn()
                     queue_screenshot = false;
                 }
 
-                if( handle_action() ) {
+                bool acted = false;
+                {
+                    // Waiting for input would drown out everything else
+                    turn_profiler::scoped_idle idle;
+                    acted = handle_action();
+                }
+                if( acted ) {
                     ++moves_since_last_save;
                 }
 
@@ -1490,31 +1582,52 @@ bool game::do_turn()
         calc_driving_offset( veh );
     }
 
-    // No-scent debug mutation has to be processed here or else it takes time to start working
-    if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
-        !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
-        scent.set( u.pos(), u.scent, u.get_type_of_scent() );
-        overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+    {
+        TURN_STAGE_TIMER( scent );
+        // No-scent debug mutation has to be processed here or else it takes time to start working
+        if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
+            !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
+            scent.set( u.pos(), u.scent, u.get_type_of_scent() );
+            overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
+        }
+        scent.update( u.pos(), m );
     }
-    scent.update( u.pos(), m );
 
     // We need floor cache before checking falling 'n stuff
     m.build_floor_caches();
 
     m.process_falling();
-    autopilot_vehicles();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
+    {
+        TURN_STAGE_TIMER( vehmove );
+        autopilot_vehicles();
+        m.vehmove();
+    }
+    {
+        TURN_STAGE_TIMER( process_fields );
+        m.process_fields();
+    }
+    {
+        TURN_STAGE_TIMER( process_items );
+        m.process_items();
+    }
     m.creature_in_field( u );
     grid_tracker_ptr->update( calendar::turn );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( get_levz(), true );
-    monmove();
+    {
+        TURN_STAGE_TIMER( sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
+    {
+        TURN_STAGE_TIMER( build_map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( get_levz(), true );
+    }
+    {
+        TURN_STAGE_TIMER( monmove );
+        monmove();
+    }
     if( calendar::once_every( 5_minutes ) ) {
         overmap_npc_move();
     }
@@ -1531,9 +1644,14 @@ bool game::do_turn()
     mon_info_update();
     u.process_turn();
 
-    cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
-
-    explosion_handler::get_explosion_queue().execute();
+    {
+        TURN_STAGE_TIMER( lua_hooks );
+        cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
+    }
+    {
+        TURN_STAGE_TIMER( explosions );
+        explosion_handler::get_explosion_queue().execute();
+    }
     cleanup_dead();
 
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
@@ -1606,8 +1724,14 @@ bool game::do_turn()
     // reset player noise
     u.volume = 0;
 
-    // Finally, clear pathfinding cache
-    Pathfinding::clear_d_maps();
+    if( prefetch_submaps ) {
+        prefetch_submaps_ahead( u );
+    }
+
+    // Finally, drop pathfinding d_maps that won't be useful next turn
+    Pathfinding::prune_d_maps();
+
+    turn_profiler::end_turn();
 
     return false;
 }
@@ -3142,6 +3266,10 @@ void game::draw( ui_adaptor &ui )
     }
     wnoutrefresh( w_terrain );
 
+    if( turn_profiler::overlay_shown() ) {
+        turn_profiler::draw_overlay( point( getbegx( w_terrain ), getbegy( w_terrain ) ) );
+    }
+
     draw_panels( true );
 
     // Ensure that the cursor lands on the character when everything is drawn.
@@ -3672,7 +3800,7 @@ std::unordered_set<tripoint> game::get_fishable_locations( int distance, const t
             // Mark this point as visited.
             visited.emplace( current_point );
 
-            if( m.has_flag( "FISHABLE", current_point ) ) {
+            if( m.has_flag( ter_furn_flag_FISHABLE, current_point ) ) {
                 fishable_terrain.emplace( current_point );
                 to_check.push( current_point + point_south );
                 to_check.push( current_point + point_north );
@@ -4360,13 +4488,13 @@ void game::knockback( std::vector<tripoint> &traj, int stun, int dam_mult,
                 break;
             }
             targ->setpos( traj[i] );
-            if( m.has_flag( "LIQUID", targ->pos() ) && targ->can_drown() && !targ->is_dead() ) {
+            if( m.has_flag( ter_furn_flag_LIQUID, targ->pos() ) && targ->can_drown() && !targ->is_dead() ) {
                 targ->die( source );
                 if( u.sees( *targ ) ) {
                     add_msg( _( "The %s drowns!" ), targ->name() );
                 }
             }
-            if( !m.has_flag( "LIQUID", targ->pos() ) && targ->has_flag( MF_AQUATIC ) &&
+            if( !m.has_flag( ter_furn_flag_LIQUID, targ->pos() ) && targ->has_flag( MF_AQUATIC ) &&
                 !targ->is_dead() ) {
                 targ->die( source );
                 if( u.sees( *targ ) ) {
@@ -4527,7 +4655,7 @@ void game::knockback( std::vector<tripoint> &traj, int stun, int dam_mult,
                 knockback( traj, stun, dam_mult, source );
                 break;
             }
-            if( m.has_flag( "LIQUID", u.pos() ) && force_remaining == 0 ) {
+            if( m.has_flag( ter_furn_flag_LIQUID, u.pos() ) && force_remaining == 0 ) {
                 avatar_action::swim( m, u, u.pos() );
             } else {
                 u.setpos( traj[i] );
@@ -4562,7 +4690,7 @@ void game::use_computer( const tripoint &p )
     computer *used = m.computer_at( p );
 
     if( used == nullptr ) {
-        if( m.has_flag( "CONSOLE", p ) ) { //Console without map data
+        if( m.has_flag( ter_furn_flag_CONSOLE, p ) ) { //Console without map data
             add_msg( m_bad, _( "The console doesn't display anything coherent." ) );
         } else {
             debugmsg( "Tried to use computer at %s - none there", p.to_string() );
@@ -4880,7 +5008,7 @@ bool game::swap_critters( Creature &a, Creature &b )
 
 bool game::is_empty( const tripoint &p )
 {
-    return ( m.passable( p ) || m.has_flag( "LIQUID", p ) ) &&
+    return ( m.passable( p ) || m.has_flag( ter_furn_flag_LIQUID, p ) ) &&
            critter_at( p ) == nullptr;
 }
 
@@ -5151,7 +5279,7 @@ bool game::forced_door_closing( const tripoint &p, const ter_id &door_type, int
     }
 
     m.ter_set( p, door_type );
-    if( m.has_flag( "NOITEM", p ) ) {
+    if( m.has_flag( ter_furn_flag_NOITEM, p ) ) {
         map_stack items = m.i_at( p );
         for( map_stack::iterator it = items.begin(); it != items.end(); ) {
             if( ( *it )->made_of( LIQUID ) ) {
@@ -5204,7 +5332,7 @@ void game::moving_vehicle_dismount( const tripoint &dest_loc )
     // Dive three tiles in the direction of tox and toy
     fling_creature( &u, d, 30, true );
     // Hit the ground according to vehicle speed
-    if( !m.has_flag( "SWIMMABLE", u.pos() ) ) {
+    if( !m.has_flag( ter_furn_flag_SWIMMABLE, u.pos() ) ) {
         if( veh->velocity > 0 ) {
             fling_creature( &u, veh->face.dir(), veh->velocity / static_cast<float>( 100 ) );
         } else {
@@ -5578,10 +5706,10 @@ void game::examine( const tripoint &examp )
         return;
     }
 
-    if( m.has_flag( "CONSOLE", examp ) && !u.is_mounted() ) {
+    if( m.has_flag( ter_furn_flag_CONSOLE, examp ) && !u.is_mounted() ) {
         use_computer( examp );
         return;
-    } else if( m.has_flag( "CONSOLE", examp ) && u.is_mounted() ) {
+    } else if( m.has_flag( ter_furn_flag_CONSOLE, examp ) && u.is_mounted() ) {
         add_msg( m_warning, _( "You cannot use a console while mounted." ) );
     }
     const furn_t &xfurn_t = m.furn( examp ).obj();
@@ -5631,9 +5759,9 @@ void game::examine( const tripoint &examp )
         add_msg( fire_fuel );
     }
 
-    if( m.has_flag( "SEALED", examp ) ) {
+    if( m.has_flag( ter_furn_flag_SEALED, examp ) ) {
         if( none ) {
-            if( m.has_flag( "UNSTABLE", examp ) ) {
+            if( m.has_flag( ter_furn_flag_UNSTABLE, examp ) ) {
                 add_msg( _( "The %s is too unstable to remove anything." ), m.name( examp ) );
             } else {
                 add_msg( _( "The %s is firmly sealed." ), m.name( examp ) );
@@ -5642,7 +5770,7 @@ void game::examine( const tripoint &examp )
     } else {
         //examp has no traps, is a container and doesn't have a special examination function
         if( m.tr_at( examp ).is_null() && m.i_at( examp ).empty() &&
-            m.has_flag( "CONTAINER", examp ) && none ) {
+            m.has_flag( ter_furn_flag_CONTAINER, examp ) && none ) {
             add_msg( _( "It is empty." ) );
         } else if( ( m.has_flag( TFLAG_FIRE_CONTAINER, examp ) &&
                      xfurn_t.examine == &iexamine::fireplace ) ||
@@ -6022,7 +6150,7 @@ void game::print_items_info( const tripoint &lp, const catacurses::window &w_loo
 {
     if( !m.sees_some_items( lp, u ) ) {
         return;
-    } else if( m.has_flag( "CONTAINER", lp ) && !m.could_see_items( lp, u ) ) {
+    } else if( m.has_flag( ter_furn_flag_CONTAINER, lp ) && !m.could_see_items( lp, u ) ) {
         mvwprintw( w_look, point( column, ++line ), _( "You cannot see what is inside of it." ) );
     } else if( ( u.has_effect( effect_blind ) || u.worn_with_flag( flag_BLIND ) ) &&
                u.clairvoyance() < 1 ) {
@@ -8405,7 +8533,7 @@ void game::butcher()
     const std::string no_corpse_msg = _( "There are no corpses here to butcher." );
 
     //You can't butcher on sealed terrain- you have to smash/shovel/etc it open first
-    if( m.has_flag( "SEALED", u.pos() ) ) {
+    if( m.has_flag( ter_furn_flag_SEALED, u.pos() ) ) {
         if( m.sees_some_items( u.pos(), u ) ) {
             add_msg( m_info, _( "You can't access the items here." ) );
         } else if( factor > INT_MIN || factorD > INT_MIN ) {
@@ -8769,11 +8897,11 @@ std::vector<std::string> game::get_dangerous_tile( const tripoint &dest_loc ) co
             return character_funcs::is_bp_immune_to( u, bp, { DT_CUT, 10 } );
         };
 
-        if( m.has_flag( "ROUGH", dest_loc ) && !m.has_flag( "ROUGH", u.pos() ) && !boardable &&
+        if( m.has_flag( ter_furn_flag_ROUGH, dest_loc ) && !m.has_flag( ter_furn_flag_ROUGH, u.pos() ) && !boardable &&
             ( u.get_armor_bash( bodypart_id( "foot_l" ) ) < 5 ||
               u.get_armor_bash( bodypart_id( "foot_r" ) ) < 5 ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
-        } else if( m.has_flag( "SHARP", dest_loc ) && !m.has_flag( "SHARP", u.pos() ) && !( u.in_vehicle ||
+        } else if( m.has_flag( ter_furn_flag_SHARP, dest_loc ) && !m.has_flag( ter_furn_flag_SHARP, u.pos() ) && !( u.in_vehicle ||
                    m.veh_at( dest_loc ) ) &&
                    u.dex_cur < 78 && !std::all_of( sharp_bps.begin(), sharp_bps.end(), sharp_bp_check ) ) {
             harmful_stuff.emplace_back( m.name( dest_loc ) );
@@ -8941,11 +9069,11 @@ bool game::walk_move( const tripoint &dest_loc, const bool via_ramp )
     if( u.is_mounted() ) {
         auto crit = u.mounted_creature.get();
         if( !crit->has_flag( MF_RIDEABLE_MECH ) &&
-            ( m.has_flag_ter_or_furn( "MOUNTABLE", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR", dest_loc ) ||
-              m.has_flag_ter_or_furn( "OPENCLOSE_INSIDE", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR_DAMAGED", dest_loc ) ||
-              m.has_flag_ter_or_furn( "BARRICADABLE_DOOR_REINFORCED", dest_loc ) ) ) {
+            ( m.has_flag_ter_or_furn( ter_furn_flag_MOUNTABLE, dest_loc ) ||
+              m.has_flag_ter_or_furn( ter_furn_flag_BARRICADABLE_DOOR, dest_loc ) ||
+              m.has_flag_ter_or_furn( ter_furn_flag_OPENCLOSE_INSIDE, dest_loc ) ||
+              m.has_flag_ter_or_furn( ter_furn_flag_BARRICADABLE_DOOR_DAMAGED, dest_loc ) ||
+              m.has_flag_ter_or_furn( ter_furn_flag_BARRICADABLE_DOOR_REINFORCED, dest_loc ) ) ) {
             add_msg( m_warning, _( "You cannot pass obstacles whilst mounted." ) );
             return false;
         }
@@ -8987,8 +9115,8 @@ bool game::walk_move( const tripoint &dest_loc, const bool via_ramp )
 
     // Print a message if movement is slow
     const int mcost_to = m.move_cost( dest_loc ); //calculate this _after_ calling grabbed_move
-    const bool fungus = m.has_flag_ter_or_furn( "FUNGUS", u.pos() ) ||
-                        m.has_flag_ter_or_furn( "FUNGUS",
+    const bool fungus = m.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, u.pos() ) ||
+                        m.has_flag_ter_or_furn( ter_furn_flag_FUNGUS,
                                 dest_loc ); //fungal furniture has no slowing effect on mycus characters
     const bool slowed = ( ( u.mutation_value( "movecost_obstacle_modifier" ) > 0.5f && ( mcost_to > 2 ||
                             mcost_from > 2 ) ) ||
@@ -9026,7 +9154,7 @@ bool game::walk_move( const tripoint &dest_loc, const bool via_ramp )
         ///\EFFECT_DEX decreases chance of tentacles getting stuck to the ground
 
         ///\EFFECT_INT decreases chance of tentacles getting stuck to the ground
-        if( !m.has_flag( "SWIMMABLE", dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
+        if( !m.has_flag( ter_furn_flag_SWIMMABLE, dest_loc ) && one_in( 80 + u.dex_cur + u.int_cur ) ) {
             add_msg( _( "Your tentacles stick to the ground, but you pull them free." ) );
             u.mod_fatigue( 1 );
         }
@@ -9137,22 +9265,22 @@ point game::place_player( const tripoint &dest_loc )
         }
     }
     // TODO: Move the stuff below to a Character method so that NPCs can reuse it
-    if( m.has_flag( "ROUGH", dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
+    if( m.has_flag( ter_furn_flag_ROUGH, dest_loc ) && ( !u.in_vehicle ) && ( !u.is_mounted() ) ) {
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_l" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your left foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( ter_furn_flag_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
         if( one_in( 5 ) && u.get_armor_bash( bodypart_id( "foot_r" ) ) < rng( 2, 5 ) ) {
             add_msg( m_bad, _( "You hurt your right foot on the %s!" ),
-                     m.has_flag_ter( "ROUGH", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                     m.has_flag_ter( ter_furn_flag_ROUGH, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                          dest_loc ) );
             u.deal_damage( nullptr, bodypart_id( "foot_l" ), damage_instance( DT_CUT, 1 ) );
         }
     }
     ///\EFFECT_DEX increases chance of avoiding cuts on sharp terrain
-    if( m.has_flag( "SHARP", dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
+    if( m.has_flag( ter_furn_flag_SHARP, dest_loc ) && !one_in( 3 ) && !x_in_y( 1 + u.dex_cur / 2.0, 40 ) &&
         ( !u.in_vehicle && !m.veh_at( dest_loc ) ) &&
         ( u.mutation_value( "movecost_obstacle_modifier" ) > 0.5f ||
           one_in( 4 ) ) && ( u.has_trait( trait_THICKSKIN ) ? !one_in( 8 ) : true ) ) {
@@ -9165,12 +9293,12 @@ point game::place_player( const tripoint &dest_loc )
                 //~ 1$s - bodypart name in accusative, 2$s is terrain name.
                 add_msg( m_bad, _( "You cut your %1$s on the %2$s!" ),
                          body_part_name_accusative( bp->token ),
-                         m.has_flag_ter( "SHARP", dest_loc ) ? m.tername( dest_loc ) : m.furnname(
+                         m.has_flag_ter( ter_furn_flag_SHARP, dest_loc ) ? m.tername( dest_loc ) : m.furnname(
                              dest_loc ) );
             }
         }
     }
-    if( m.has_flag( "UNSTABLE", dest_loc ) && !u.is_mounted() ) {
+    if( m.has_flag( ter_furn_flag_UNSTABLE, dest_loc ) && !u.is_mounted() ) {
         u.add_effect( effect_bouldering, 1_turns, bodypart_str_id::NULL_ID() );
     } else if( u.has_effect( effect_bouldering ) ) {
         u.remove_effect( effect_bouldering );
@@ -9182,7 +9310,7 @@ point game::place_player( const tripoint &dest_loc )
     }
 
     // If we moved out of the nonant, we need update our map data
-    if( m.has_flag( "SWIMMABLE", dest_loc ) && u.has_effect( effect_onfire ) ) {
+    if( m.has_flag( ter_furn_flag_SWIMMABLE, dest_loc ) && u.has_effect( effect_onfire ) ) {
         add_msg( _( "The water puts out the flames!" ) );
         u.remove_effect( effect_onfire );
         if( u.is_mounted() ) {
@@ -9354,14 +9482,14 @@ point game::place_player( const tripoint &dest_loc )
         m.creature_on_trap( u );
     }
     // Drench the player if swimmable
-    if( m.has_flag( "SWIMMABLE", u.pos() ) &&
+    if( m.has_flag( ter_furn_flag_SWIMMABLE, u.pos() ) &&
         !( u.is_mounted() || ( u.in_vehicle && vp1->vehicle().can_float() ) ) ) {
         u.drench( 40, { { bodypart_str_id( "foot_l" ), bodypart_str_id( "foot_r" ), bodypart_str_id( "leg_l" ), bodypart_str_id( "leg_r" ) } },
         false );
     }
 
     // List items here
-    if( !m.has_flag( "SEALED", u.pos() ) ) {
+    if( !m.has_flag( ter_furn_flag_SEALED, u.pos() ) ) {
         if( get_option<bool>( "NO_AUTO_PICKUP_ZONES_LIST_ITEMS" ) ||
             !check_zone( zone_type_id( "NO_AUTO_PICKUP" ), u.pos() ) ) {
             if( u.is_blind() && !m.i_at( u.pos() ).empty() && u.clairvoyance() < 1 ) {
@@ -9586,7 +9714,7 @@ bool game::grabbed_furn_move( const tripoint &dp )
                              critter_at<npc>( fdest ) == nullptr &&
                              critter_at<monster>( fdest ) == nullptr &&
                              ( !pulling_furniture || is_empty( u.pos() + dp ) ) &&
-                             ( !has_floor || m.has_flag( "FLAT", fdest ) ) &&
+                             ( !has_floor || m.has_flag( ter_furn_flag_FLAT, fdest ) ) &&
                              !m.has_furn( fdest ) &&
                              !m.veh_at( fdest ) &&
                              ( !has_floor || m.tr_at( fdest ).is_null() )
@@ -9601,9 +9729,9 @@ bool game::grabbed_furn_move( const tripoint &dp )
         return liquid_item->made_of( LIQUID );
     } );
 
-    const bool dst_item_ok = !m.has_flag( "NOITEM", fdest ) &&
-                             !m.has_flag( "SWIMMABLE", fdest ) &&
-                             !m.has_flag( "DESTROY_ITEM", fdest );
+    const bool dst_item_ok = !m.has_flag( ter_furn_flag_NOITEM, fdest ) &&
+                             !m.has_flag( ter_furn_flag_SWIMMABLE, fdest ) &&
+                             !m.has_flag( ter_furn_flag_DESTROY_ITEM, fdest );
 
     const bool src_item_ok = m.furn( fpos ).obj().has_flag( "CONTAINER" ) ||
                              m.furn( fpos ).obj().has_flag( "FIRE_CONTAINER" ) ||
@@ -9936,7 +10064,7 @@ void game::fling_creature( Creature *c, const units::angle &dir, float flvel, bo
     }
 
     // Fall down to the ground - always on the last reached tile
-    if( !m.has_flag( "SWIMMABLE", c->pos() ) ) {
+    if( !m.has_flag( ter_furn_flag_SWIMMABLE, c->pos() ) ) {
         const trap_id trap_under_creature = m.tr_at( c->pos() ).loadid;
         // Didn't smash into a wall or a floor so only take the fall damage
         if( thru && trap_under_creature == tr_ledge ) {
@@ -10034,7 +10162,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
     bool climbing = false;
     int move_cost = 100;
     tripoint stairs( u.posx(), u.posy(), u.posz() + movez );
-    if( m.has_zlevels() && !force && movez == 1 && !m.has_flag( "GOES_UP", u.pos() ) &&
+    if( m.has_zlevels() && !force && movez == 1 && !m.has_flag( ter_furn_flag_GOES_UP, u.pos() ) &&
         !u.is_underwater() ) {
         // Climbing
         if( m.has_floor_or_support( stairs ) ) {
@@ -10098,11 +10226,11 @@ void game::vertical_move( int movez, bool force, bool peeking )
         }
     }
 
-    if( !force && movez == -1 && !m.has_flag( "GOES_DOWN", u.pos() ) &&
+    if( !force && movez == -1 && !m.has_flag( ter_furn_flag_GOES_DOWN, u.pos() ) &&
         !u.is_underwater() ) {
         add_msg( m_info, _( "You can't go down here!" ) );
         return;
-    } else if( !climbing && !force && movez == 1 && !m.has_flag( "GOES_UP", u.pos() ) &&
+    } else if( !climbing && !force && movez == 1 && !m.has_flag( ter_furn_flag_GOES_UP, u.pos() ) &&
                !u.is_underwater() ) {
         add_msg( m_info, _( "You can't go up here!" ) );
         return;
@@ -10300,7 +10428,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
         for( monster &critter : all_monsters() ) {
             // if its a ladder instead of stairs - most zombies can't climb that.
             // unless that have a special flag to allow them to do so.
-            if( ( m.has_flag( "DIFFICULT_Z", u.pos() ) && !critter.climbs() ) ||
+            if( ( m.has_flag( ter_furn_flag_DIFFICULT_Z, u.pos() ) && !critter.climbs() ) ||
                 critter.has_effect( effect_ridden ) ||
                 critter.has_effect( effect_tied ) ) {
                 continue;
@@ -10332,7 +10460,7 @@ void game::vertical_move( int movez, bool force, bool peeking )
     }
 
     if( m.has_zlevels() && std::abs( movez ) == 1 ) {
-        bool ladder = m.has_flag( "DIFFICULT_Z", u.pos() );
+        bool ladder = m.has_flag( ter_furn_flag_DIFFICULT_Z, u.pos() );
         for( monster &critter : all_monsters() ) {
             if( ladder && !critter.climbs() ) {
                 continue;
@@ -10622,12 +10750,12 @@ std::optional<tripoint> game::find_or_make_stairs( map &mp, const int z_after, b
     }
 
     if( movez > 0 ) {
-        if( mp.has_flag( "DEEP_WATER", *stairs ) ) {
+        if( mp.has_flag( ter_furn_flag_DEEP_WATER, *stairs ) ) {
             if( !query_yn(
                     _( "There is a huge blob of water!  You may be unable to return back down these stairs.  Continue up?" ) ) ) {
                 return std::nullopt;
             }
-        } else if( !mp.has_flag( "GOES_DOWN", *stairs ) ) {
+        } else if( !mp.has_flag( ter_furn_flag_GOES_DOWN, *stairs ) ) {
             if( !query_yn( _( "You may be unable to return back down these stairs.  Continue up?" ) ) ) {
                 return std::nullopt;
             }
@@ -10948,8 +11076,8 @@ void game::update_stair_monsters()
     }
 
     for( const tripoint &dest : m.points_on_zlevel( u.posz() ) ) {
-        if( ( from_below && m.has_flag( "GOES_DOWN", dest ) ) ||
-            ( !from_below && m.has_flag( "GOES_UP", dest ) ) ) {
+        if( ( from_below && m.has_flag( ter_furn_flag_GOES_DOWN, dest ) ) ||
+            ( !from_below && m.has_flag( ter_furn_flag_GOES_UP, dest ) ) ) {
             stairx.push_back( dest.x );
             stairy.push_back( dest.y );
             stairdist.push_back( rl_dist( dest, u.pos() ) );
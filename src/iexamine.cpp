@@ -219,6 +219,9 @@ static const std::string flag_GROWTH_HARVEST( "GROWTH_HARVEST" );
 static const std::string flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
 static const std::string flag_WALL( "WALL" );
 
+static const ter_furn_flag_id ter_furn_flag_L_OFF( "L_OFF" );
+static const ter_furn_flag_id ter_furn_flag_PLANT( "PLANT" );
+
 // @TODO maybe make this a property of the item (depend on volume/type)
 static const time_duration milling_time = 6_hours;
 
@@ -869,7 +872,7 @@ void iexamine::toilet( player &p, const tripoint &examp )
 void iexamine::toggle_lights( player &/*p*/, const tripoint &examp )
 {
     map &here = get_map();
-    const auto flag = here.has_flag_furn( "L_OFF", examp ) ? "L_OFF" : "L_ON";
+    const auto flag = here.has_flag_furn( ter_furn_flag_L_OFF, examp ) ? "L_OFF" : "L_ON";
 
     add_msg( _( here.furn( examp ).obj().message ) );
 
@@ -2453,7 +2456,7 @@ ret_val<bool> iexamine::can_fertilize( player &p, const tripoint &tile,
                                        const itype_id &fertilizer )
 {
     map &here = get_map();
-    if( !here.has_flag_furn( "PLANT", tile ) ) {
+    if( !here.has_flag_furn( ter_furn_flag_PLANT, tile ) ) {
         return ret_val<bool>::make_failure( _( "Tile isn't a plant" ) );
     }
     if( here.i_at( tile ).size() > 1 ) {
@@ -6314,11 +6317,12 @@ void iexamine::dimensional_portal( player &p, const tripoint &examp )
 void iexamine::check_power( player &, const tripoint &examp )
 {
     tripoint_abs_ms abspos( g->m.getabs( examp ) );
+    // Brings the grid up to date, so read the battery after it
+    int amt = get_distribution_grid_tracker().grid_at( abspos ).get_resource();
     battery_tile *battery = active_tiles::furn_at<battery_tile>( abspos );
     if( battery != nullptr ) {
         add_msg( m_info, _( "This battery stores %d kJ of electric power." ), battery->get_resource() );
     }
-    int amt = get_distribution_grid_tracker().grid_at( abspos ).get_resource();
     add_msg( m_info, _( "This electric grid stores %d kJ of electric power." ), amt );
 }
 
@@ -1,7 +1,9 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <exception>
 #include <fstream>
 #include <iterator>
@@ -9,6 +11,7 @@
 #include <sstream> // for throwing errors
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "achievement.h"
@@ -96,6 +99,7 @@
 #include "start_location.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -466,8 +470,60 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+
+/** A data file read and indexed ahead of loading it. */
+struct prepared_json_file {
+    std::string contents;
+    // Reads from contents, which must not change while this lives
+    std::unique_ptr<JsonIn> jsin;
+    // The objects of the file in order, with their members already indexed.
+    // Finishing a JsonObject seeks jsin, so they are never moved once made.
+    std::deque<JsonObject> objects;
+    // Syntax error found while indexing the file, if any
+    std::string error;
+};
+
+} // namespace
+
+// Called on worker threads, must not touch any game data
+static void prepare_json_file( const std::string &file, prepared_json_file &result )
+{
+    // stuff the file into ram, it's parsed straight from there
+    result.contents = read_entire_file( file );
+    try {
+        result.jsin = std::make_unique<JsonIn>( std::string_view( result.contents ), file );
+        JsonIn &jsin = *result.jsin;
+        // TEMPORARY until 0.G: Remove single object support for consistency
+        if( jsin.test_object() ) {
+            result.objects.emplace_back( jsin );
+            // if there's anything else in the file, it's an error.
+            jsin.eat_whitespace();
+            if( jsin.good() ) {
+                jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+            }
+        } else if( jsin.test_array() ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                result.objects.emplace_back( jsin );
+            }
+        } else {
+            // not an object or an array?
+            jsin.error( "expected object or array" );
+        }
+    } catch( const JsonError &err ) {
+        result.error = err.what();
+        // Nothing of a broken file is loaded, so don't complain about unread members
+        for( const JsonObject &jo : result.objects ) {
+            jo.allow_omitted_members();
+        }
+        result.objects.clear();
+    }
+}
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+        loading_ui & )
 {
     assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -486,24 +542,53 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss, file );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
+    // Reading the files and splitting them into indexed objects is independent of
+    // everything else, so it runs on the thread pool a batch at a time, one batch ahead
+    // of the objects being loaded here. They are loaded in file order, later files may
+    // depend on or override earlier ones.
+    constexpr size_t batch_size = 64;
+    const size_t num_batches = ( files.size() + batch_size - 1 ) / batch_size;
+    std::vector<prepared_json_file> prepared( files.size() );
+    std::vector<std::unique_ptr<task_group>> batches( num_batches );
+    const auto start_batch = [&]( size_t batch ) {
+        batches[batch] = std::make_unique<task_group>();
+        const size_t batch_end = std::min( files.size(), ( batch + 1 ) * batch_size );
+        for( size_t i = batch * batch_size; i < batch_end; i++ ) {
+            batches[batch]->run( [&files, &prepared, i]() {
+                prepare_json_file( files[i], prepared[i] );
+            } );
+        }
+    };
+    if( num_batches > 0 ) {
+        start_batch( 0 );
+    }
+    for( size_t batch = 0; batch < num_batches; batch++ ) {
+        if( batch + 1 < num_batches ) {
+            start_batch( batch + 1 );
+        }
+        batches[batch]->wait();
+        const size_t batch_end = std::min( files.size(), ( batch + 1 ) * batch_size );
+        for( size_t i = batch * batch_size; i < batch_end; i++ ) {
+            const std::string &file = files[i];
+            prepared_json_file &current = prepared[i];
+            // Fail before loading anything from a broken file
+            if( !current.error.empty() ) {
+                throw std::runtime_error( current.error );
+            }
+            try {
+                // find type and dispatch each object
+                for( JsonObject &jo : current.objects ) {
+                    load_object( jo, src, path, file );
+                    jo.finish();
+                }
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( err.what() );
+            }
+            inp_mngr.pump_events();
+            // The objects refer to jsin and jsin to contents
+            current.objects.clear();
+            current.jsin.reset();
+            current.contents = std::string();
         }
     }
 }
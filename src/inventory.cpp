@@ -14,6 +14,7 @@
 #include "debug.h"
 #include "diary.h"
 #include "distribution_grid.h"
+#include "field_type.h"
 #include "game.h"
 #include "iexamine.h"
 #include "locations.h"
@@ -38,6 +39,7 @@
 #include "material.h"
 #include "type_id.h"
 #include "flat_set.h"
+#include "hash_utils.h"
 #include "point.h"
 #include "inventory_ui.h" // auto inventory blocking
 
@@ -480,217 +482,379 @@ void inventory::form_from_map( map &m, const tripoint &origin, int range, const
 void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Character *pl,
                                bool assign_invlet )
 {
-    const time_point bday = calendar::start_of_cataclysm;
-    std::unordered_map<const vehicle *, std::unordered_set<const vpart_reference *>> checked_vehi;
+    vehicle_parts_seen checked_vehi;
     items.clear();
     build_items_type_cache();
     for( const tripoint &p : pts ) {
-        if( m.has_furn( p ) ) {
-            const furn_t &f = m.furn( p ).obj();
-            const std::vector<itype> tool_list = f.crafting_pseudo_item_types();
-            if( !tool_list.empty() ) {
-                for( const itype &type : tool_list ) {
-                    item &furn_item = *item::spawn_temporary( type.get_id(), calendar::turn, 0 );
-                    furn_item.set_flag( flag_PSEUDO );
-                    const itype_id &ammo = furn_item.ammo_default();
-                    if( furn_item.has_flag( flag_USES_GRID_POWER ) ) {
-                        // TODO: The grid tracker should correspond to map!
-                        auto &grid = get_distribution_grid_tracker().grid_at( tripoint_abs_ms( m.getabs( p ) ) );
-                        furn_item.charges = grid.get_resource();
-                    } else {
-                        furn_item.charges = ammo ? count_charges_in_list( &*ammo, m.i_at( p ) ) : 0;
-                    }
-                    add_item_by_items_type_cache( furn_item, false, true, false );
-                }
-            }
+        form_from_tile( m, p, pl, assign_invlet, checked_vehi, nullptr );
+    }
+    pts.clear();
+}
+
+void inventory::form_from_tile( map &m, const tripoint &p, const Character *pl,
+                                bool assign_invlet, vehicle_parts_seen &checked_vehi,
+                                tile_record *record )
+{
+    const time_point bday = calendar::start_of_cataclysm;
+    const auto add = [&]( item & it, bool keep, bool assign = true, bool stack = true ) {
+        add_item_by_items_type_cache( it, keep, assign, stack );
+        if( record != nullptr ) {
+            record->added.push_back( &it );
         }
-        if( m.has_items( p ) && m.accessible_items( p ) ) {
-            bool allow_liquids = m.has_flag_ter_or_furn( "LIQUIDCONT", p );
-            for( auto &i : m.i_at( p ) ) {
-                // if it's *the* player requesting this from from map inventory
-                // then don't allow items owned by another faction to be factored into recipe components etc.
-                if( pl && !i->is_owned_by( *pl, true ) && i->get_owner()->likes_u >= -10 ) {
-                    continue;
-                }
-                if( allow_liquids || !i->made_of( LIQUID ) ) {
-                    add_item_by_items_type_cache( *i, false, assign_invlet, false );
+    };
+    // Pseudo items only live until the end of the turn
+    const auto add_temporary = [&]( item & it, bool keep, bool assign = true, bool stack = true ) {
+        add( it, keep, assign, stack );
+        if( record != nullptr ) {
+            record->temporary = true;
+        }
+    };
+    if( m.has_furn( p ) ) {
+        const furn_t &f = m.furn( p ).obj();
+        const std::vector<itype> tool_list = f.crafting_pseudo_item_types();
+        if( !tool_list.empty() ) {
+            for( const itype &type : tool_list ) {
+                item &furn_item = *item::spawn_temporary( type.get_id(), calendar::turn, 0 );
+                furn_item.set_flag( flag_PSEUDO );
+                const itype_id &ammo = furn_item.ammo_default();
+                if( furn_item.has_flag( flag_USES_GRID_POWER ) ) {
+                    // TODO: The grid tracker should correspond to map!
+                    auto &grid = get_distribution_grid_tracker().grid_at( tripoint_abs_ms( m.getabs( p ) ) );
+                    furn_item.charges = grid.get_resource();
+                } else {
+                    furn_item.charges = ammo ? count_charges_in_list( &*ammo, m.i_at( p ) ) : 0;
                 }
+                add_temporary( furn_item, false, true, false );
             }
         }
-        // Kludges for now!
-        if( m.has_nearby_fire( p, 0 ) ) {
-            item &fire = *item::spawn_temporary( "fire", bday );
-            fire.charges = 1;
-            add_item_by_items_type_cache( fire, false, true, false );
-        }
-        // Handle any water from infinite map sources.
-        detached_ptr<item> water = m.water_from( p );
-        if( water ) {
-            add_item_by_items_type_cache( *water, false, true, false );
-        }
-        // kludge that can probably be done better to check specifically for toilet water to use in
-        // crafting
-        if( m.furn( p ).obj().examine == &iexamine::toilet ) {
-            // get water charges at location
-            auto toilet = m.i_at( p );
-            item *waterp = nullptr;
-            for( auto candidate = toilet.begin(); candidate != toilet.end(); ++candidate ) {
-                if( ( *candidate )->typeId() == itype_water ) {
-                    waterp = *candidate;
-                    break;
-                }
+    }
+    if( m.has_items( p ) && m.accessible_items( p ) ) {
+        bool allow_liquids = m.has_flag_ter_or_furn( TER_FURN_FLAG( "LIQUIDCONT" ), p );
+        for( auto &i : m.i_at( p ) ) {
+            // if it's *the* player requesting this from from map inventory
+            // then don't allow items owned by another faction to be factored into recipe components etc.
+            if( pl && !i->is_owned_by( *pl, true ) && i->get_owner()->likes_u >= -10 ) {
+                continue;
             }
-            if( waterp != nullptr && waterp->charges > 0 ) {
-                add_item_by_items_type_cache( *waterp, false, true, false );
+            if( allow_liquids || !i->made_of( LIQUID ) ) {
+                add( *i, false, assign_invlet, false );
             }
         }
+    }
+    // Kludges for now!
+    if( m.has_nearby_fire( p, 0 ) ) {
+        item &fire = *item::spawn_temporary( "fire", bday );
+        fire.charges = 1;
+        add_temporary( fire, false, true, false );
+    }
+    // Handle any water from infinite map sources.
+    detached_ptr<item> water = m.water_from( p );
+    if( water ) {
+        add_temporary( *water, false, true, false );
+    }
+    // kludge that can probably be done better to check specifically for toilet water to use in
+    // crafting
+    if( m.furn( p ).obj().examine == &iexamine::toilet ) {
+        // get water charges at location
+        auto toilet = m.i_at( p );
+        item *waterp = nullptr;
+        for( auto candidate = toilet.begin(); candidate != toilet.end(); ++candidate ) {
+            if( ( *candidate )->typeId() == itype_water ) {
+                waterp = *candidate;
+                break;
+            }
+        }
+        if( waterp != nullptr && waterp->charges > 0 ) {
+            add( *waterp, false, true, false );
+        }
+    }
 
-        // WARNING: The part below has a bug that's currently quite minor
-        // When a vehicle has multiple faucets in range, available water is
-        //  multiplied by the number of faucets.
-        // Same thing happens for all other tools and resources, but not cargo
-        const optional_vpart_position vp = m.veh_at( p );
-        if( !vp ) {
-            continue;
+    // WARNING: The part below has a bug that's currently quite minor
+    // When a vehicle has multiple faucets in range, available water is
+    //  multiplied by the number of faucets.
+    // Same thing happens for all other tools and resources, but not cargo
+    const optional_vpart_position vp = m.veh_at( p );
+    if( !vp ) {
+        return;
+    }
+    vehicle *const veh = &vp->vehicle();
+    if( !checked_vehi.contains( veh ) ) {
+        // We haven't worked with this vehicle yet.
+        checked_vehi[veh] = std::unordered_set<const vpart_reference *>();
+    }
+    // Make sure we're ready to record
+    std::unordered_set<const vpart_reference *> &found_parts = checked_vehi[veh];
+
+    //Adds faucet to kitchen stuff; may be horribly wrong to do such....
+    //ShouldBreak into own variable
+    const std::optional<vpart_reference> kpart = vp.part_with_feature( "KITCHEN", true );
+    const std::optional<vpart_reference> butcherpart = vp.part_with_feature( "BUTCHER_EQ", true );
+    const std::optional<vpart_reference> faupart = vp.part_with_feature( "FAUCET", true );
+    const std::optional<vpart_reference> weldpart = vp.part_with_feature( "WELDRIG", true );
+    const std::optional<vpart_reference> craftpart = vp.part_with_feature( "CRAFTRIG", true );
+    const std::optional<vpart_reference> forgepart = vp.part_with_feature( "FORGE", true );
+    const std::optional<vpart_reference> kilnpart = vp.part_with_feature( "KILN", true );
+    const std::optional<vpart_reference> chempart = vp.part_with_feature( "CHEMLAB", true );
+    const std::optional<vpart_reference> autoclavepart = vp.part_with_feature( "AUTOCLAVE", true );
+    const std::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
+
+    if( cargo ) {
+        const auto items = veh->get_items( cargo->part_index() );
+        for( const auto &it : items ) {
+            add( *it, false, false, false );
+        }
+    }
+
+    if( faupart && !found_parts.contains( &*faupart ) ) {
+        for( const auto &it : veh->fuels_left() ) {
+            item &fuel = *item::spawn_temporary( it.first, bday );
+            if( fuel.made_of( LIQUID ) ) {
+                fuel.charges = it.second;
+                add( fuel, false, true, false );
+            }
+        }
+        found_parts.insert( &*faupart );
+    }
+
+    static const flag_id flag_PSEUDO( "PSEUDO" );
+    static const flag_id flag_HEATS_FOOD( "HEATS_FOOD" );
+    static const flag_id flag_FLATSURF( "FLAT_SURFACE" );
+
+    if( kpart && !found_parts.contains( &*kpart ) ) {
+        item &hotplate = *item::spawn_temporary( "hotplate", bday );
+        hotplate.charges = veh->fuel_left( itype_battery, true );
+        hotplate.item_tags.insert( flag_PSEUDO );
+        // TODO: Allow disabling
+        hotplate.item_tags.insert( flag_HEATS_FOOD );
+        add( hotplate, false );
+
+        item &pot = *item::spawn_temporary( "pot", bday );
+        pot.set_flag( flag_PSEUDO );
+        add( pot, false );
+        item &pan = *item::spawn_temporary( "pan", bday );
+        pan.set_flag( flag_PSEUDO );
+        add( pan, false );
+        found_parts.insert( &*kpart );
+    }
+    if( butcherpart &&
+        !found_parts.contains( &*butcherpart ) ) { //copy n paste code moment(this will go wrong)
+        item &butchery = *item::spawn_temporary( "fake_adv_butchery", bday );
+        butchery.charges = veh->fuel_left( itype_battery, true );
+        butchery.item_tags.insert( flag_PSEUDO );
+        //A very hacky way to make game take vehicle part into the account for flat surface
+        butchery.item_tags.insert( flag_FLATSURF );
+        add( butchery, false );
+        found_parts.insert( &*butcherpart );
+    }
+    if( weldpart && !found_parts.contains( &*weldpart ) ) {
+        item &welder = *item::spawn_temporary( "welder", bday );
+        welder.charges = veh->fuel_left( itype_battery, true );
+        welder.item_tags.insert( flag_PSEUDO );
+        add( welder, false );
+
+        item &soldering_iron = *item::spawn_temporary( "soldering_iron", bday );
+        soldering_iron.charges = veh->fuel_left( itype_battery, true );
+        soldering_iron.item_tags.insert( flag_PSEUDO );
+        add( soldering_iron, false );
+        found_parts.insert( &*weldpart );
+    }
+    if( craftpart && !found_parts.contains( &*craftpart ) ) {
+        item &vac_sealer = *item::spawn_temporary( "vac_sealer", bday );
+        vac_sealer.charges = veh->fuel_left( itype_battery, true );
+        vac_sealer.item_tags.insert( flag_PSEUDO );
+        add( vac_sealer, false );
+
+        item &dehydrator = *item::spawn_temporary( "dehydrator", bday );
+        dehydrator.charges = veh->fuel_left( itype_battery, true );
+        dehydrator.item_tags.insert( flag_PSEUDO );
+        add( dehydrator, false );
+
+        item &food_processor = *item::spawn_temporary( "food_processor", bday );
+        food_processor.charges = veh->fuel_left( itype_battery, true );
+        food_processor.item_tags.insert( flag_PSEUDO );
+        add( food_processor, false );
+
+        item &press = *item::spawn_temporary( "press", bday );
+        press.charges = veh->fuel_left( itype_battery, true );
+        press.set_flag( flag_PSEUDO );
+        add( press, false );
+        found_parts.insert( &*craftpart );
+    }
+    if( forgepart && !found_parts.contains( &*forgepart ) ) {
+        item &forge = *item::spawn_temporary( "forge", bday );
+        forge.charges = veh->fuel_left( itype_battery, true );
+        forge.item_tags.insert( flag_PSEUDO );
+        add( forge, false );
+        found_parts.insert( &*forgepart );
+    }
+    if( kilnpart && !found_parts.contains( &*kilnpart ) ) {
+        item &kiln = *item::spawn_temporary( "kiln", bday );
+        kiln.charges = veh->fuel_left( itype_battery, true );
+        kiln.item_tags.insert( flag_PSEUDO );
+        add( kiln, false );
+        found_parts.insert( &*kilnpart );
+    }
+    if( chempart && !found_parts.contains( &*chempart ) ) {
+        item &chemistry_set = *item::spawn_temporary( "chemistry_set", bday );
+        chemistry_set.charges = veh->fuel_left( itype_battery, true );
+        chemistry_set.item_tags.insert( flag_PSEUDO );
+        add( chemistry_set, false );
+
+        item &electrolysis_kit = *item::spawn_temporary( "electrolysis_kit", bday );
+        electrolysis_kit.charges = veh->fuel_left( itype_battery, true );
+        electrolysis_kit.item_tags.insert( flag_PSEUDO );
+        add( electrolysis_kit, false );
+        found_parts.insert( &*chempart );
+    }
+    if( autoclavepart && !found_parts.contains( &*autoclavepart ) ) {
+        item &autoclave = *item::spawn_temporary( "autoclave", bday );
+        autoclave.charges = veh->fuel_left( itype_battery, true );
+        autoclave.item_tags.insert( flag_PSEUDO );
+        add( autoclave, false );
+        found_parts.insert( &*autoclavepart );
+    }
+}
+
+void inventory::remove_items_by_address( const std::unordered_set<const item *> &gone )
+{
+    if( gone.empty() ) {
+        return;
+    }
+    for( auto stack = items.begin(); stack != items.end(); ) {
+        stack->erase( std::remove_if( stack->begin(), stack->end(), [&gone]( const item * it ) {
+            return gone.contains( it );
+        } ), stack->end() );
+        if( stack->empty() ) {
+            stack = items.erase( stack );
+        } else {
+            ++stack;
         }
-        vehicle *const veh = &vp->vehicle();
-        if( !checked_vehi.contains( veh ) ) {
-            // We haven't worked with this vehicle yet.
-            checked_vehi[veh] = std::unordered_set<const vpart_reference *>();
-        }
-        // Make sure we're ready to record
-        std::unordered_set<const vpart_reference *> &found_parts = checked_vehi[veh];
-
-        //Adds faucet to kitchen stuff; may be horribly wrong to do such....
-        //ShouldBreak into own variable
-        const std::optional<vpart_reference> kpart = vp.part_with_feature( "KITCHEN", true );
-        const std::optional<vpart_reference> butcherpart = vp.part_with_feature( "BUTCHER_EQ", true );
-        const std::optional<vpart_reference> faupart = vp.part_with_feature( "FAUCET", true );
-        const std::optional<vpart_reference> weldpart = vp.part_with_feature( "WELDRIG", true );
-        const std::optional<vpart_reference> craftpart = vp.part_with_feature( "CRAFTRIG", true );
-        const std::optional<vpart_reference> forgepart = vp.part_with_feature( "FORGE", true );
-        const std::optional<vpart_reference> kilnpart = vp.part_with_feature( "KILN", true );
-        const std::optional<vpart_reference> chempart = vp.part_with_feature( "CHEMLAB", true );
-        const std::optional<vpart_reference> autoclavepart = vp.part_with_feature( "AUTOCLAVE", true );
-        const std::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true );
-
-        if( cargo ) {
-            const auto items = veh->get_items( cargo->part_index() );
-            for( const auto &it : items ) {
-                add_item_by_items_type_cache( *it, false, false, false );
+    }
+    binned = false;
+    items_type_cached = false;
+}
+
+static size_t summarize_structure( map &m, const tripoint &p )
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, m.ter( p ) );
+    cata::hash_combine( seed, m.furn( p ) );
+    if( const optional_vpart_position vp = m.veh_at( p ) ) {
+        cata::hash_combine( seed, &vp->vehicle() );
+        cata::hash_combine( seed, vp->part_index() );
+    }
+    return seed;
+}
+
+static void summarize_items( size_t &seed, const item &it )
+{
+    it.visit_items( [&seed]( const item * e ) {
+        cata::hash_combine( seed, e );
+        cata::hash_combine( seed, e->typeId() );
+        cata::hash_combine( seed, e->charges );
+        return VisitResponse::NEXT;
+    } );
+}
+
+static size_t summarize_contents( map &m, const tripoint &p )
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, m.get_field( p, fd_fire ) != nullptr );
+    for( const item *it : m.i_at( p ) ) {
+        summarize_items( seed, *it );
+    }
+    if( const optional_vpart_position vp = m.veh_at( p ) ) {
+        if( const std::optional<vpart_reference> cargo = vp.part_with_feature( "CARGO", true ) ) {
+            for( const item *it : cargo->vehicle().get_items( cargo->part_index() ) ) {
+                summarize_items( seed, *it );
             }
         }
+    }
+    return seed;
+}
 
-        if( faupart && !found_parts.contains( &*faupart ) ) {
-            for( const auto &it : veh->fuels_left() ) {
-                item &fuel = *item::spawn_temporary( it.first, bday );
-                if( fuel.made_of( LIQUID ) ) {
-                    fuel.charges = it.second;
-                    add_item_by_items_type_cache( fuel, false, true, false );
-                }
+const inventory &map_inventory_cache::update( map &m, const tripoint &origin, int range,
+        const Character *pl, bool clear_path )
+{
+    if( origin != this->origin || range != this->range || clear_path != this->clear_path ||
+        pl != this->pl || ( has_vehicles && turn != calendar::turn ) ) {
+        this->origin = origin;
+        this->range = range;
+        this->clear_path = clear_path;
+        this->pl = pl;
+        form( m );
+        return inv;
+    }
+
+    changed_tiles.clear();
+    for( size_t i = 0; i < tiles.size(); i++ ) {
+        tile &t = tiles[i];
+        if( summarize_structure( m, t.pos ) != t.structure ) {
+            // May change what's reachable, or what vehicles give
+            form( m );
+            return inv;
+        }
+        const size_t contents = summarize_contents( m, t.pos );
+        if( contents != t.contents || ( t.record.temporary && turn != calendar::turn ) ) {
+            t.contents = contents;
+            if( t.reachable ) {
+                changed_tiles.push_back( i );
             }
-            found_parts.insert( &*faupart );
-        }
-
-        static const flag_id flag_PSEUDO( "PSEUDO" );
-        static const flag_id flag_HEATS_FOOD( "HEATS_FOOD" );
-        static const flag_id flag_FLATSURF( "FLAT_SURFACE" );
-
-        if( kpart && !found_parts.contains( &*kpart ) ) {
-            item &hotplate = *item::spawn_temporary( "hotplate", bday );
-            hotplate.charges = veh->fuel_left( itype_battery, true );
-            hotplate.item_tags.insert( flag_PSEUDO );
-            // TODO: Allow disabling
-            hotplate.item_tags.insert( flag_HEATS_FOOD );
-            add_item_by_items_type_cache( hotplate, false );
-
-            item &pot = *item::spawn_temporary( "pot", bday );
-            pot.set_flag( flag_PSEUDO );
-            add_item_by_items_type_cache( pot, false );
-            item &pan = *item::spawn_temporary( "pan", bday );
-            pan.set_flag( flag_PSEUDO );
-            add_item_by_items_type_cache( pan, false );
-            found_parts.insert( &*kpart );
-        }
-        if( butcherpart &&
-            !found_parts.contains( &*butcherpart ) ) { //copy n paste code moment(this will go wrong)
-            item &butchery = *item::spawn_temporary( "fake_adv_butchery", bday );
-            butchery.charges = veh->fuel_left( itype_battery, true );
-            butchery.item_tags.insert( flag_PSEUDO );
-            //A very hacky way to make game take vehicle part into the account for flat surface
-            butchery.item_tags.insert( flag_FLATSURF );
-            add_item_by_items_type_cache( butchery, false );
-            found_parts.insert( &*butcherpart );
-        }
-        if( weldpart && !found_parts.contains( &*weldpart ) ) {
-            item &welder = *item::spawn_temporary( "welder", bday );
-            welder.charges = veh->fuel_left( itype_battery, true );
-            welder.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( welder, false );
-
-            item &soldering_iron = *item::spawn_temporary( "soldering_iron", bday );
-            soldering_iron.charges = veh->fuel_left( itype_battery, true );
-            soldering_iron.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( soldering_iron, false );
-            found_parts.insert( &*weldpart );
-        }
-        if( craftpart && !found_parts.contains( &*craftpart ) ) {
-            item &vac_sealer = *item::spawn_temporary( "vac_sealer", bday );
-            vac_sealer.charges = veh->fuel_left( itype_battery, true );
-            vac_sealer.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( vac_sealer, false );
-
-            item &dehydrator = *item::spawn_temporary( "dehydrator", bday );
-            dehydrator.charges = veh->fuel_left( itype_battery, true );
-            dehydrator.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( dehydrator, false );
-
-            item &food_processor = *item::spawn_temporary( "food_processor", bday );
-            food_processor.charges = veh->fuel_left( itype_battery, true );
-            food_processor.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( food_processor, false );
-
-            item &press = *item::spawn_temporary( "press", bday );
-            press.charges = veh->fuel_left( itype_battery, true );
-            press.set_flag( flag_PSEUDO );
-            add_item_by_items_type_cache( press, false );
-            found_parts.insert( &*craftpart );
-        }
-        if( forgepart && !found_parts.contains( &*forgepart ) ) {
-            item &forge = *item::spawn_temporary( "forge", bday );
-            forge.charges = veh->fuel_left( itype_battery, true );
-            forge.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( forge, false );
-            found_parts.insert( &*forgepart );
-        }
-        if( kilnpart && !found_parts.contains( &*kilnpart ) ) {
-            item &kiln = *item::spawn_temporary( "kiln", bday );
-            kiln.charges = veh->fuel_left( itype_battery, true );
-            kiln.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( kiln, false );
-            found_parts.insert( &*kilnpart );
-        }
-        if( chempart && !found_parts.contains( &*chempart ) ) {
-            item &chemistry_set = *item::spawn_temporary( "chemistry_set", bday );
-            chemistry_set.charges = veh->fuel_left( itype_battery, true );
-            chemistry_set.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( chemistry_set, false );
-
-            item &electrolysis_kit = *item::spawn_temporary( "electrolysis_kit", bday );
-            electrolysis_kit.charges = veh->fuel_left( itype_battery, true );
-            electrolysis_kit.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( electrolysis_kit, false );
-            found_parts.insert( &*chempart );
-        }
-        if( autoclavepart && !found_parts.contains( &*autoclavepart ) ) {
-            item &autoclave = *item::spawn_temporary( "autoclave", bday );
-            autoclave.charges = veh->fuel_left( itype_battery, true );
-            autoclave.item_tags.insert( flag_PSEUDO );
-            add_item_by_items_type_cache( autoclave, false );
-            found_parts.insert( &*autoclavepart );
         }
     }
-    pts.clear();
+    turn = calendar::turn;
+    if( changed_tiles.empty() ) {
+        return inv;
+    }
+
+    std::unordered_set<const item *> gone;
+    for( const size_t i : changed_tiles ) {
+        gone.insert( tiles[i].record.added.begin(), tiles[i].record.added.end() );
+        tiles[i].record = inventory::tile_record();
+    }
+    inv.remove_items_by_address( gone );
+    inv.build_items_type_cache();
+    inventory::vehicle_parts_seen checked_vehi;
+    for( const size_t i : changed_tiles ) {
+        inv.form_from_tile( m, tiles[i].pos, pl, false, checked_vehi, &tiles[i].record );
+    }
+    revision++;
+    return inv;
+}
+
+void map_inventory_cache::invalidate()
+{
+    origin = tripoint_min;
+    tiles.clear();
+}
+
+void map_inventory_cache::form( map &m )
+{
+    std::unordered_set<tripoint> reachable;
+    if( clear_path ) {
+        std::vector<tripoint> reachable_pts;
+        m.reachable_flood_steps( reachable_pts, origin, range, 1, 100 );
+        reachable.insert( reachable_pts.begin(), reachable_pts.end() );
+    }
+
+    tiles.clear();
+    has_vehicles = false;
+    inv.clear();
+    inv.build_items_type_cache();
+    inventory::vehicle_parts_seen checked_vehi;
+    for( const tripoint &p : m.points_in_radius( origin, range ) ) {
+        tile &t = tiles.emplace_back();
+        t.pos = p;
+        t.structure = summarize_structure( m, p );
+        t.contents = summarize_contents( m, p );
+        t.reachable = !clear_path || reachable.contains( p );
+        has_vehicles |= static_cast<bool>( m.veh_at( p ) );
+        if( t.reachable ) {
+            inv.form_from_tile( m, p, pl, false, checked_vehi, &t.record );
+        }
+    }
+    turn = calendar::turn;
+    revision++;
 }
 
 std::vector<detached_ptr<item>> location_inventory::reduce_stack( const int position,
@@ -13,7 +13,9 @@
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "item.h"
+#include "point.h"
 #include "units.h"
 #include "visitable.h"
 
@@ -24,7 +26,8 @@ class item_stack;
 class map;
 class npc;
 class player;
-struct tripoint;
+class vehicle;
+class vpart_reference;
 
 using invstack = std::list<std::vector<item *> >;
 using const_invslice = std::vector<const std::vector<item *> *>;
@@ -229,6 +232,19 @@ class inventory : public temp_visitable<inventory>
         void build_items_type_cache();
 
     private:
+        using vehicle_parts_seen = std::unordered_map<const vehicle *, std::unordered_set<const vpart_reference *>>;
+        /** What @ref form_from_tile added. */
+        struct tile_record {
+            std::vector<const item *> added;
+            // Whether some of it only lives until the end of the turn
+            bool temporary = false;
+        };
+        void form_from_tile( map &m, const tripoint &p, const Character *pl, bool assign_invlet,
+                             vehicle_parts_seen &checked_vehi, tile_record *record );
+        /** Removes the given items without looking at them, they may be gone already. */
+        void remove_items_by_address( const std::unordered_set<const item *> &gone );
+
+        friend class map_inventory_cache;
         friend location_inventory;
         friend visitable<inventory>;
         friend temp_visitable<inventory>;
@@ -250,6 +266,56 @@ class inventory : public temp_visitable<inventory>
         mutable itype_bin binned_items;
 };
 
+/**
+ * What @ref inventory::form_from_map finds around a spot, kept up to date between calls.
+ *
+ * Each update compares a summary of every tile in range with the one from the last update,
+ * and only forms the tiles whose items changed again. Everything is formed from scratch
+ * when the origin or range moves, or the terrain, furniture or vehicles in range change.
+ * Pseudo items of furniture, fires and water sources only live until the end of the turn,
+ * so their tiles are formed again in every new turn, and so is everything when vehicles
+ * are in range, since their tools depend on fuel that isn't part of the summary.
+ *
+ * The quality cache of the inventory is left alone, users add to it before they need it.
+ */
+class map_inventory_cache
+{
+    public:
+        /** Brings the inventory up to date with the map and returns it. */
+        const inventory &update( map &m, const tripoint &origin, int range, const Character *pl,
+                                 bool clear_path );
+        /** The next update forms the inventory from scratch. */
+        void invalidate();
+        /** Changes whenever an update changes the inventory. */
+        int get_revision() const {
+            return revision;
+        }
+
+    private:
+        struct tile {
+            tripoint pos;
+            // Terrain, furniture and vehicle
+            size_t structure = 0;
+            // Items and fire
+            size_t contents = 0;
+            bool reachable = false;
+            inventory::tile_record record;
+        };
+
+        inventory inv;
+        std::vector<tile> tiles;
+        std::vector<size_t> changed_tiles;
+        tripoint origin = tripoint_min;
+        int range = -1;
+        bool clear_path = false;
+        const Character *pl = nullptr;
+        time_point turn = calendar::before_time_starts;
+        bool has_vehicles = false;
+        int revision = 0;
+
+        void form( map &m );
+};
+
 class location_inventory : public location_visitable<location_inventory>
 {
     private:
@@ -358,6 +358,15 @@ static const std::string flag_FISHABLE( "FISHABLE" );
 static const std::string flag_PLANT( "PLANT" );
 static const std::string flag_PLOWABLE( "PLOWABLE" );
 
+static const ter_furn_flag_id ter_furn_flag_CURRENT( "CURRENT" );
+static const ter_furn_flag_id ter_furn_flag_DIGGABLE( "DIGGABLE" );
+static const ter_furn_flag_id ter_furn_flag_DIGGABLE_CAN_DEEPEN( "DIGGABLE_CAN_DEEPEN" );
+static const ter_furn_flag_id ter_furn_flag_FISHABLE( "FISHABLE" );
+static const ter_furn_flag_id ter_furn_flag_MINEABLE( "MINEABLE" );
+static const ter_furn_flag_id ter_furn_flag_RUBBLE( "RUBBLE" );
+static const ter_furn_flag_id ter_furn_flag_SWIMMABLE( "SWIMMABLE" );
+static const ter_furn_flag_id ter_furn_flag_TREE( "TREE" );
+
 // how many characters per turn of radio
 static constexpr int RADIO_PER_TURN = 25;
 
@@ -1607,7 +1616,7 @@ static bool good_fishing_spot( tripoint pos )
     const oter_id &cur_omt =
         overmap_buffer.ter( tripoint_abs_omt( ms_to_omt_copy( here.getabs( pos ) ) ) );
     std::string om_id = cur_omt.id().c_str();
-    if( fishables.empty() && !g->m.has_flag( "CURRENT", pos ) &&
+    if( fishables.empty() && !g->m.has_flag( ter_furn_flag_CURRENT, pos ) &&
         om_id.find( "river_" ) == std::string::npos && !cur_omt->is_lake() && !cur_omt->is_lake_shore() ) {
         g->u.add_msg_if_player( m_info, _( "You doubt you will have much luck catching fish here" ) );
         return false;
@@ -1676,7 +1685,7 @@ int iuse::fish_trap( player *p, item *it, bool t, const tripoint &pos )
         }
         const tripoint pnt = *pnt_;
 
-        if( !g->m.has_flag( "FISHABLE", pnt ) ) {
+        if( !g->m.has_flag( ter_furn_flag_FISHABLE, pnt ) ) {
             p->add_msg_if_player( m_info, _( "You can't fish there!" ) );
             return 0;
         }
@@ -1700,7 +1709,7 @@ int iuse::fish_trap( player *p, item *it, bool t, const tripoint &pos )
         if( it->age() > 3_hours ) {
             it->deactivate();
 
-            if( !g->m.has_flag( "FISHABLE", pos ) ) {
+            if( !g->m.has_flag( ter_furn_flag_FISHABLE, pos ) ) {
                 return 0;
             }
 
@@ -2466,7 +2475,7 @@ int iuse::dig( player *p, item *it, bool t, const tripoint & )
     }
     const tripoint dig_point = p->pos();
 
-    const bool can_dig_here = g->m.has_flag( "DIGGABLE", dig_point ) &&
+    const bool can_dig_here = g->m.has_flag( ter_furn_flag_DIGGABLE, dig_point ) &&
                               !g->m.has_furn( dig_point ) &&
                               g->m.tr_at( dig_point ).is_null() &&
                               ( g->m.ter( dig_point ) == t_grave_new || g->m.i_at( dig_point ).empty() ) &&
@@ -2477,7 +2486,7 @@ int iuse::dig( player *p, item *it, bool t, const tripoint & )
             _( "You can't dig a pit in this location.  Ensure it is clear diggable ground with no items or obstacles." ) );
         return 0;
     }
-    const bool can_deepen = g->m.has_flag( "DIGGABLE_CAN_DEEPEN", dig_point );
+    const bool can_deepen = g->m.has_flag( ter_furn_flag_DIGGABLE_CAN_DEEPEN, dig_point );
     const bool grave = g->m.ter( dig_point ) == t_grave;
 
     if( !p->crafting_inventory().has_quality( qual_DIG, 2 ) ) {
@@ -2697,7 +2706,7 @@ int iuse::clear_rubble( player *p, item *it, bool, const tripoint & )
         return 0;
     }
     const std::function<bool( const tripoint & )> f = []( const tripoint & pnt ) {
-        return g->m.has_flag( "RUBBLE", pnt );
+        return g->m.has_flag( ter_furn_flag_RUBBLE, pnt );
     };
 
     const std::optional<tripoint> pnt_ = choose_adjacent_highlight(
@@ -2803,7 +2812,7 @@ int iuse::jackhammer( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( ter_furn_flag_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't drill there." ) );
         return 0;
     }
@@ -2895,7 +2904,7 @@ int iuse::pickaxe( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( ter_furn_flag_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't mine there." ) );
         return 0;
     }
@@ -2950,7 +2959,7 @@ int iuse::burrow( player *p, item *it, bool, const tripoint &pos )
         pnt = *pnt_;
     }
 
-    if( !g->m.has_flag( "MINEABLE", pnt ) ) {
+    if( !g->m.has_flag( ter_furn_flag_MINEABLE, pnt ) ) {
         p->add_msg_if_player( m_info, _( "You can't burrow there." ) );
         return 0;
     }
@@ -4407,7 +4416,7 @@ int iuse::chop_tree( player *p, item *it, bool t, const tripoint & )
         if( pnt == g->u.pos() ) {
             return false;
         }
-        return g->m.has_flag( "TREE", pnt );
+        return g->m.has_flag( ter_furn_flag_TREE, pnt );
     };
 
     const std::optional<tripoint> pnt_ = choose_adjacent_highlight(
@@ -7286,7 +7295,7 @@ int iuse::ehandcuffs( player *p, item *it, bool t, const tripoint &pos )
 
     if( t ) {
 
-        if( g->m.has_flag( "SWIMMABLE", pos.xy() ) ) {
+        if( g->m.has_flag( ter_furn_flag_SWIMMABLE, pos.xy() ) ) {
             it->unset_flag( flag_NO_UNWIELD );
             it->ammo_unset();
             it->deactivate();
@@ -8612,6 +8621,7 @@ int iuse::cable_attach( player *who, item *cable, bool, const tripoint & )
                 who->add_msg_if_player( m_good, _( "You connect the %s to the electric grid." ),
                                         v->name );
                 grid_connector->connected_vehicles.emplace_back( g->m.getabs( v->global_pos3() ) );
+                get_distribution_grid_tracker().grid_at( connector ).schedule_update();
                 v->install_part( vcoords, std::move( v_part ) );
             }
             return 1;    // Let the cable be destroyed.
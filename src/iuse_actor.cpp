@@ -158,6 +158,9 @@ static const trait_flag_str_id trait_flag_PRED2( "PRED2" );
 static const trait_flag_str_id trait_flag_PRED3( "PRED3" );
 static const trait_flag_str_id trait_flag_PRED4( "PRED4" );
 
+static const ter_furn_flag_id ter_furn_flag_DIGGABLE( "DIGGABLE" );
+static const ter_furn_flag_id ter_furn_flag_FLAT( "FLAT" );
+
 class npc;
 
 std::unique_ptr<iuse_actor> iuse_transform::clone() const
@@ -4173,7 +4176,7 @@ int place_trap_actor::use( player &p, item &it, bool, const tripoint & ) const
     }
 
     const bool has_shovel = p.has_quality( quality_id( "DIG" ), 3 );
-    const bool is_diggable = here.has_flag( "DIGGABLE", pos );
+    const bool is_diggable = here.has_flag( ter_furn_flag_DIGGABLE, pos );
     bool bury = false;
     if( could_bury && has_shovel && is_diggable ) {
         bury = query_yn( _( bury_question ) );
@@ -4677,7 +4680,7 @@ int deploy_tent_actor::use( player &p, item &it, bool, const tripoint & ) const
             add_msg( m_info, _( "%s is in the way." ), c->disp_name( false, true ) );
             return 0;
         }
-        if( here.impassable( dest ) || !here.has_flag( "FLAT", dest ) ) {
+        if( here.impassable( dest ) || !here.has_flag( ter_furn_flag_FLAT, dest ) ) {
             add_msg( m_info, _( "The %s in that direction isn't suitable for placing the %s." ),
                      here.name( dest ), it.tname() );
             return 0;
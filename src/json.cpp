@@ -13,6 +13,7 @@
 #include <locale> // ensure user's locale doesn't interfere with output
 #include <set>
 #include <sstream>
+#include <streambuf>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,6 +33,59 @@ static bool is_whitespace( char ch )
     return ( ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' );
 }
 
+// Characters that read_plain_string can copy as they are
+static bool is_plain_string_char( char ch )
+{
+    const unsigned char uc = static_cast<unsigned char>( ch );
+    return ch != '"' && ch != '\\' && uc >= 0x20 && uc < 0x80;
+}
+
+/**
+ * Read-only stream buffer over memory owned by someone else. JsonIn reads through it
+ * like through any other stream, but its hot paths also look at the memory directly.
+ */
+class json_memory_buffer : public std::streambuf
+{
+    public:
+        explicit json_memory_buffer( std::string_view data ) {
+            char *begin = const_cast<char *>( data.data() );
+            setg( begin, begin, begin + data.size() );
+        }
+
+        const char *begin() const {
+            return eback();
+        }
+        const char *current() const {
+            return gptr();
+        }
+        const char *end() const {
+            return egptr();
+        }
+        void move_to( const char *pos ) {
+            setg( eback(), const_cast<char *>( pos ), egptr() );
+        }
+
+    protected:
+        pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                          std::ios_base::openmode which ) override {
+            off_type base = 0;
+            if( dir == std::ios_base::cur ) {
+                base = gptr() - eback();
+            } else if( dir == std::ios_base::end ) {
+                base = egptr() - eback();
+            }
+            return seekpos( pos_type( base + off ), which );
+        }
+        pos_type seekpos( pos_type pos, std::ios_base::openmode which ) override {
+            const off_type off = pos;
+            if( !( which & std::ios_base::in ) || off < 0 || off > egptr() - eback() ) {
+                return pos_type( off_type( -1 ) );
+            }
+            setg( eback(), eback() + off, egptr() );
+            return pos;
+        }
+};
+
 // for parsing \uxxxx escapes
 static std::string utf16_to_utf8( uint32_t ch )
 {
@@ -84,13 +138,13 @@ JsonObject::JsonObject( JsonIn &j )
     start = jsin->tell();
     // cache the position of the value for each member
     jsin->start_object();
+    std::string name_storage;
     while( !jsin->end_object() ) {
-        std::string n = jsin->get_member_name();
+        const std::string_view n = jsin->get_member_name_view( name_storage );
         int p = jsin->tell();
-        if( positions.contains( n ) ) {
+        if( !positions.try_emplace( std::string( n ), p ).second ) {
             j.error( "duplicate entry in json object" );
         }
-        positions[n] = p;
         jsin->skip_value();
     }
     end_ = jsin->tell();
@@ -809,8 +863,40 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+JsonIn::JsonIn( std::istream &s ) : stream( &s )
+{
+}
+
+JsonIn::JsonIn( std::istream &s, const std::string &path )
+    : stream( &s ), path( make_shared_fast<std::string>( path ) )
+{
+}
+
+JsonIn::JsonIn( std::istream &s, const json_source_location &loc )
+    : stream( &s ), path( loc.path )
+{
+    seek( loc.offset );
+}
+
+JsonIn::JsonIn( std::string_view data )
+    : memory( std::make_unique<json_memory_buffer>( data ) ),
+      memory_stream( std::make_unique<std::istream>( memory.get() ) ),
+      stream( memory_stream.get() )
+{
+}
+
+JsonIn::JsonIn( std::string_view data, const std::string &path ) : JsonIn( data )
+{
+    this->path = make_shared_fast<std::string>( path );
+}
+
+JsonIn::~JsonIn() = default;
+
 int JsonIn::tell()
 {
+    if( memory && !stream->fail() ) {
+        return static_cast<int>( memory->current() - memory->begin() );
+    }
     return stream->tellg();
 }
 char JsonIn::peek()
@@ -831,6 +917,14 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( memory && stream->good() ) {
+        const char *pos = memory->current();
+        while( pos != memory->end() && is_whitespace( *pos ) ) {
+            ++pos;
+        }
+        memory->move_to( pos );
+        return;
+    }
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -911,6 +1005,22 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
+    if( memory && stream->good() && memory->current() != memory->end() &&
+        *memory->current() == '"' ) {
+        const char *pos = memory->current() + 1;
+        while( pos != memory->end() && *pos != '"' && *pos != '\r' && *pos != '\n' ) {
+            if( *pos == '\\' && pos + 1 != memory->end() ) {
+                ++pos;
+            }
+            ++pos;
+        }
+        // Anything else is an error, let the stream code below report it
+        if( pos != memory->end() && *pos == '"' ) {
+            memory->move_to( pos + 1 );
+            end_value();
+            return;
+        }
+    }
     stream->get( ch );
     if( ch != '"' ) {
         std::stringstream err;
@@ -1043,6 +1153,45 @@ std::string JsonIn::get_member_name()
     return s;
 }
 
+std::string_view JsonIn::get_string_view( std::string &storage )
+{
+    eat_whitespace();
+    std::string_view plain;
+    if( read_plain_string( plain ) ) {
+        return plain;
+    }
+    storage = get_string();
+    return storage;
+}
+
+std::string_view JsonIn::get_member_name_view( std::string &storage )
+{
+    const std::string_view s = get_string_view( storage );
+    skip_pair_separator();
+    return s;
+}
+
+bool JsonIn::read_plain_string( std::string_view &s )
+{
+    if( !memory || !stream->good() || memory->current() == memory->end() ||
+        *memory->current() != '"' ) {
+        return false;
+    }
+    const char *const start = memory->current() + 1;
+    const char *pos = start;
+    while( pos != memory->end() && is_plain_string_char( *pos ) ) {
+        ++pos;
+    }
+    // Escapes, UTF-8 and errors are left to get_string
+    if( pos == memory->end() || *pos != '"' ) {
+        return false;
+    }
+    s = std::string_view( start, pos - start );
+    memory->move_to( pos + 1 );
+    end_value();
+    return true;
+}
+
 static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::string &err )
 {
     if( !stream.good() ) {
@@ -1180,6 +1329,10 @@ static bool get_escaped_or_unicode( std::istream &stream, std::string &s, std::s
 std::string JsonIn::get_string()
 {
     eat_whitespace();
+    std::string_view plain;
+    if( read_plain_string( plain ) ) {
+        return std::string( plain );
+    }
     std::string s;
     char ch;
     std::string err;
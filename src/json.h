@@ -6,9 +6,11 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -38,6 +40,7 @@
 
 class JsonArray;
 class JsonDeserializer;
+class json_memory_buffer;
 class JsonObject;
 class JsonSerializer;
 class JsonValue;
@@ -166,6 +169,9 @@ struct number_sci_notation {
 class JsonIn
 {
     private:
+        // Only set when reading from memory, then stream reads from it
+        std::unique_ptr<json_memory_buffer> memory;
+        std::unique_ptr<std::istream> memory_stream;
         std::istream *stream;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
@@ -173,17 +179,24 @@ class JsonIn
         void skip_separator();
         void skip_pair_separator();
         void end_value();
+        // Reads a string without escapes or non-ASCII characters straight from memory
+        bool read_plain_string( std::string_view &s );
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
-        JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
-        JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
-            seek( loc.offset );
-        }
+        JsonIn( std::istream &s );
+        JsonIn( std::istream &s, const std::string &path );
+        JsonIn( std::istream &s, const json_source_location &loc );
+        /**
+         * Reads straight from memory, without copying it into a stream first.
+         * The data must stay valid and unchanged while this object is used.
+         * Prefer this whenever the whole document is in memory anyway, reading
+         * strings and skipping values is much faster than from a stream.
+         */
+        explicit JsonIn( std::string_view data );
+        JsonIn( std::string_view data, const std::string &path );
         JsonIn( const JsonIn & ) = delete;
         JsonIn &operator=( const JsonIn & ) = delete;
+        ~JsonIn();
 
         shared_ptr_fast<std::string> get_path() const {
             return path;
@@ -226,6 +239,13 @@ class JsonIn
         bool get_bool(); // get the next value as a bool
         double get_float(); // get the next value as a double
         std::string get_member_name(); // also strips the ':'
+        /**
+         * Like @ref get_string and @ref get_member_name, but when reading from memory the
+         * result points into it if the string has no escapes. Otherwise it's decoded into
+         * @p storage and the result points there.
+         */
+        std::string_view get_string_view( std::string &storage );
+        std::string_view get_member_name_view( std::string &storage );
         JsonObject get_object();
         JsonArray get_array();
 
@@ -26,6 +26,8 @@
 #include "type_id.h"
 #include "point.h"
 
+static const ter_furn_flag_id ter_furn_flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+
 enum astar_state {
     ASL_NONE,
     ASL_OPEN,
@@ -366,7 +368,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                         // Climbing fences
                         newg += climb_cost;
                     } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                               ( !terrain.has_flag( ter_furn_flag_OPENCLOSE_INSIDE ) || !furniture.has_flag( ter_furn_flag_OPENCLOSE_INSIDE ) ||
                                  !is_outside( cur ) ) ) {
                         // Only try to open INSIDE doors from the inside
                         // To open and then move onto the tile
@@ -2,6 +2,7 @@
 #include "shadowcasting.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -12,6 +13,7 @@
 
 #include "avatar.h"
 #include "calendar.h"
+#include "cached_options.h"
 #include "cata_unreachable.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -35,6 +37,7 @@
 #include "profile.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "type_id.h"
 #include "veh_type.h"
@@ -102,6 +105,16 @@ void map::add_light_from_items( const tripoint &p, const item_stack::iterator &b
     }
 }
 
+void map::update_weather_transparency_lookup()
+{
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+
+    if( sight_penalty != 1.0f &&
+        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
+        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
+    }
+}
+
 // TODO: Consider making this just clear the cache and dynamically fill it in as is_transparent() is called
 bool map::build_transparency_cache( const int zlev )
 {
@@ -126,11 +139,6 @@ bool map::build_transparency_cache( const int zlev )
 
     const float sight_penalty = get_weather().weather_id->sight_penalty;
 
-    if( sight_penalty != 1.0f &&
-        LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty != weather_transparency_lookup.transparency ) {
-        weather_transparency_lookup.reset( LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty );
-    }
-
     // Traverse the submaps in order
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
@@ -434,6 +442,54 @@ void map::build_sunlight_cache( int pzlev )
     }
 }
 
+namespace
+{
+
+using lightmap_quadrants = four_quadrants[MAPSIZE_X][MAPSIZE_Y];
+using lightmap_floats = float[MAPSIZE_X][MAPSIZE_Y];
+
+/**
+ * A light cast collected by generate_lightmap and applied only once every light
+ * source of the z-level is known.
+ *
+ * Casting only ever raises values in the lightmap with max(), so deferred lights
+ * can be applied in any order and into separate buffers that are merged afterwards,
+ * without changing the result.
+ */
+struct deferred_light {
+    enum class shape : int {
+        source,
+        arc,
+    };
+
+    shape type = shape::source;
+    tripoint p;
+    float luminance = 0.0f;
+    // Whether the light's own tile is inside the map, see map::inbounds.
+    bool in_bounds = false;
+    // For sources: whether to cast to the north, east, south and west,
+    // decided against the light source buffer at the time the light was added.
+    std::array<bool, 4> directions = {};
+    // For arcs: direction and width of the beam.
+    units::angle angle = 0_degrees;
+    units::angle wideangle = 0_degrees;
+};
+
+// Private output of one worker while casting deferred lights in parallel.
+struct lightmap_buffer {
+    lightmap_quadrants lm;
+    lightmap_floats sm;
+};
+
+} // namespace
+
+static deferred_light prepare_light_source( const level_cache &cache, bool in_bounds,
+        const tripoint &p, float luminance );
+static deferred_light prepare_light_arc( bool in_bounds, const tripoint &p, units::angle angle,
+        float luminance, units::angle wideangle );
+static void apply_deferred_lights( level_cache &map_cache,
+                                   const std::vector<deferred_light> &lights );
+
 void map::generate_lightmap( const int zlev )
 {
     ZoneScoped;
@@ -541,6 +597,26 @@ void map::generate_lightmap( const int zlev )
         }
     }
 
+    // Everything above reads back the lightmap it builds and has to run in order.
+    // Light cast from here on only raises it, so it is collected first and applied in one go.
+    std::vector<deferred_light> deferred_lights;
+    // Lights on other z-levels go into their own level's cache and are not deferred.
+    const auto defer_light_source = [&]( const tripoint & p, float luminance ) {
+        if( p.z != zlev ) {
+            apply_light_source( p, luminance );
+            return;
+        }
+        deferred_lights.push_back( prepare_light_source( map_cache, inbounds( p ), p, luminance ) );
+    };
+    const auto defer_light_arc = [&]( const tripoint & p, units::angle angle, float luminance,
+    units::angle wideangle ) {
+        if( p.z != zlev ) {
+            apply_light_arc( p, angle, luminance, wideangle );
+            return;
+        }
+        deferred_lights.push_back( prepare_light_arc( inbounds( p ), p, angle, luminance, wideangle ) );
+    };
+
     for( monster &critter : g->all_monsters() ) {
         if( critter.is_hallucination() ) {
             continue;
@@ -548,13 +624,13 @@ void map::generate_lightmap( const int zlev )
         const tripoint &mp = critter.pos();
         if( inbounds( mp ) ) {
             if( critter.has_effect( effect_onfire ) ) {
-                apply_light_source( mp, 8 );
+                defer_light_source( mp, 8 );
             }
             // TODO: [lightmap] Attach natural light brightness to creatures
             // TODO: [lightmap] Allow creatures to have light attacks (i.e.: eyebot)
             // TODO: [lightmap] Allow creatures to have facing and arc lights
             if( critter.type->luminance > 0 ) {
-                apply_light_source( mp, critter.type->luminance );
+                defer_light_source( mp, critter.type->luminance );
             }
         }
     }
@@ -589,20 +665,20 @@ void map::generate_lightmap( const int zlev )
             if( vp.has_flag( VPFLAG_CONE_LIGHT ) ) {
                 if( veh_luminance > lit_level::LIT ) {
                     add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                    apply_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
+                    defer_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
                                      45_degrees );
                 }
 
             } else if( vp.has_flag( VPFLAG_WIDE_CONE_LIGHT ) ) {
                 if( veh_luminance > lit_level::LIT ) {
                     add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                    apply_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
+                    defer_light_arc( src, v->face.dir() + pt->direction, veh_luminance,
                                      90_degrees );
                 }
 
             } else if( vp.has_flag( VPFLAG_HALF_CIRCLE_LIGHT ) ) {
                 add_light_source( src, M_SQRT2 ); // Add a little surrounding light
-                apply_light_arc( src, v->face.dir() + pt->direction, vp.bonus, 180_degrees );
+                defer_light_arc( src, v->face.dir() + pt->direction, vp.bonus, 180_degrees );
 
             } else if( vp.has_flag( VPFLAG_CIRCLE_LIGHT ) ) {
                 const bool odd_turn = calendar::once_every( 2_turns );
@@ -640,9 +716,10 @@ void map::generate_lightmap( const int zlev )
     const tripoint cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
     for( const tripoint &p : points_in_rectangle( cache_start, cache_end ) ) {
         if( light_source_buffer[p.x][p.y] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x][p.y] );
+            defer_light_source( p, light_source_buffer[p.x][p.y] );
         }
     }
+    apply_deferred_lights( map_cache, deferred_lights );
     for( const std::pair<tripoint, float> &elem : lm_override ) {
         lm[elem.first.x][elem.first.y].fill( elem.second );
     }
@@ -1749,26 +1826,20 @@ static float light_from_lookup( const float &numerator, const float &transparenc
     return numerator *  transparency  / distance ;
 }
 
-void map::apply_light_source( const tripoint &p, float luminance )
+static deferred_light prepare_light_source( const level_cache &cache, const bool in_bounds,
+        const tripoint &p, const float luminance )
 {
-    auto &cache = get_cache( p.z );
-    four_quadrants( &lm )[MAPSIZE_X][MAPSIZE_Y] = cache.lm;
-    float ( &sm )[MAPSIZE_X][MAPSIZE_Y] = cache.sm;
-    float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
-    float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
-    diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
-
-    const point p2( p.xy() );
-
-    if( inbounds( p ) ) {
-        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
-        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
-    }
-    if( luminance <= lit_level::LOW ) {
-        return;
-    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
+    deferred_light light;
+    light.type = deferred_light::shape::source;
+    light.p = p;
+    light.luminance = luminance;
+    light.in_bounds = in_bounds;
+
+    float cast_luminance = luminance;
+    if( cast_luminance <= lit_level::LOW ) {
+        return light;
+    } else if( cast_luminance <= lit_level::BRIGHT_ONLY ) {
+        cast_luminance = 1.49f;
     }
 
     /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
@@ -1787,13 +1858,39 @@ void map::apply_light_source( const tripoint &p, float luminance )
         sssSsss
            sy
     */
+    const float ( &light_source_buffer )[MAPSIZE_X][MAPSIZE_Y] = cache.light_source_buffer;
+    const point p2( p.xy() );
     const int peer_inbounds = LIGHTMAP_CACHE_X - 1;
-    bool north = ( p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < luminance );
-    bool south = ( p2.y != peer_inbounds && light_source_buffer[p2.x][p2.y + 1] < luminance );
-    bool east = ( p2.x != peer_inbounds && light_source_buffer[p2.x + 1][p2.y] < luminance );
-    bool west = ( p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < luminance );
+    light.directions[0] = p2.y != 0 && light_source_buffer[p2.x][p2.y - 1] < cast_luminance;
+    light.directions[1] = p2.x != peer_inbounds &&
+                          light_source_buffer[p2.x + 1][p2.y] < cast_luminance;
+    light.directions[2] = p2.y != peer_inbounds &&
+                          light_source_buffer[p2.x][p2.y + 1] < cast_luminance;
+    light.directions[3] = p2.x != 0 && light_source_buffer[p2.x - 1][p2.y] < cast_luminance;
+    return light;
+}
+
+static void cast_light_source( lightmap_quadrants &lm, lightmap_floats &sm,
+                               const level_cache &cache, const deferred_light &light )
+{
+    const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.transparency_cache;
+    const diagonal_blocks( &blocked_cache )[MAPSIZE_X][MAPSIZE_Y] = cache.vehicle_obscured_cache;
+
+    const point p2( light.p.xy() );
+    float luminance = light.luminance;
+
+    if( light.in_bounds ) {
+        const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
+        lm[p2.x][p2.y] = elementwise_max( lm[p2.x][p2.y], min_light );
+        sm[p2.x][p2.y] = std::max( sm[p2.x][p2.y], luminance );
+    }
+    if( luminance <= lit_level::LOW ) {
+        return;
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
 
-    if( north ) {
+    if( light.directions[0] ) {
         castLightWithLookup < 1, 0, 0, -1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1802,7 +1899,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( east ) {
+    if( light.directions[1] ) {
         castLightWithLookup < 0, -1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup > (
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1811,7 +1908,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( south ) {
+    if( light.directions[2] ) {
         castLightWithLookup<1, 0, 0, 1, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1820,7 +1917,7 @@ void map::apply_light_source( const tripoint &p, float luminance )
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
     }
 
-    if( west ) {
+    if( light.directions[3] ) {
         castLightWithLookup<0, 1, 1, 0, float, four_quadrants, light_calc, light_check,
                             update_light_quadrants, accumulate_transparency, light_from_lookup>(
                                 lm, transparency_cache, blocked_cache, p2, 0, luminance );
@@ -1830,6 +1927,13 @@ void map::apply_light_source( const tripoint &p, float luminance )
     }
 }
 
+void map::apply_light_source( const tripoint &p, float luminance )
+{
+    auto &cache = get_cache( p.z );
+    cast_light_source( cache.lm, cache.sm, cache,
+                       prepare_light_source( cache, inbounds( p ), p, luminance ) );
+}
+
 void map::apply_directional_light( const tripoint &p, int direction, float luminance )
 {
     const point p2( p.xy() );
@@ -1870,64 +1974,10 @@ void map::apply_directional_light( const tripoint &p, int direction, float lumin
     }
 }
 
-void map::apply_light_arc( const tripoint &p, units::angle angle, float luminance,
-                           units::angle wideangle )
-{
-    if( luminance <= LIGHT_SOURCE_LOCAL ) {
-        return;
-    }
-
-    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
-
-    apply_light_source( p, LIGHT_SOURCE_LOCAL );
-
-    // Normalize (should work with negative values too)
-    const units::angle wangle = wideangle / 2.0;
-
-    units::angle nangle = fmod( angle, 360_degrees );
-
-    tripoint end;
-    int range = LIGHT_RANGE( luminance );
-    calc_ray_end( nangle, range, p, end );
-    apply_light_ray( lit, p, end, luminance );
-
-    tripoint test;
-    calc_ray_end( wangle + nangle, range, p, test );
-
-    const float wdist = hypot( end.x - test.x, end.y - test.y );
-    if( wdist <= 0.5 ) {
-        return;
-    }
-
-    // attempt to determine beam intensity required to cover all squares
-    const units::angle wstep = ( wangle / ( wdist * M_SQRT2 ) );
-
-    // NOLINTNEXTLINE(clang-analyzer-security.FloatLoopCounter)
-    for( units::angle ao = wstep; ao <= wangle; ao += wstep ) {
-        if( trigdist ) {
-            double fdist = ( ao * M_PI_2 ) / wangle;
-            end.x = static_cast<int>(
-                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle + ao ) );
-            end.y = static_cast<int>(
-                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle + ao ) );
-            apply_light_ray( lit, p, end, luminance );
-
-            end.x = static_cast<int>(
-                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle - ao ) );
-            end.y = static_cast<int>(
-                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle - ao ) );
-            apply_light_ray( lit, p, end, luminance );
-        } else {
-            calc_ray_end( nangle + ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
-            calc_ray_end( nangle - ao, range, p, end );
-            apply_light_ray( lit, p, end, luminance );
-        }
-    }
-}
-
-void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
-                           const tripoint &s, const tripoint &e, float luminance )
+static void cast_light_ray( lightmap_quadrants &lm,
+                            const float ( &transparency_cache )[MAPSIZE_X][MAPSIZE_Y],
+                            bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
+                            const tripoint &s, const tripoint &e, float luminance )
 {
     point a( std::abs( e.x - s.x ) * 2, std::abs( e.y - s.y ) * 2 );
     point d( ( s.x < e.x ) ? 1 : -1, ( s.y < e.y ) ? 1 : -1 );
@@ -1940,9 +1990,6 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
         return;
     }
 
-    auto &lm = get_cache( s.z ).lm;
-    auto &transparency_cache = get_cache( s.z ).transparency_cache;
-
     float distance = 1.0;
     float transparency = LIGHT_TRANSPARENCY_OPEN_AIR;
     const float scaling_factor = static_cast<float>( rl_dist( s, e ) ) /
@@ -2015,3 +2062,142 @@ void map::apply_light_ray( bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y],
         } while( !( p.x == e.x && p.y == e.y ) );
     }
 }
+
+static void cast_light_arc( lightmap_quadrants &lm, lightmap_floats &sm,
+                            const level_cache &cache, const deferred_light &light )
+{
+    const tripoint &p = light.p;
+    const float luminance = light.luminance;
+    if( luminance <= LIGHT_SOURCE_LOCAL ) {
+        return;
+    }
+
+    bool lit[LIGHTMAP_CACHE_X][LIGHTMAP_CACHE_Y] {};
+
+    // Too dim to need the light source buffer, it only lights its own tile.
+    deferred_light local;
+    local.p = p;
+    local.luminance = LIGHT_SOURCE_LOCAL;
+    local.in_bounds = light.in_bounds;
+    cast_light_source( lm, sm, cache, local );
+
+    // Normalize (should work with negative values too)
+    const units::angle wangle = light.wideangle / 2.0;
+
+    units::angle nangle = fmod( light.angle, 360_degrees );
+
+    tripoint end;
+    int range = LIGHT_RANGE( luminance );
+    calc_ray_end( nangle, range, p, end );
+    cast_light_ray( lm, cache.transparency_cache, lit, p, end, luminance );
+
+    tripoint test;
+    calc_ray_end( wangle + nangle, range, p, test );
+
+    const float wdist = hypot( end.x - test.x, end.y - test.y );
+    if( wdist <= 0.5 ) {
+        return;
+    }
+
+    // attempt to determine beam intensity required to cover all squares
+    const units::angle wstep = ( wangle / ( wdist * M_SQRT2 ) );
+
+    // NOLINTNEXTLINE(clang-analyzer-security.FloatLoopCounter)
+    for( units::angle ao = wstep; ao <= wangle; ao += wstep ) {
+        if( trigdist ) {
+            double fdist = ( ao * M_PI_2 ) / wangle;
+            end.x = static_cast<int>(
+                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle + ao ) );
+            end.y = static_cast<int>(
+                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle + ao ) );
+            cast_light_ray( lm, cache.transparency_cache, lit, p, end, luminance );
+
+            end.x = static_cast<int>(
+                        p.x + ( static_cast<double>( range ) - fdist * 2.0 ) * cos( nangle - ao ) );
+            end.y = static_cast<int>(
+                        p.y + ( static_cast<double>( range ) - fdist * 2.0 ) * sin( nangle - ao ) );
+            cast_light_ray( lm, cache.transparency_cache, lit, p, end, luminance );
+        } else {
+            calc_ray_end( nangle + ao, range, p, end );
+            cast_light_ray( lm, cache.transparency_cache, lit, p, end, luminance );
+            calc_ray_end( nangle - ao, range, p, end );
+            cast_light_ray( lm, cache.transparency_cache, lit, p, end, luminance );
+        }
+    }
+}
+
+static deferred_light prepare_light_arc( const bool in_bounds, const tripoint &p,
+        const units::angle angle, const float luminance, const units::angle wideangle )
+{
+    deferred_light light;
+    light.type = deferred_light::shape::arc;
+    light.p = p;
+    light.luminance = luminance;
+    light.in_bounds = in_bounds;
+    light.angle = angle;
+    light.wideangle = wideangle;
+    return light;
+}
+
+void map::apply_light_arc( const tripoint &p, units::angle angle, float luminance,
+                           units::angle wideangle )
+{
+    auto &cache = get_cache( p.z );
+    cast_light_arc( cache.lm, cache.sm, cache,
+                    prepare_light_arc( inbounds( p ), p, angle, luminance, wideangle ) );
+}
+
+static void cast_deferred_light( lightmap_quadrants &lm, lightmap_floats &sm,
+                                 const level_cache &cache, const deferred_light &light )
+{
+    switch( light.type ) {
+        case deferred_light::shape::source:
+            cast_light_source( lm, sm, cache, light );
+            return;
+        case deferred_light::shape::arc:
+            cast_light_arc( lm, sm, cache, light );
+            return;
+    }
+    cata::unreachable();
+}
+
+static void apply_deferred_lights( level_cache &map_cache,
+                                   const std::vector<deferred_light> &lights )
+{
+    if( !parallel_lightmap || lights.size() < 2 ) {
+        for( const deferred_light &light : lights ) {
+            cast_deferred_light( map_cache.lm, map_cache.sm, map_cache, light );
+        }
+        return;
+    }
+
+    thread_pool &pool = get_thread_pool();
+    const size_t num_shards = std::min( pool.concurrency(), lights.size() );
+    // Kept between calls, generate_lightmap only ever runs on the main thread.
+    static std::vector<std::unique_ptr<lightmap_buffer>> shards;
+    while( shards.size() < num_shards ) {
+        shards.push_back( std::make_unique<lightmap_buffer>() );
+    }
+
+    // Lights are dealt out round-robin, so clusters of expensive lights are spread over all shards.
+    pool.parallel_for( num_shards, [&]( const size_t shard ) {
+        lightmap_buffer &out = *shards[shard];
+        std::memset( out.lm, 0, sizeof( out.lm ) );
+        std::memset( out.sm, 0, sizeof( out.sm ) );
+        for( size_t i = shard; i < lights.size(); i += num_shards ) {
+            cast_deferred_light( out.lm, out.sm, map_cache, lights[i] );
+        }
+    } );
+
+    // Merge the shards in a fixed order.  Casting only ever raises values with max(),
+    // which is exact, so this is bit-identical to casting every light into the cache directly.
+    pool.parallel_for( LIGHTMAP_CACHE_X, [&]( const size_t x ) {
+        for( size_t shard = 0; shard < num_shards; shard++ ) {
+            const lightmap_buffer &in = *shards[shard];
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; y++ ) {
+                map_cache.lm[x][y] = elementwise_max( map_cache.lm[x][y], in.lm[x][y] );
+                map_cache.sm[x][y] = std::max( map_cache.sm[x][y], in.sm[x][y] );
+            }
+        }
+    } );
+}
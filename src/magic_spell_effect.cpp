@@ -59,6 +59,8 @@
 
 static const ammo_effect_str_id ammo_effect_magic( "magic" );
 
+static const ter_furn_flag_id ter_furn_flag_THIN_OBSTACLE( "THIN_OBSTACLE" );
+
 namespace spell_detail
 {
 struct line_iterable {
@@ -174,7 +176,7 @@ static bool in_spell_aoe( const tripoint &start, const tripoint &end, const int
     const std::vector<tripoint> trajectory = line_to( start, end );
     tripoint last_point = start;
     for( const tripoint &pt : trajectory ) {
-        if( ( here.impassable( pt ) && !here.has_flag( "THIN_OBSTACLE", pt ) ) ||
+        if( ( here.impassable( pt ) && !here.has_flag( ter_furn_flag_THIN_OBSTACLE, pt ) ) ||
             here.obstructed_by_vehicle_rotation( pt, last_point ) ) {
             return false;
         }
@@ -216,7 +218,7 @@ static std::set<tripoint> spell_effect_cone_range_override( const tripoint &sour
         tripoint last_point = source;
         for( const tripoint &tp : trajectory ) {
             if( ignore_walls || ( !here.obstructed_by_vehicle_rotation( tp, last_point ) &&
-                                  ( here.passable( tp ) || here.has_flag( "THIN_OBSTACLE", tp ) ) ) ) {
+                                  ( here.passable( tp ) || here.has_flag( ter_furn_flag_THIN_OBSTACLE, tp ) ) ) ) {
                 targets.emplace( tp );
             } else {
                 break;
@@ -245,7 +247,7 @@ static bool test_passable( const tripoint &p, const tripoint &prev )
 {
     map &here = get_map();
     return ( !here.obstructed_by_vehicle_rotation( prev, p ) && ( here.passable( p ) ||
-             here.has_flag( "THIN_OBSTACLE", p ) ) );
+             here.has_flag( ter_furn_flag_THIN_OBSTACLE, p ) ) );
 }
 
 std::set<tripoint> spell_effect::spell_effect_line( const spell &, const tripoint &source,
@@ -531,7 +533,7 @@ void spell_effect::projectile_attack( const spell &sp, Creature &caster,
     tripoint prev_point = caster.pos();
     map &here = get_map();
     for( std::vector<tripoint>::iterator iter = trajectory.begin(); iter != trajectory.end(); iter++ ) {
-        if( ( here.impassable( *iter ) && !here.has_flag( "THIN_OBSTACLE", *iter ) ) ||
+        if( ( here.impassable( *iter ) && !here.has_flag( ter_furn_flag_THIN_OBSTACLE, *iter ) ) ||
             here.obstructed_by_vehicle_rotation( prev_point, *iter ) ) {
             if( iter != trajectory.begin() ) {
                 target_attack( sp, caster, *( iter - 1 ) );
@@ -620,7 +622,7 @@ int area_expander::run( const tripoint &center )
         for( size_t i = 0; i < 8; i++ ) {
             tripoint pt = best.position + point( x_offset[ i ], y_offset[ i ] );
 
-            if( ( here.impassable( pt ) && !here.has_flag( "THIN_OBSTACLE", pt ) ) ||
+            if( ( here.impassable( pt ) && !here.has_flag( ter_furn_flag_THIN_OBSTACLE, pt ) ) ||
                 here.obstructed_by_vehicle_rotation( best.position, pt ) ) {
                 continue;
             }
@@ -680,7 +682,7 @@ static void move_field( map &here, const tripoint &from, const tripoint &to )
 {
     field &src_field = here.field_at( from );
     std::map<field_type_id, int> moving_fields;
-    for( const std::pair<const field_type_id, field_entry> &fd : src_field ) {
+    for( const field::value_type &fd : src_field ) {
         if( fd.first.is_valid() && !fd.first.id().is_null() ) {
             const int intensity = fd.second.get_field_intensity();
             moving_fields.emplace( fd.first, intensity );
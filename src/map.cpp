@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cassert>
 #include <climits>
 #include <cstdlib>
@@ -19,6 +20,7 @@
 #include "artifact.h"
 #include "avatar.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "character.h"
@@ -75,6 +77,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "legacy_pathfinding.h"
+#include "pathfinding.h"
 #include "player.h"
 #include "point_float.h"
 #include "projectile.h"
@@ -86,6 +89,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "timed_event.h"
 #include "translations.h"
@@ -136,6 +140,29 @@ static const efftype_id effect_crushed( "crushed" );
 
 static const ter_str_id t_rock_floor_no_roof( "t_rock_floor_no_roof" );
 
+static const ter_furn_flag_id ter_furn_flag_ALARMED( "ALARMED" );
+static const ter_furn_flag_id ter_furn_flag_BLOCKSDOOR( "BLOCKSDOOR" );
+static const ter_furn_flag_id ter_furn_flag_CAN_SIT( "CAN_SIT" );
+static const ter_furn_flag_id ter_furn_flag_DONT_REMOVE_ROTTEN( "DONT_REMOVE_ROTTEN" );
+static const ter_furn_flag_id ter_furn_flag_EASY_DECONSTRUCT( "EASY_DECONSTRUCT" );
+static const ter_furn_flag_id ter_furn_flag_EMITTER( "EMITTER" );
+static const ter_furn_flag_id ter_furn_flag_FLAT_SURF( "FLAT_SURF" );
+static const ter_furn_flag_id ter_furn_flag_GROWTH_HARVEST( "GROWTH_HARVEST" );
+static const ter_furn_flag_id ter_furn_flag_GROWTH_MATURE( "GROWTH_MATURE" );
+static const ter_furn_flag_id ter_furn_flag_GROWTH_SEEDLING( "GROWTH_SEEDLING" );
+static const ter_furn_flag_id ter_furn_flag_LADDER( "LADDER" );
+static const ter_furn_flag_id ter_furn_flag_LIQUIDCONT( "LIQUIDCONT" );
+static const ter_furn_flag_id ter_furn_flag_MIGO_NERVE( "MIGO_NERVE" );
+static const ter_furn_flag_id ter_furn_flag_MOUNTABLE( "MOUNTABLE" );
+static const ter_furn_flag_id ter_furn_flag_NOCOLLIDE( "NOCOLLIDE" );
+static const ter_furn_flag_id ter_furn_flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+static const ter_furn_flag_id ter_furn_flag_PLOWABLE( "PLOWABLE" );
+static const ter_furn_flag_id ter_furn_flag_ROOF( "ROOF" );
+static const ter_furn_flag_id ter_furn_flag_SALT_WATER( "SALT_WATER" );
+static const ter_furn_flag_id ter_furn_flag_TINY( "TINY" );
+static const ter_furn_flag_id ter_furn_flag_USABLE_FIRE( "USABLE_FIRE" );
+static const ter_furn_flag_id ter_furn_flag_VEH_TREAT_AS_BASH_BELOW( "VEH_TREAT_AS_BASH_BELOW" );
+
 // Conversion constant for 100ths of miles per hour to meters per second
 constexpr float velocity_constant = 0.0044704;
 
@@ -354,6 +381,7 @@ void map::add_vehicle_to_cache( vehicle *veh )
         ch.veh_cached_parts[p] = std::make_pair( veh,  static_cast<int>( vpr.part_index() ) );
         if( inbounds( p ) ) {
             ch.veh_exists_at[p.x][p.y] = true;
+            set_pathfinding_cache_dirty( p );
         }
     }
 
@@ -370,6 +398,7 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint &pt )
     level_cache &ch = get_cache( pt.z );
     if( inbounds( pt ) ) {
         ch.veh_exists_at[pt.x][pt.y] = false;
+        set_pathfinding_cache_dirty( pt );
     }
     auto it = ch.veh_cached_parts.find( pt );
     if( it != ch.veh_cached_parts.end() && it->second.first == veh ) {
@@ -808,7 +837,7 @@ vehicle *map::move_vehicle( vehicle &veh, const tripoint &dp, const tileray &fac
             }
 
             veh.handle_trap( wheel_p, w );
-            if( !has_flag( "SEALED", wheel_p ) ) {
+            if( !has_flag( TFLAG_SEALED, wheel_p ) ) {
                 const float wheel_area =  veh.part( w ).wheel_area();
 
                 // Damage is calculated based on the weight of the vehicle,
@@ -1383,7 +1412,7 @@ bool map::displace_vehicle( vehicle &veh, const tripoint &dp )
 bool map::displace_water( const tripoint &p )
 {
     // Check for shallow water
-    if( has_flag( "SWIMMABLE", p ) && !has_flag( TFLAG_DEEP_WATER, p ) ) {
+    if( has_flag( TFLAG_SWIMMABLE, p ) && !has_flag( TFLAG_DEEP_WATER, p ) ) {
         int dis_places = 0;
         int sel_place = 0;
         for( int pass = 0; pass < 2; pass++ ) {
@@ -1494,7 +1523,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
             c->remove_effect( effect_crushed );
         }
     }
-    if( new_t.has_flag( "EMITTER" ) ) {
+    if( new_t.has_flag( ter_furn_flag_EMITTER ) ) {
         field_furn_locs.push_back( p );
     }
     if( old_t.transparent != new_t.transparent ) {
@@ -1520,7 +1549,7 @@ void map::furn_set( const tripoint &p, const furn_id &new_furniture,
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     // Make sure the furniture falls if it needs to
     support_dirty( p );
@@ -1573,7 +1602,7 @@ bool map::can_move_furniture( const tripoint &pos, player *p )
 std::string map::furnname( const tripoint &p )
 {
     const furn_t &f = furn( p ).obj();
-    if( f.has_flag( "PLANT" ) ) {
+    if( f.has_flag( TFLAG_PLANT ) ) {
         // Can't use item_stack::only_item() since there might be fertilizer
         map_stack items = i_at( p );
         const map_stack::iterator seed = std::ranges::find_if( items,
@@ -1855,7 +1884,7 @@ bool map::ter_set( const tripoint &p, const ter_id &new_terrain )
     set_memory_seen_cache_dirty( p );
 
     // TODO: Limit to changes that affect move cost, traps and stairs
-    set_pathfinding_cache_dirty( p.z );
+    set_pathfinding_cache_dirty( p );
 
     tripoint above( p.xy(), p.z + 1 );
     // Make sure that if we supported something and no longer do so, it falls down
@@ -1887,15 +1916,15 @@ std::string map::features( const tripoint &p )
     // to take up one line.  So, make sure it does that.
     // FIXME: can't control length of localized text.
     add_if( is_bashable( p ), _( "Smashable." ) );
-    add_if( has_flag( "DIGGABLE", p ), _( "Diggable." ) );
-    add_if( has_flag( "PLOWABLE", p ), _( "Plowable." ) );
-    add_if( has_flag( "ROUGH", p ), _( "Rough." ) );
-    add_if( has_flag( "UNSTABLE", p ), _( "Unstable." ) );
-    add_if( has_flag( "SHARP", p ), _( "Sharp." ) );
-    add_if( has_flag( "FLAT", p ), _( "Flat." ) );
-    add_if( has_flag( "ROOF", p ), _( "Roof." ) );
-    add_if( has_flag( "EASY_DECONSTRUCT", p ), _( "Simple." ) );
-    add_if( has_flag( "MOUNTABLE", p ), _( "Mountable." ) );
+    add_if( has_flag( TFLAG_DIGGABLE, p ), _( "Diggable." ) );
+    add_if( has_flag( ter_furn_flag_PLOWABLE, p ), _( "Plowable." ) );
+    add_if( has_flag( TFLAG_ROUGH, p ), _( "Rough." ) );
+    add_if( has_flag( TFLAG_UNSTABLE, p ), _( "Unstable." ) );
+    add_if( has_flag( TFLAG_SHARP, p ), _( "Sharp." ) );
+    add_if( has_flag( TFLAG_FLAT, p ), _( "Flat." ) );
+    add_if( has_flag( ter_furn_flag_ROOF, p ), _( "Roof." ) );
+    add_if( has_flag( ter_furn_flag_EASY_DECONSTRUCT, p ), _( "Simple." ) );
+    add_if( has_flag( ter_furn_flag_MOUNTABLE, p ), _( "Mountable." ) );
     return result;
 }
 
@@ -2134,7 +2163,7 @@ int map::climb_difficulty( const tripoint &p ) const
 
     int best_difficulty = INT_MAX;
     int blocks_movement = 0;
-    if( has_flag( "LADDER", p ) ) {
+    if( has_flag( ter_furn_flag_LADDER, p ) ) {
         // Really easy, but you have to stand on the tile
         return 1;
     } else if( has_flag( TFLAG_RAMP, p ) || has_flag( TFLAG_RAMP_UP, p ) ||
@@ -2154,7 +2183,7 @@ int map::climb_difficulty( const tripoint &p ) const
             best_difficulty = std::min( best_difficulty, 7 );
         }
 
-        if( best_difficulty > 5 && has_flag( "CLIMBABLE", pt ) ) {
+        if( best_difficulty > 5 && has_flag( TFLAG_CLIMBABLE, pt ) ) {
             best_difficulty = 5;
         }
     }
@@ -2221,7 +2250,7 @@ bool map::has_floor_or_support( const tripoint &p ) const
 void map::drop_everything( const tripoint &p )
 {
     //Do a suspension check so that there won't be a floor there for the rest of this check.
-    if( has_flag( "SUSPENDED", p ) ) {
+    if( has_flag( TFLAG_SUSPENDED, p ) ) {
         collapse_invalid_suspension( p );
     }
     if( has_floor( p ) ) {
@@ -2268,7 +2297,7 @@ void map::drop_furniture( const tripoint &p )
         if( frn_id != f_null ) {
             const furn_t &frn = frn_id.obj();
             // Allow crushing tiny/nocollide furniture
-            if( !frn.has_flag( "TINY" ) && !frn.has_flag( "NOCOLLIDE" ) ) {
+            if( !frn.has_flag( ter_furn_flag_TINY ) && !frn.has_flag( ter_furn_flag_NOCOLLIDE ) ) {
                 return SS_BAD_SUPPORT;
             }
         }
@@ -2312,13 +2341,13 @@ void map::drop_furniture( const tripoint &p )
 
     // Approximate weight/"bulkiness" based on strength to drag
     int weight;
-    if( frn_obj.has_flag( "TINY" ) || frn_obj.has_flag( "NOCOLLIDE" ) ) {
+    if( frn_obj.has_flag( ter_furn_flag_TINY ) || frn_obj.has_flag( ter_furn_flag_NOCOLLIDE ) ) {
         weight = 5;
     } else {
         weight = frn_obj.is_movable() ? frn_obj.move_str_req : 20;
     }
 
-    if( frn_obj.has_flag( "ROUGH" ) || frn_obj.has_flag( "SHARP" ) ) {
+    if( frn_obj.has_flag( TFLAG_ROUGH ) || frn_obj.has_flag( TFLAG_SHARP ) ) {
         weight += 5;
     }
 
@@ -2479,20 +2508,40 @@ bool map::can_put_items( const tripoint &p ) const
 
 bool map::can_put_items_ter_furn( const tripoint &p ) const
 {
-    return !has_flag( "NOITEM", p ) && !has_flag( "SEALED", p );
+    return !has_flag( TFLAG_NOITEM, p ) && !has_flag( TFLAG_SEALED, p );
 }
 
 bool map::has_flag_ter( const std::string &flag, const tripoint &p ) const
 {
-    return ter( p ).obj().has_flag( flag );
+    return has_flag_ter( ter_furn_flag_id::find( flag ), p );
 }
 
 bool map::has_flag_furn( const std::string &flag, const tripoint &p ) const
 {
-    return furn( p ).obj().has_flag( flag );
+    return has_flag_furn( ter_furn_flag_id::find( flag ), p );
 }
 
 bool map::has_flag_ter_or_furn( const std::string &flag, const tripoint &p ) const
+{
+    return has_flag_ter_or_furn( ter_furn_flag_id::find( flag ), p );
+}
+
+bool map::has_flag( const ter_furn_flag_id &flag, const tripoint &p ) const
+{
+    return has_flag_ter_or_furn( flag, p ); // Does bound checking
+}
+
+bool map::has_flag_ter( const ter_furn_flag_id &flag, const tripoint &p ) const
+{
+    return ter( p ).obj().has_flag( flag );
+}
+
+bool map::has_flag_furn( const ter_furn_flag_id &flag, const tripoint &p ) const
+{
+    return furn( p ).obj().has_flag( flag );
+}
+
+bool map::has_flag_ter_or_furn( const ter_furn_flag_id &flag, const tripoint &p ) const
 {
     if( !inbounds( p ) ) {
         return false;
@@ -2616,9 +2665,10 @@ bool map::is_bashable( const tripoint &p, const bool allow_floor ) const
 
 bool map::is_bashable_ter( const tripoint &p, const bool allow_floor ) const
 {
-    const auto &ter_bash = ter( p ).obj().bash;
-    return ter_bash.str_max != -1 && ( ( !ter_bash.bash_below &&
-                                         !ter( p ).obj().has_flag( "VEH_TREAT_AS_BASH_BELOW" ) ) || allow_floor );
+    const ter_t &terrain = ter( p ).obj();
+    const bool floor = terrain.bash.bash_below ||
+                       terrain.has_flag( ter_furn_flag_VEH_TREAT_AS_BASH_BELOW );
+    return terrain.bash.str_max != -1 && ( !floor || allow_floor );
 }
 
 bool map::is_bashable_furn( const tripoint &p ) const
@@ -2706,12 +2756,12 @@ void map::make_rubble( const tripoint &p, const furn_id &rubble_type,
 
 bool map::is_water_shallow_current( const tripoint &p ) const
 {
-    return has_flag( "CURRENT", p ) && !has_flag( TFLAG_DEEP_WATER, p );
+    return has_flag( TFLAG_CURRENT, p ) && !has_flag( TFLAG_DEEP_WATER, p );
 }
 
 bool map::is_divable( const tripoint &p ) const
 {
-    return has_flag( "SWIMMABLE", p ) && has_flag( TFLAG_DEEP_WATER, p );
+    return has_flag( TFLAG_SWIMMABLE, p ) && has_flag( TFLAG_DEEP_WATER, p );
 }
 
 bool map::is_outside( const tripoint &p ) const
@@ -2754,9 +2804,9 @@ bool map::is_last_ter_wall( const bool no_furn, point p,
         if( no_furn && has_furn( p2 ) ) {
             loop = false;
             result = false;
-        } else if( !has_flag_ter( "FLAT", p2 ) ) {
+        } else if( !has_flag_ter( TFLAG_FLAT, p2 ) ) {
             loop = false;
-            if( !has_flag_ter( "WALL", p2 ) ) {
+            if( !has_flag_ter( TFLAG_WALL, p2 ) ) {
                 result = false;
             }
         }
@@ -2799,11 +2849,11 @@ bool map::is_flammable( const tripoint &p )
         return true;
     }
 
-    if( has_flag( "FLAMMABLE", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE, p ) ) {
         return true;
     }
 
-    if( has_flag( "FLAMMABLE_ASH", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE_ASH, p ) ) {
         return true;
     }
 
@@ -2841,31 +2891,30 @@ void map::decay_fields_and_scent( const time_duration &amount )
                 continue;
             }
 
-            for( int sx = 0; sx < SEEX; ++sx ) {
-                if( to_proc < 1 ) {
-                    // This submap had some fields, but all got proc'd already
-                    break;
+            const std::bitset<SEEX * SEEY> &field_tiles = cur_submap->get_field_tiles();
+            for( size_t tile = 0; tile < field_tiles.size() && to_proc > 0; ++tile ) {
+                if( !field_tiles[tile] ) {
+                    continue;
+                }
+                const int sx = static_cast<int>( tile / SEEY );
+                const int sy = static_cast<int>( tile % SEEY );
+                const int x = sx + smx * SEEX;
+                const int y = sy + smy * SEEY;
+
+                field &fields = cur_submap->get_field( { sx, sy} );
+                if( !outside_cache[x][y] ) {
+                    to_proc -= fields.field_count();
+                    continue;
                 }
 
-                for( int sy = 0; sy < SEEY; ++sy ) {
-                    const int x = sx + smx * SEEX;
-                    const int y = sy + smy * SEEY;
-
-                    field &fields = cur_submap->get_field( { sx, sy} );
-                    if( !outside_cache[x][y] ) {
-                        to_proc -= fields.field_count();
-                        continue;
-                    }
-
-                    for( auto &fp : fields ) {
-                        to_proc--;
-                        field_entry &cur = fp.second;
-                        const field_type_id type = cur.get_field_type();
-                        const int decay_amount_factor =  type.obj().decay_amount_factor;
-                        if( decay_amount_factor != 0 ) {
-                            const time_duration decay_amount = amount / decay_amount_factor;
-                            cur.set_field_age( cur.get_field_age() + decay_amount );
-                        }
+                for( auto &fp : fields ) {
+                    to_proc--;
+                    field_entry &cur = fp.second;
+                    const field_type_id type = cur.get_field_type();
+                    const int decay_amount_factor =  type.obj().decay_amount_factor;
+                    if( decay_amount_factor != 0 ) {
+                        const time_duration decay_amount = amount / decay_amount_factor;
+                        cur.set_field_age( cur.get_field_age() + decay_amount );
                     }
                 }
             }
@@ -2910,7 +2959,7 @@ bool map::has_nearby_fire( const tripoint &p, int radius )
         if( get_field( pt, fd_fire ) != nullptr ) {
             return true;
         }
-        if( has_flag_ter_or_furn( "USABLE_FIRE", pt ) ) {
+        if( has_flag_ter_or_furn( ter_furn_flag_USABLE_FIRE, pt ) ) {
             return true;
         }
     }
@@ -2921,7 +2970,7 @@ bool map::has_nearby_table( const tripoint &p, int radius )
 {
     for( const tripoint &pt : points_in_radius( p, radius ) ) {
         const optional_vpart_position vp = veh_at( p );
-        if( has_flag( "FLAT_SURF", pt ) ) {
+        if( has_flag( ter_furn_flag_FLAT_SURF, pt ) ) {
             return true;
         }
         if( vp && ( vp->vehicle().has_part( "KITCHEN" ) || vp->vehicle().has_part( "FLAT_SURF" ) ) ) {
@@ -2935,7 +2984,7 @@ bool map::has_nearby_chair( const tripoint &p, int radius )
 {
     for( const tripoint &pt : points_in_radius( p, radius ) ) {
         const optional_vpart_position vp = veh_at( pt );
-        if( has_flag( "CAN_SIT", pt ) ) {
+        if( has_flag( ter_furn_flag_CAN_SIT, pt ) ) {
             return true;
         }
         if( vp && vp->vehicle().has_part( "SEAT" ) ) {
@@ -2949,7 +2998,7 @@ bool map::mop_spills( const tripoint &p )
 {
     bool retval = false;
 
-    if( !has_flag( "LIQUIDCONT", p ) && !has_flag( "SEALED", p ) ) {
+    if( !has_flag( ter_furn_flag_LIQUIDCONT, p ) && !has_flag( TFLAG_SEALED, p ) ) {
         auto items = i_at( p );
 
         items.remove_top_items_with( [&retval]( detached_ptr<item> &&e ) {
@@ -3331,7 +3380,7 @@ static bool furn_is_supported( const map &m, const tripoint &p )
     for( int i = 0; i < 4; i++ ) {
         const point adj( p.xy() + point( cx[i], cy[i] ) );
         if( m.has_furn( tripoint( adj, p.z ) ) &&
-            m.furn( tripoint( adj, p.z ) ).obj().has_flag( "BLOCKSDOOR" ) ) {
+            m.furn( tripoint( adj, p.z ) ).obj().has_flag( ter_furn_flag_BLOCKSDOOR ) ) {
             return true;
         }
     }
@@ -3353,7 +3402,7 @@ bash_results map::bash_ter_success( const tripoint &p, const bash_params &params
     result.success = true;
     const ter_t &ter_before = ter( p ).obj();
     const map_bash_info &bash = ter_before.bash;
-    if( has_flag_ter( "FUNGUS", p ) ) {
+    if( has_flag_ter( TFLAG_FUNGUS, p ) ) {
         fungal_effects( *g, *this ).create_spores( p );
     }
     const std::string soundfxvariant = ter_before.id.str();
@@ -3484,10 +3533,10 @@ bash_results map::bash_furn_success( const tripoint &p, const bash_params &param
     const map_bash_info &bash = furnid.bash;
 
 
-    if( has_flag_furn( "FUNGUS", p ) ) {
+    if( has_flag_furn( TFLAG_FUNGUS, p ) ) {
         fungal_effects( *g, *this ).create_spores( p );
     }
-    if( has_flag_furn( "MIGO_NERVE", p ) ) {
+    if( has_flag_furn( ter_furn_flag_MIGO_NERVE, p ) ) {
         map_funcs::migo_nerve_cage_removal( *this, p, true );
     }
     std::string soundfxvariant = furnid.id.str();
@@ -3619,7 +3668,7 @@ bash_results map::bash_ter_furn( const tripoint &p, const bash_params &params )
     }
 
     // TODO: what if silent is true?
-    if( has_flag( "ALARMED", p ) && !g->timed_events.queued( TIMED_EVENT_WANTED ) ) {
+    if( has_flag( ter_furn_flag_ALARMED, p ) && !g->timed_events.queued( TIMED_EVENT_WANTED ) ) {
         sounds::sound( p, 40, sounds::sound_t::alarm, _( "an alarm go off!" ),
                        false, "environment", "alarm" );
         // Blame nearby player
@@ -3714,7 +3763,7 @@ bash_results map::bash( const tripoint &p, const int str,
     }
 
     bool bashed_sealed = false;
-    if( has_flag( "SEALED", p ) ) {
+    if( has_flag( TFLAG_SEALED, p ) ) {
         result |= bash_ter_furn( p, bsh );
         bashed_sealed = true;
     }
@@ -3916,7 +3965,7 @@ void map::shoot( const tripoint &origin, const tripoint &p, projectile &proj, co
 
     float dam = initial_damage;
 
-    if( has_flag( "ALARMED", p ) && !g->timed_events.queued( TIMED_EVENT_WANTED ) ) {
+    if( has_flag( ter_furn_flag_ALARMED, p ) && !g->timed_events.queued( TIMED_EVENT_WANTED ) ) {
         sounds::sound( p, 30, sounds::sound_t::alarm, _( "an alarm sound!" ), true, "environment",
                        "alarm" );
         const tripoint abs = ms_to_sm_copy( getabs( p ) );
@@ -4101,7 +4150,7 @@ bool map::hit_with_fire( const tripoint &p )
     }
 
     // non passable but flammable terrain, set it on fire
-    if( has_flag( "FLAMMABLE", p ) || has_flag( "FLAMMABLE_ASH", p ) ) {
+    if( has_flag( TFLAG_FLAMMABLE, p ) || has_flag( TFLAG_FLAMMABLE_ASH, p ) ) {
         add_field( p, fd_fire, 3 );
     }
     return true;
@@ -4114,7 +4163,7 @@ bool map::open_door( const tripoint &p, const bool inside, const bool check_only
     const auto &furn = this->furn( p ).obj();
 
     if( ter.open ) {
-        if( has_flag( "OPENCLOSE_INSIDE", p ) && !inside ) {
+        if( has_flag( ter_furn_flag_OPENCLOSE_INSIDE, p ) && !inside ) {
             return false;
         }
         if( you.is_mounted() ) {
@@ -4130,7 +4179,7 @@ bool map::open_door( const tripoint &p, const bool inside, const bool check_only
             ter_set( p, ter.open );
 
             if( ( you.has_trait( trait_id( "SCHIZOPHRENIC" ) ) || you.has_artifact_with( AEP_SCHIZO ) )
-                && one_in( 50 ) && !ter.has_flag( "TRANSPARENT" ) ) {
+                && one_in( 50 ) && !ter.has_flag( TFLAG_TRANSPARENT ) ) {
                 tripoint mp = p + -2 * you.pos().xy() + tripoint( 2 * p.x, 2 * p.y, p.z );
                 g->spawn_hallucination( mp );
             }
@@ -4138,7 +4187,7 @@ bool map::open_door( const tripoint &p, const bool inside, const bool check_only
 
         return true;
     } else if( furn.open ) {
-        if( has_flag( "OPENCLOSE_INSIDE", p ) && !inside ) {
+        if( has_flag( ter_furn_flag_OPENCLOSE_INSIDE, p ) && !inside ) {
             return false;
         }
         if( you.is_mounted() ) {
@@ -4225,7 +4274,7 @@ void map::translate_radius( const ter_id &from, const ter_id &to, float radi, co
 
 bool map::close_door( const tripoint &p, const bool inside, const bool check_only )
 {
-    if( has_flag( "OPENCLOSE_INSIDE", p ) && !inside ) {
+    if( has_flag( ter_furn_flag_OPENCLOSE_INSIDE, p ) && !inside ) {
         return false;
     }
 
@@ -4412,8 +4461,8 @@ detached_ptr<item> map::spawn_an_item( const tripoint &p, detached_ptr<item> &&n
         new_item->charges = charges;
     }
     detached_ptr<item> spawned_item = item::in_its_container( std::move( new_item ) );
-    if( ( spawned_item->made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) ||
-        has_flag( "DESTROY_ITEM", p ) ) {
+    if( ( spawned_item->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, p ) ) ||
+        has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return detached_ptr<item>();
     }
 
@@ -4426,10 +4475,10 @@ std::vector<detached_ptr<item>> map::spawn_items( const tripoint &p,
                              std::vector<detached_ptr<item>> new_items )
 {
     std::vector<detached_ptr<item>> ret;
-    if( !inbounds( p ) || has_flag( "DESTROY_ITEM", p ) ) {
+    if( !inbounds( p ) || has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return ret;
     }
-    const bool swimmable = has_flag( "SWIMMABLE", p );
+    const bool swimmable = has_flag( TFLAG_SWIMMABLE, p );
     for( detached_ptr<item> &new_item : new_items ) {
         if( new_item->made_of( LIQUID ) && swimmable ) {
             continue;
@@ -4511,12 +4560,12 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
         }
 
         // Some tiles destroy items (e.g. lava)
-        if( has_flag( "DESTROY_ITEM", e ) ) {
+        if( has_flag( TFLAG_DESTROY_ITEM, e ) ) {
             return false;
         }
 
         // Cannot drop liquids into tiles that are comprised of liquid
-        if( obj->made_of( LIQUID ) && has_flag( "SWIMMABLE", e ) ) {
+        if( obj->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, e ) ) {
             return false;
         }
 
@@ -4553,8 +4602,9 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
         return std::move( obj );
     }
 
-    if( ( !has_flag( "NOITEM", pos ) || ( has_flag( "LIQUIDCONT", pos ) && obj->made_of( LIQUID ) ) )
-        && valid_limits( pos ) ) {
+    if( ( !has_flag( TFLAG_NOITEM, pos ) ||
+          ( has_flag( ter_furn_flag_LIQUIDCONT, pos ) && obj->made_of( LIQUID ) ) ) &&
+        valid_limits( pos ) ) {
         // Pass map into on_drop, because this map may not be the global map object (in mapgen, for instance).
         if( obj->made_of( LIQUID ) || !obj->has_flag( flag_DROP_ACTION_ONLY_IF_LIQUID ) ) {
             if( obj->on_drop( pos, *this ) ) {
@@ -4589,7 +4639,7 @@ detached_ptr<item> map::add_item_or_charges( const tripoint &pos, detached_ptr<i
             }
 
             if( !valid_tile( e ) || !valid_limits( e ) ||
-                has_flag( "NOITEM", e ) || has_flag( "SEALED", e ) ) {
+                has_flag( TFLAG_NOITEM, e ) || has_flag( TFLAG_SEALED, e ) ) {
                 continue;
             }
             place_item( e );
@@ -4618,11 +4668,11 @@ void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
         }
     }
 
-    if( new_item->made_of( LIQUID ) && has_flag( "SWIMMABLE", p ) ) {
+    if( new_item->made_of( LIQUID ) && has_flag( TFLAG_SWIMMABLE, p ) ) {
         return;
     }
 
-    if( has_flag( "DESTROY_ITEM", p ) ) {
+    if( has_flag( TFLAG_DESTROY_ITEM, p ) ) {
         return;
     }
 
@@ -4656,7 +4706,7 @@ void map::add_item( const tripoint &p, detached_ptr<item> &&new_item )
 
 detached_ptr<item> map::water_from( const tripoint &p )
 {
-    if( has_flag( "SALT_WATER", p ) ) {
+    if( has_flag( ter_furn_flag_SALT_WATER, p ) ) {
         return item::spawn( "salt_water", calendar::start_of_cataclysm, item::INFINITE_CHARGES );
     }
 
@@ -4841,20 +4891,23 @@ void map::process_items()
     const int maxz = zlevels ? OVERMAP_HEIGHT : abs_sub.z;
     for( int gz = minz; gz <= maxz; ++gz ) {
         level_cache &cache = access_cache( gz );
-        std::set<tripoint> submaps_with_vehicles;
+        submaps_to_process.clear();
         for( vehicle *this_vehicle : cache.vehicle_list ) {
             tripoint pos = this_vehicle->global_pos3();
-            submaps_with_vehicles.emplace( pos.x / SEEX, pos.y / SEEY, pos.z );
+            submaps_to_process.emplace_back( pos.x / SEEX, pos.y / SEEY, pos.z );
         }
-        for( const tripoint &pos : submaps_with_vehicles ) {
+        std::sort( submaps_to_process.begin(), submaps_to_process.end() );
+        submaps_to_process.erase( std::unique( submaps_to_process.begin(), submaps_to_process.end() ),
+                                  submaps_to_process.end() );
+        for( const tripoint &pos : submaps_to_process ) {
             submap *const current_submap = get_submap_at_grid( pos );
             // Vehicles first in case they get blown up and drop active items on the map.
             process_items_in_vehicles( *current_submap );
         }
     }
-    // Making a copy, in case the original variable gets modified during `process_items_in_submap`
-    const std::set<tripoint> submaps_with_active_items_copy = submaps_with_active_items;
-    for( const tripoint &abs_pos : submaps_with_active_items_copy ) {
+    // Not iterating the set itself, in case it gets modified during `process_items_in_submap`
+    submaps_to_process.assign( submaps_with_active_items.begin(), submaps_with_active_items.end() );
+    for( const tripoint &abs_pos : submaps_to_process ) {
         const tripoint local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
         if( !current_submap->active_items.empty() ) {
@@ -4880,12 +4933,12 @@ static temperature_flag temperature_flag_at_point( const map &m, const tripoint
 
 void map::process_items_in_submap( submap &current_submap, const tripoint &gridp )
 {
-    // Get a COPY of the active item list for this submap.
-    // If more are added as a side effect of processing, they are ignored this turn.
+    // The items due this turn. If more are added as a side effect of processing,
+    // they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
-    std::vector<item *> active_items = current_submap.active_items.get_for_processing();
+    const std::vector<item *> &active_items = current_submap.active_items.get_for_processing();
     const point grid_offset( gridp.x * SEEX, gridp.y * SEEY );
-    for( item *&active_item_ref : active_items ) {
+    for( item *active_item_ref : active_items ) {
         if( !active_item_ref || !active_item_ref->is_loaded() ) {
             // The item was destroyed, so skip it.
             continue;
@@ -5123,7 +5176,7 @@ static void use_charges_from_furn( const furn_t &f, const itype_id &type, int &q
                                    map *m, const tripoint &p, std::vector<detached_ptr<item>> &ret,
                                    const std::function<bool( const item & )> &filter )
 {
-    if( m->has_flag( "LIQUIDCONT", p ) ) {
+    if( m->has_flag( ter_furn_flag_LIQUIDCONT, p ) ) {
         auto item_list = m->i_at( p );
         auto current_item = item_list.begin();
         for( ; current_item != item_list.end(); ++current_item ) {
@@ -5504,6 +5557,7 @@ void map::trap_set( const tripoint &p, const trap_id &type )
     if( type != tr_null ) {
         traplocs[type.to_i()].push_back( p );
     }
+    set_pathfinding_cache_dirty( p );
 }
 
 void map::disarm_trap( const tripoint &p )
@@ -5585,6 +5639,7 @@ void map::remove_trap( const tripoint &p )
         if( iter != traps.end() ) {
             traps.erase( iter );
         }
+        set_pathfinding_cache_dirty( p );
     }
 }
 /*
@@ -5729,6 +5784,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     current_submap->is_uniform = false;
     invalidate_max_populated_zlev( p.z );
 
+    current_submap->set_field_tile( l );
     if( current_submap->get_field( l ).add_field( type_id, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -5752,7 +5808,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     }
 
     if( fd_type.is_dangerous() ) {
-        set_pathfinding_cache_dirty( p.z );
+        set_pathfinding_cache_dirty( p );
     }
 
     // Ensure blood type fields don't hang in the air
@@ -5763,7 +5819,7 @@ bool map::add_field( const tripoint &p, const field_type_id &type_id, int intens
     return true;
 }
 
-void map::remove_field( const tripoint &p, const field_type_id &field_to_remove )
+void map::remove_field( const tripoint &p, const field_type_id field_to_remove )
 {
     if( !inbounds( p ) ) {
         return;
@@ -5784,7 +5840,7 @@ void map::remove_field( const tripoint &p, const field_type_id &field_to_remove
             set_seen_cache_dirty( p );
         }
         if( fdata.is_dangerous() ) {
-            set_pathfinding_cache_dirty( p.z );
+            set_pathfinding_cache_dirty( p );
         }
     }
 }
@@ -6456,7 +6512,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
             last_point = new_point;
             return true;
         } );
-        skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+        skew_vision_cache.insert( key, visible ? 1 : 0 );
         return visible;
     }
 
@@ -6489,7 +6545,7 @@ bool map::sees( const tripoint &F, const tripoint &T, const int range,
         last_point = new_point;
         return true;
     } );
-    skew_vision_cache.insert( 100000, key, visible ? 1 : 0 );
+    skew_vision_cache.insert( key, visible ? 1 : 0 );
     return visible;
 }
 
@@ -6834,7 +6890,7 @@ bool map::obscured_by_vehicle_rotation( const tripoint &from, const tripoint &to
 
 bool map::accessible_items( const tripoint &t ) const
 {
-    return !has_flag( "SEALED", t ) || has_flag( "LIQUIDCONT", t );
+    return !has_flag( TFLAG_SEALED, t ) || has_flag( ter_furn_flag_LIQUIDCONT, t );
 }
 
 std::vector<tripoint> map::get_dir_circle( const tripoint &f, const tripoint &t ) const
@@ -7281,7 +7337,11 @@ void map::loadn( const tripoint &grid, const bool update_vehicles )
     const int old_abs_z = abs_sub.z; // Ugly, but necessary at the moment
     abs_sub.z = grid.z;
 
+    const bool was_loaded = MAPBUFFER.is_submap_loaded( grid_abs_sub );
     submap *tmpsub = MAPBUFFER.lookup_submap( grid_abs_sub );
+    if( g != nullptr && this == &get_map() ) {
+        MAPBUFFER.record_bubble_load( grid_abs_sub, was_loaded );
+    }
     if( tmpsub == nullptr ) {
         // It doesn't exist; we must generate it!
         dbg( DL::Info ) << "map::loadn: Missing mapbuffer data.  Regenerating.";
@@ -7504,7 +7564,7 @@ void map::fill_funnels( const tripoint &p, const time_point &since )
 void map::grow_plant( const tripoint &p )
 {
     const auto &furn = this->furn( p ).obj();
-    if( !furn.has_flag( "PLANT" ) ) {
+    if( !furn.has_flag( TFLAG_PLANT ) ) {
         return;
     }
     // Can't use item_stack::only_item() since there might be fertilizer
@@ -7529,9 +7589,9 @@ void map::grow_plant( const tripoint &p )
     seed_it = map_stack::iterator();
     const time_duration plantEpoch = seed->get_plant_epoch();
     if( seed->age() >= plantEpoch * furn.plant->growth_multiplier &&
-        !furn.has_flag( "GROWTH_HARVEST" ) ) {
+        !furn.has_flag( ter_furn_flag_GROWTH_HARVEST ) ) {
         if( seed->age() < plantEpoch * 2 ) {
-            if( has_flag_furn( "GROWTH_SEEDLING", p ) ) {
+            if( has_flag_furn( ter_furn_flag_GROWTH_SEEDLING, p ) ) {
                 return;
             }
 
@@ -7547,7 +7607,7 @@ void map::grow_plant( const tripoint &p )
             rotten_item_spawn( *seed, p );
             furn_set( p, furn_str_id( furn.plant->transform ) );
         } else if( seed->age() < plantEpoch * 3 * furn.plant->growth_multiplier ) {
-            if( has_flag_furn( "GROWTH_MATURE", p ) ) {
+            if( has_flag_furn( ter_furn_flag_GROWTH_MATURE, p ) ) {
                 return;
             }
 
@@ -7563,17 +7623,17 @@ void map::grow_plant( const tripoint &p )
             fertilizer = map_stack::iterator();
             rotten_item_spawn( *seed, p );
             //You've skipped the seedling stage so roll monsters twice
-            if( !has_flag_furn( "GROWTH_SEEDLING", p ) ) {
+            if( !has_flag_furn( ter_furn_flag_GROWTH_SEEDLING, p ) ) {
                 rotten_item_spawn( *seed, p );
             }
             furn_set( p, furn_str_id( furn.plant->transform ) );
         } else {
             //You've skipped two stages so roll monsters two times
-            if( has_flag_furn( "GROWTH_SEEDLING", p ) ) {
+            if( has_flag_furn( ter_furn_flag_GROWTH_SEEDLING, p ) ) {
                 rotten_item_spawn( *seed, p );
                 rotten_item_spawn( *seed, p );
                 //One stage change
-            } else if( has_flag_furn( "GROWTH_MATURE", p ) ) {
+            } else if( has_flag_furn( ter_furn_flag_GROWTH_MATURE, p ) ) {
                 rotten_item_spawn( *seed, p );
                 //Goes from seed to harvest in one check
             } else {
@@ -7719,7 +7779,7 @@ void map::rad_scorch( const tripoint &p, const time_duration &time_since_last_ac
     // First destroy the farmable plants (those are furniture)
     // TODO: Rad-resistant mutant plants (that produce radioactive fruit)
     const furn_t &fid = furn( p ).obj();
-    if( fid.has_flag( "PLANT" ) ) {
+    if( fid.has_flag( TFLAG_PLANT ) ) {
         i_clear( p );
         furn_set( p, f_null );
     }
@@ -7743,9 +7803,9 @@ void map::rad_scorch( const tripoint &p, const time_duration &time_since_last_ac
     }
 
     const ter_t &tr = tid.obj();
-    if( tr.has_flag( "SHRUB" ) ) {
+    if( tr.has_flag( TFLAG_SHRUB ) ) {
         ter_set( p, t_dirt );
-    } else if( tr.has_flag( "TREE" ) ) {
+    } else if( tr.has_flag( TFLAG_TREE ) ) {
         ter_set( p, ter_str_id( "t_tree_dead" ) );
     }
 }
@@ -7787,11 +7847,11 @@ void map::actualize( const tripoint &grid )
             const tripoint pnt = sm_to_ms_copy( grid ) + point( x, y );
             const point p( x, y );
             const auto &furn = this->furn( pnt ).obj();
-            if( furn.has_flag( "EMITTER" ) ) {
+            if( furn.has_flag( ter_furn_flag_EMITTER ) ) {
                 field_furn_locs.push_back( pnt );
             }
             // plants contain a seed item which must not be removed under any circumstances
-            if( !furn.has_flag( "DONT_REMOVE_ROTTEN" ) ) {
+            if( !furn.has_flag( ter_furn_flag_DONT_REMOVE_ROTTEN ) ) {
                 temperature_flag temperature = temperature_flag_at_point( *this, pnt );
                 remove_rotten_items( tmpsub->get_items( { x, y } ), pnt, temperature );
             }
@@ -8596,13 +8656,36 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int minz = zlevels ? -OVERMAP_DEPTH : zlev;
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
+
+    // Outside, transparency and floor caches only read their own level (and the submaps
+    // below it), so levels can be built independently of each other.  Each level is two
+    // tasks: outside and then transparency, which needs the outside cache, and floor.
+    const size_t num_level_tasks = 2 * static_cast<size_t>( maxz - minz + 1 );
+    std::array<bool, OVERMAP_LAYERS> floor_cache_rebuilt = {};
+    const auto build_level_cache = [&]( const size_t task ) {
+        const int z = minz + static_cast<int>( task / 2 );
+        if( task % 2 == 0 ) {
+            build_outside_cache( z );
+            build_transparency_cache( z );
+        } else {
+            floor_cache_rebuilt[z + OVERMAP_DEPTH] = build_floor_cache( z );
+        }
+    };
+    // Shared by all levels, so it must not be updated from the tasks.
+    update_weather_transparency_lookup();
+    if( parallel_map_cache && minz != maxz ) {
+        get_thread_pool().parallel_for( num_level_tasks, build_level_cache );
+    } else {
+        for( size_t task = 0; task < num_level_tasks; task++ ) {
+            build_level_cache( task );
+        }
+    }
+
     for( int z = minz; z <= maxz; z++ ) {
         // trigger FOV recalculation only when there is a change on the player's level or if fov_3d is enabled
         const bool affects_seen_cache =  z == zlev || fov_3d;
-        build_outside_cache( z );
-        build_transparency_cache( z );
         update_suspension_cache( z );
-        seen_cache_dirty |= ( build_floor_cache( z ) && affects_seen_cache );
+        seen_cache_dirty |= floor_cache_rebuilt[z + OVERMAP_DEPTH] && affects_seen_cache;
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty && affects_seen_cache;
         diagonal_blocks fill = {false, false};
         std::uninitialized_fill_n( &( get_cache( z ).vehicle_obscured_cache[0][0] ), MAPSIZE_X * MAPSIZE_Y,
@@ -9197,6 +9280,19 @@ void map::set_pathfinding_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         get_pathfinding_cache( zlev ).dirty = true;
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::mark_dirty_z_level( zlev );
+        }
+    }
+}
+
+void map::set_pathfinding_cache_dirty( const tripoint &p )
+{
+    if( inbounds( p ) ) {
+        get_pathfinding_cache( p.z ).dirty = true;
+        if( g != nullptr && this == &get_map() ) {
+            Pathfinding::mark_dirty_tile( p );
+        }
     }
 }
 
@@ -21,12 +21,12 @@
 #include "coordinates.h"
 #include "enums.h"
 #include "filter_utils.h"
+#include "flat_cache.h"
 #include "game_constants.h"
 #include "item.h"
 #include "item_stack.h"
 #include "lightmap.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "point.h"
@@ -420,6 +420,9 @@ class map
         void set_suspension_cache_dirty( const int zlev );
 
         void set_pathfinding_cache_dirty( int zlev );
+
+        // Only for the tiles around p, as far as the pathfinding d-maps are concerned
+        void set_pathfinding_cache_dirty( const tripoint &p );
         /*@}*/
 
         void set_memory_seen_cache_dirty( const tripoint &p );
@@ -961,6 +964,27 @@ class map
         bool has_flag_ter_or_furn( ter_bitflags flag, point p ) const {
             return has_flag_ter_or_furn( flag, tripoint( p, abs_sub.z ) );
         }
+        // The same for any flag, see TER_FURN_FLAG
+        // Checks terrain, furniture and vehicles
+        bool has_flag( const ter_furn_flag_id &flag, const tripoint &p ) const;
+        bool has_flag( const ter_furn_flag_id &flag, point p ) const {
+            return has_flag( flag, tripoint( p, abs_sub.z ) );
+        }
+        // Checks terrain
+        bool has_flag_ter( const ter_furn_flag_id &flag, const tripoint &p ) const;
+        bool has_flag_ter( const ter_furn_flag_id &flag, point p ) const {
+            return has_flag_ter( flag, tripoint( p, abs_sub.z ) );
+        }
+        // Checks furniture
+        bool has_flag_furn( const ter_furn_flag_id &flag, const tripoint &p ) const;
+        bool has_flag_furn( const ter_furn_flag_id &flag, point p ) const {
+            return has_flag_furn( flag, tripoint( p, abs_sub.z ) );
+        }
+        // Checks terrain or furniture
+        bool has_flag_ter_or_furn( const ter_furn_flag_id &flag, const tripoint &p ) const;
+        bool has_flag_ter_or_furn( const ter_furn_flag_id &flag, point p ) const {
+            return has_flag_ter_or_furn( flag, tripoint( p, abs_sub.z ) );
+        }
 
         // Bashable
         /** Returns true if there is a bashable vehicle part or the furn/terrain is bashable at p */
@@ -1471,7 +1495,7 @@ class map
         /**
          * Remove field entry at xy, ignored if the field entry is not present.
          */
-        void remove_field( const tripoint &p, const field_type_id &field_to_remove );
+        void remove_field( const tripoint &p, field_type_id field_to_remove );
 
         // Splatters of various kind
         void add_splatter( const field_type_id &type, const tripoint &where, int intensity = 1 );
@@ -1788,7 +1812,11 @@ class map
 
         // Builds a transparency cache and returns true if the cache was invalidated.
         // Used to determine if seen cache should be rebuilt.
+        // update_weather_transparency_lookup must have been called first.
         bool build_transparency_cache( int zlev );
+        // Refreshes the weather dependent transparency that light casting uses for its fast path.
+        // It is shared by all levels, so it is updated once before any level is built.
+        static void update_weather_transparency_lookup();
         bool build_vision_transparency_cache( const Character &player );
         // fills lm with sunlight. pzlev is current player's zlevel
         void build_sunlight_cache( int pzlev );
@@ -1917,8 +1945,6 @@ class map
         void apply_directional_light( const tripoint &p, int direction, float luminance );
         void apply_light_arc( const tripoint &p, units::angle, float luminance,
                               units::angle wideangle = 30_degrees );
-        void apply_light_ray( bool lit[MAPSIZE_X][MAPSIZE_Y],
-                              const tripoint &s, const tripoint &e, float luminance );
         void add_light_from_items( const tripoint &p, const item_stack::iterator &begin,
                                    const item_stack::iterator &end );
         std::unique_ptr<vehicle> add_vehicle_to_map( std::unique_ptr<vehicle> veh, bool merge_wrecks );
@@ -1994,11 +2020,16 @@ class map
          * Set of submaps that contain active items in absolute coordinates.
          */
         std::set<tripoint> submaps_with_active_items;
+        /**
+         * Submaps visited by @ref process_items, kept between turns so it doesn't allocate.
+         */
+        std::vector<tripoint> submaps_to_process;
 
         /**
          * Cache of coordinate pairs recently checked for visibility.
+         * Cleared whenever transparency changes.
          */
-        mutable lru_cache<point, char> skew_vision_cache;
+        mutable flat_cache<point, char> skew_vision_cache{ 100000 };
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
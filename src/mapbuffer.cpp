@@ -8,6 +8,8 @@
 #include <utility>
 #include <vector>
 
+#include "binary_io.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "coordinate_conversions.h"
 #include "debug.h"
@@ -34,6 +36,9 @@ mapbuffer::~mapbuffer() = default;
 void mapbuffer::clear()
 {
     submaps.clear();
+    prefetch_requested.clear();
+    prefetch_ready.clear();
+    prefetched_submaps.clear();
 }
 
 bool mapbuffer::add_submap( const tripoint &p, std::unique_ptr<submap> &sm )
@@ -81,7 +86,9 @@ submap *mapbuffer::lookup_submap( const tripoint &p )
         return nullptr;
     }
 
-    return iter->second.get();
+    submap *sm = iter->second.get();
+    sm->is_dirty = true;
+    return sm;
 }
 
 void mapbuffer::save( bool delete_after_save )
@@ -95,6 +102,15 @@ void mapbuffer::save( bool delete_after_save )
 
     static_popup popup;
 
+    last_save_stats = save_stats();
+
+    // Quads read ahead of time may be older than what is about to be written
+    if( g != nullptr && g->get_active_world() != nullptr ) {
+        g->get_active_world()->cancel_map_quad_prefetch();
+    }
+    prefetch_requested.clear();
+    prefetch_ready.clear();
+
     // A set of already-saved submaps, in global overmap coordinates.
     std::set<tripoint> saved_submaps;
     std::list<tripoint> submaps_to_delete;
@@ -129,22 +145,28 @@ void mapbuffer::save( bool delete_after_save )
         // delete_on_save deletes everything, otherwise delete submaps
         // outside the current map.
         const bool zlev_del = !map_has_zlevels && om_addr.z != g->get_levz();
-        save_quad( om_addr, submaps_to_delete,
-                   delete_after_save || zlev_del ||
-                   om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
-                   om_addr.x > map_origin.x + HALF_MAPSIZE ||
-                   om_addr.y > map_origin.y + HALF_MAPSIZE );
+        const bool outside_map = zlev_del ||
+                                 om_addr.x < map_origin.x || om_addr.y < map_origin.y ||
+                                 om_addr.x > map_origin.x + HALF_MAPSIZE ||
+                                 om_addr.y > map_origin.y + HALF_MAPSIZE;
+        save_quad( om_addr, submaps_to_delete, delete_after_save || outside_map, !outside_map );
         num_saved_submaps += 4;
     }
     for( auto &elem : submaps_to_delete ) {
         remove_submap( elem );
     }
 
+    DebugLog( DL::Info, DC::Main ) << "Saved map: " << last_save_stats.quads_written <<
+                                   " quads written, " << last_save_stats.quads_skipped << " unchanged quads skipped, " <<
+                                   last_save_stats.bytes_written << " bytes written";
+    DebugLog( DL::Info, DC::Main ) << "Submap prefetch: " << prefetch_counters.hits << " hits, " <<
+                                   prefetch_counters.misses << " misses";
+
     get_distribution_grid_tracker().on_saved();
 }
 
 void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                           bool delete_after_save )
+                           bool delete_after_save, bool in_reality_bubble )
 {
     std::vector<point> offsets;
     std::vector<tripoint> submap_addrs;
@@ -154,6 +176,7 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
     offsets.push_back( point_south_east );
 
     bool all_uniform = true;
+    bool any_dirty = false;
     for( auto &offsets_offset : offsets ) {
         tripoint submap_addr = omt_to_sm_copy( om_addr );
         submap_addr.x += offsets_offset.x;
@@ -163,6 +186,9 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         if( sm != nullptr && !sm->is_uniform ) {
             all_uniform = false;
         }
+        if( sm != nullptr && sm->is_dirty ) {
+            any_dirty = true;
+        }
     }
 
     if( all_uniform ) {
@@ -178,24 +204,82 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
         return;
     }
 
+    // Submaps in the reality bubble are changed through the map without going through
+    // the mapbuffer, so they are always written
+    if( !any_dirty && !in_reality_bubble ) {
+        // The savefile is up to date
+        last_save_stats.quads_skipped++;
+        if( delete_after_save ) {
+            for( auto &submap_addr : submap_addrs ) {
+                if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
+            }
+        }
+        return;
+    }
+
     if( disable_mapgen ) {
         return;
     }
 
-    g->get_active_world()->write_map_quad( om_addr, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
-        for( auto &submap_addr : submap_addrs ) {
-            if( !submaps.contains( submap_addr ) ) {
-                continue;
+    world *active_world = g->get_active_world();
+    const bool binary = binary_submap_saves &&
+                        active_world->info->world_save_format == save_format::V2_COMPRESSED_SQLITE3;
+    std::size_t quad_bytes = 0;
+    const bool written = active_world->write_map_quad( om_addr, [&]( std::ostream & fout ) {
+        write_quad( fout, submap_addrs, binary );
+        quad_bytes = std::max<std::streamoff>( fout.tellp(), 0 );
+        if( delete_after_save ) {
+            for( auto &submap_addr : submap_addrs ) {
+                if( submaps.contains( submap_addr ) && submaps[submap_addr] != nullptr ) {
+                    submaps_to_delete.push_back( submap_addr );
+                }
             }
+        }
+    } );
 
+    if( !written ) {
+        return;
+    }
+    last_save_stats.quads_written++;
+    last_save_stats.bytes_written += quad_bytes;
+    // Submaps that stay in the reality bubble may change without being marked
+    // and have to be written again once they leave it
+    if( !in_reality_bubble ) {
+        for( auto &submap_addr : submap_addrs ) {
             submap *sm = submaps[submap_addr].get();
-
-            if( sm == nullptr ) {
-                continue;
+            if( sm != nullptr ) {
+                sm->is_dirty = false;
             }
+        }
+    }
+}
+
+namespace
+{
+
+// Binary quads start with this, json ones with '['
+constexpr char binary_quad_magic[] = { 'C', 'B', 'S', 'Q' };
+constexpr int binary_quad_format = 1;
+
+} // namespace
 
+void mapbuffer::write_quad( std::ostream &out, const std::vector<tripoint> &submap_addrs,
+                            bool binary ) const
+{
+    std::vector<std::pair<tripoint, const submap *>> quad;
+    for( const tripoint &submap_addr : submap_addrs ) {
+        const auto iter = submaps.find( submap_addr );
+        if( iter != submaps.end() && iter->second != nullptr ) {
+            quad.emplace_back( submap_addr, iter->second.get() );
+        }
+    }
+
+    if( !binary ) {
+        JsonOut jsout( out );
+        jsout.start_array();
+        for( const auto &[submap_addr, sm] : quad ) {
             jsout.start_object();
 
             jsout.member( "version", savegame_version );
@@ -210,14 +294,138 @@ void mapbuffer::save_quad( const tripoint &om_addr, std::list<tripoint> &submaps
             sm->store( jsout );
 
             jsout.end_object();
+        }
+        jsout.end_array();
+        return;
+    }
 
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
-            }
+    out.write( binary_quad_magic, sizeof( binary_quad_magic ) );
+    binary_io::write_varint( out, binary_quad_format );
+    binary_io::write_varint( out, quad.size() );
+    for( const auto &[submap_addr, sm] : quad ) {
+        binary_io::write_varint( out, savegame_version );
+        binary_io::write_svarint( out, submap_addr.x );
+        binary_io::write_svarint( out, submap_addr.y );
+        binary_io::write_svarint( out, submap_addr.z );
+        sm->store_grids( out );
+
+        // Items, vehicles and the like are still json, they are rare enough to not matter
+        std::ostringstream contents;
+        JsonOut jsout( contents );
+        jsout.start_object();
+        sm->store_contents( jsout );
+        jsout.end_object();
+        binary_io::write_string( out, contents.str() );
+    }
+}
+
+void mapbuffer::read_quad( std::istream &in )
+{
+    char magic[sizeof( binary_quad_magic )] = {};
+    in.read( magic, sizeof( magic ) );
+    if( !in || !std::equal( std::begin( magic ), std::end( magic ), std::begin( binary_quad_magic ) ) ) {
+        in.clear();
+        in.seekg( 0 );
+        JsonIn jsin( in );
+        deserialize( jsin );
+        return;
+    }
+
+    const uint64_t format = binary_io::read_varint( in );
+    if( format != binary_quad_format ) {
+        throw std::runtime_error( string_format( "unknown binary map format %d", format ) );
+    }
+    for( uint64_t num_submaps = binary_io::read_varint( in ); num_submaps > 0; num_submaps-- ) {
+        const int version = static_cast<int>( binary_io::read_varint( in ) );
+        tripoint submap_coordinates;
+        submap_coordinates.x = static_cast<int>( binary_io::read_svarint( in ) );
+        submap_coordinates.y = static_cast<int>( binary_io::read_svarint( in ) );
+        submap_coordinates.z = static_cast<int>( binary_io::read_svarint( in ) );
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( submap_coordinates ) );
+        // Matches what is on disk
+        sm->is_dirty = false;
+        sm->load_grids( in );
+
+        const std::string contents = binary_io::read_string( in );
+        JsonIn jsin( contents );
+        jsin.start_object();
+        while( !jsin.end_object() ) {
+            const std::string member_name = jsin.get_member_name();
+            sm->load( jsin, member_name, version, multiply_xy( submap_coordinates, 12 ) );
         }
 
-        jsout.end_array();
-    } );
+        if( !add_submap( submap_coordinates, sm ) ) {
+            debugmsg( "submap %d,%d,%d was already loaded", submap_coordinates.x, submap_coordinates.y,
+                      submap_coordinates.z );
+        }
+    }
+}
+
+void mapbuffer::prefetch( const std::vector<tripoint> &submap_addrs )
+{
+    world *active_world = g->get_active_world();
+    if( active_world == nullptr ) {
+        return;
+    }
+    // Requests for quads that were never saved are never answered
+    if( prefetch_requested.size() > 1024 ) {
+        prefetch_requested.clear();
+    }
+
+    for( const tripoint &p : submap_addrs ) {
+        const tripoint om_addr = sm_to_omt_copy( p );
+        if( submaps.contains( omt_to_sm_copy( om_addr ) ) || prefetch_requested.contains( om_addr ) ) {
+            continue;
+        }
+        prefetch_requested.insert( om_addr );
+        active_world->prefetch_map_quad( om_addr );
+    }
+}
+
+void mapbuffer::load_prefetched( int max_quads )
+{
+    world *active_world = g->get_active_world();
+    if( active_world == nullptr ) {
+        return;
+    }
+    for( auto &quad : active_world->take_prefetched_map_quads() ) {
+        prefetch_requested.erase( quad.first );
+        prefetch_ready.push_back( std::move( quad ) );
+    }
+
+    for( ; max_quads > 0 && !prefetch_ready.empty(); max_quads-- ) {
+        const auto [om_addr, data] = std::move( prefetch_ready.front() );
+        prefetch_ready.pop_front();
+
+        // Parse into a separate buffer first, so a broken quad doesn't leave half of it behind.
+        // It will be read again (and the error reported) when it is actually needed.
+        mapbuffer quad_buffer;
+        try {
+            std::istringstream fin( data );
+            quad_buffer.read_quad( fin );
+        } catch( const std::exception & ) {
+            continue;
+        }
+        // Something loaded or generated the quad in the meantime
+        if( std::ranges::any_of( quad_buffer.submaps, [this]( const auto & elem ) {
+        return submaps.contains( elem.first );
+        } ) ) {
+            continue;
+        }
+        for( auto &elem : quad_buffer.submaps ) {
+            prefetched_submaps.insert( elem.first );
+            submaps.emplace( elem.first, std::move( elem.second ) );
+        }
+    }
+}
+
+void mapbuffer::record_bubble_load( const tripoint &p, bool was_loaded )
+{
+    if( prefetched_submaps.erase( p ) > 0 ) {
+        prefetch_counters.hits++;
+    } else if( !was_loaded ) {
+        prefetch_counters.misses++;
+    }
 }
 
 // We're reading in way too many entities here to mess around with creating sub-objects and
@@ -228,7 +436,7 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
     const tripoint om_addr = sm_to_omt_copy( p );
 
     using namespace std::placeholders;
-    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::deserialize,
+    if( !g->get_active_world()->read_map_quad( om_addr, std::bind( &mapbuffer::read_quad,
             this, _1 ) ) ) {
         // If it doesn't exist, trigger generating it.
         return nullptr;
@@ -238,7 +446,9 @@ submap *mapbuffer::unserialize_submaps( const tripoint &p )
                   p.x, p.y, p.z );
         return nullptr;
     }
-    return submaps[ p ].get();
+    submap *sm = submaps[ p ].get();
+    sm->is_dirty = true;
+    return sm;
 }
 
 void mapbuffer::deserialize( JsonIn &jsin )
@@ -262,6 +472,8 @@ void mapbuffer::deserialize( JsonIn &jsin )
                 jsin.end_array();
                 submap_coordinates = loc;
                 sm = std::make_unique<submap>( sm_to_ms_copy( submap_coordinates ) );
+                // Matches what is on disk
+                sm->is_dirty = false;
             } else {
                 if( !sm ) { //This whole thing is a nasty hack that relys on coordinates coming first...
                     debugmsg( "coordinates was not at the top of submap json" );
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <deque>
+#include <iosfwd>
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "coordinates.h"
 #include "point.h"
@@ -21,11 +27,23 @@ class mapbuffer
         ~mapbuffer();
 
         /** Store all submaps in this instance into savefiles.
+         * Quads outside of the reality bubble are only written if one of their
+         * submaps is dirty, see @ref submap::is_dirty.
          * @param delete_after_save If true, the saved submaps are removed
          * from the mapbuffer (and deleted).
          **/
         void save( bool delete_after_save = false );
 
+        /** What the last call to @ref save did. */
+        struct save_stats {
+            int quads_written = 0;
+            int quads_skipped = 0;
+            std::size_t bytes_written = 0;
+        };
+        const save_stats &get_last_save_stats() const {
+            return last_save_stats;
+        }
+
         /** Delete all buffered submaps. **/
         void clear();
 
@@ -50,6 +68,7 @@ class mapbuffer
          * @return NULL if the submap is not in the mapbuffer
          * and could not be loaded. The mapbuffer takes care of the returned
          * submap object, don't delete it on your own.
+         * The returned submap is marked dirty, since the caller may change it.
          */
         submap *lookup_submap( const tripoint &p );
         submap *lookup_submap( const tripoint_abs_sm &p ) {
@@ -71,6 +90,36 @@ class mapbuffer
             return submaps.contains( p );
         }
 
+        /**
+         * Start reading the quads containing @p submap_addrs on a background thread,
+         * unless they are loaded or requested already. See @ref world::prefetch_map_quad.
+         */
+        void prefetch( const std::vector<tripoint> &submap_addrs );
+        /** Add up to @p max_quads of the quads read since @ref prefetch to the buffer. */
+        void load_prefetched( int max_quads );
+
+        /** How many submaps the reality bubble found already loaded thanks to @ref prefetch,
+         * and how many it had to read or generate when it got to them. */
+        struct prefetch_stats {
+            int hits = 0;
+            int misses = 0;
+        };
+        const prefetch_stats &get_prefetch_stats() const {
+            return prefetch_counters;
+        }
+        /** Called by @ref map::loadn of the reality bubble, @p was_loaded tells whether @p p was in the buffer. */
+        void record_bubble_load( const tripoint &p, bool was_loaded );
+
+        /**
+         * Write the submaps at @p submap_addrs (those that are loaded) as one quad.
+         * The binary format is much faster to write and read than json, but older
+         * versions of the game can't load it.
+         */
+        void write_quad( std::ostream &out, const std::vector<tripoint> &submap_addrs,
+                         bool binary ) const;
+        /** Add the submaps of a quad written by @ref write_quad in either format. */
+        void read_quad( std::istream &in );
+
     private:
         // There's a very good reason this is private,
         // if not handled carefully, this can erase in-use submaps and crash the game.
@@ -78,8 +127,17 @@ class mapbuffer
         submap *unserialize_submaps( const tripoint &p );
         void deserialize( JsonIn &jsin );
         void save_quad( const tripoint &om_addr, std::list<tripoint> &submaps_to_delete,
-                        bool delete_after_save );
+                        bool delete_after_save, bool in_reality_bubble );
         submap_map_t submaps;
+        save_stats last_save_stats;
+
+        // Quads requested from the world that haven't been read yet, in omt coords
+        std::set<tripoint> prefetch_requested;
+        // Quads read ahead of time, waiting to be deserialized
+        std::deque<std::pair<tripoint, std::string>> prefetch_ready;
+        // Submaps added by prefetching that the reality bubble hasn't reached yet
+        std::set<tripoint> prefetched_submaps;
+        prefetch_stats prefetch_counters;
 };
 
 extern mapbuffer MAPBUFFER;
@@ -207,6 +207,49 @@ static const std::unordered_map<std::string, ter_bitflags> ter_bitflags_map = {
     }
 };
 
+namespace
+{
+struct ter_furn_flag_registry {
+    std::unordered_map<std::string, uint32_t> indices;
+    std::vector<std::string> names;
+};
+
+ter_furn_flag_registry &get_ter_furn_flags()
+{
+    // Never cleared, handles outlive loaded data
+    static ter_furn_flag_registry registry;
+    return registry;
+}
+} // namespace
+
+ter_furn_flag_id::ter_furn_flag_id( const std::string &flag )
+{
+    ter_furn_flag_registry &registry = get_ter_furn_flags();
+    const auto inserted = registry.indices.emplace( flag,
+                          static_cast<uint32_t>( registry.names.size() ) );
+    if( inserted.second ) {
+        registry.names.push_back( flag );
+    }
+    index_ = inserted.first->second;
+}
+
+ter_furn_flag_id ter_furn_flag_id::find( const std::string &flag )
+{
+    const ter_furn_flag_registry &registry = get_ter_furn_flags();
+    const auto it = registry.indices.find( flag );
+    ter_furn_flag_id result;
+    if( it != registry.indices.end() ) {
+        result.index_ = it->second;
+    }
+    return result;
+}
+
+const std::string &ter_furn_flag_id::str() const
+{
+    static const std::string invalid_name;
+    return is_valid() ? get_ter_furn_flags().names[index_] : invalid_name;
+}
+
 static const std::unordered_map<std::string, ter_connects> ter_connects_map = { {
         { "WALL",                     TERCONN_WALL },         // implied by TFLAG_CONNECT_TO_WALL, TFLAG_AUTO_WALL_SYMBOL or TFLAG_WALL
         { "CHAINFENCE",               TERCONN_CHAINFENCE },
@@ -602,6 +645,11 @@ void load_terrain( const JsonObject &jo, const std::string &src )
 void map_data_common_t::set_flag( const std::string &flag )
 {
     flags.insert( flag );
+    const uint32_t index = ter_furn_flag_id( flag ).index();
+    if( flag_bits.size() <= index / 64 ) {
+        flag_bits.resize( index / 64 + 1 );
+    }
+    flag_bits[index / 64] |= uint64_t( 1 ) << ( index % 64 );
     const auto it = ter_bitflags_map.find( flag );
     if( it != ter_bitflags_map.end() ) {
         bitflags.set( it->second );
@@ -1303,6 +1351,7 @@ void map_data_common_t::load( const JsonObject &jo, const std::string &src )
 
     assign( jo, "flags", flags );
     bitflags.reset();
+    flag_bits.clear();
     transparent = false;
 
     for( const std::string &flag : flags ) {
@@ -3,6 +3,7 @@
 #include <array>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <set>
 #include <string>
@@ -12,6 +13,7 @@
 #include "calendar.h"
 #include "catalua_type_operators.h"
 #include "color.h"
+#include "make_static.h"
 #include "numeric_interval.h"
 #include "poly_serialized.h"
 #include "translations.h"
@@ -250,6 +252,7 @@ struct pry_result {
  * so much that strings produce a significant performance penalty. The following are equivalent:
  *  m->has_flag("FLAMMABLE");     //
  *  m->has_flag(TFLAG_FLAMMABLE); // ~ 20 x faster than the above, ( 2.5 x faster if the above uses static const std::string str_flammable("FLAMMABLE");
+ *  m->has_flag(TER_FURN_FLAG("FLAMMABLE")); // about as fast, and works for any flag
  * To add a new ter_bitflag, add below and add to ter_bitflags_map in mapdata.cpp
  * Order does not matter.
  */
@@ -316,6 +319,49 @@ enum ter_bitflags : int {
     NUM_TERFLAGS
 };
 
+/**
+ * Any terrain or furniture flag, interned into a dense index so checking it is a single
+ * bit test. Flags are interned when terrain and furniture are loaded and when a handle is
+ * created for them, the index of a flag never changes after that.
+ *
+ * Handles are meant to be created once: as a file-scope constant like the other ids
+ * (`static const ter_furn_flag_id ter_furn_flag_WALL( "WALL" );`), or with
+ * @ref TER_FURN_FLAG where a constant isn't practical. Checking a flag by its string
+ * looks the index up every time.
+ */
+class ter_furn_flag_id
+{
+    public:
+        ter_furn_flag_id() = default;
+        /** Interns @p flag. Only call this on the main thread. */
+        explicit ter_furn_flag_id( const std::string &flag );
+
+        /** The flag if it has been interned, an invalid one no terrain has otherwise. */
+        static ter_furn_flag_id find( const std::string &flag );
+
+        bool is_valid() const {
+            return index_ != invalid;
+        }
+        uint32_t index() const {
+            return index_;
+        }
+        const std::string &str() const;
+
+        bool operator==( const ter_furn_flag_id &rhs ) const {
+            return index_ == rhs.index_;
+        }
+        bool operator!=( const ter_furn_flag_id &rhs ) const {
+            return index_ != rhs.index_;
+        }
+
+    private:
+        static constexpr uint32_t invalid = UINT32_MAX;
+        uint32_t index_ = invalid;
+};
+
+/** Handle of the terrain and furniture flag @p flag, interned the first time it's reached. */
+#define TER_FURN_FLAG( flag ) STATIC( ter_furn_flag_id( flag ) )
+
 /*
  * Terrain groups which affect whether the terrain connects visually.
  * Groups are also defined in ter_connects_map() in mapdata.cpp which matches group to JSON string.
@@ -428,6 +474,7 @@ struct map_data_common_t {
     private:
         std::set<std::string> flags;    // string flags which possibly refer to what's documented above.
         std::bitset<NUM_TERFLAGS> bitflags; // bitfield of -certain- string flags which are heavily checked
+        std::vector<uint64_t> flag_bits; // bitfield of all flags, by ter_furn_flag_id index
 
     public:
         ter_str_id curtain_transform;
@@ -488,7 +535,13 @@ struct map_data_common_t {
         }
 
         bool has_flag( const std::string &flag ) const {
-            return flags.contains( flag );
+            return has_flag( ter_furn_flag_id::find( flag ) );
+        }
+
+        bool has_flag( const ter_furn_flag_id &flag ) const {
+            // Invalid flags are far beyond the end
+            const size_t word = flag.index() / 64;
+            return word < flag_bits.size() && ( ( flag_bits[word] >> ( flag.index() % 64 ) ) & 1 );
         }
 
         bool has_flag( const ter_bitflags flag ) const {
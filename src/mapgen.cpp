@@ -99,6 +99,8 @@ static const mongroup_id GROUP_ZOMBIE_COP( "GROUP_ZOMBIE_COP" );
 
 static const trait_id trait_NPC_STATIC_NPC( "NPC_STATIC_NPC" );
 
+static const ter_furn_flag_id ter_furn_flag_PLACE_ITEM( "PLACE_ITEM" );
+
 #define dbg(x) DebugLogFL((x),DC::MapGen)
 
 static constexpr int MON_RADIUS = 3;
@@ -2320,10 +2322,10 @@ class jmapgen_terrain : public jmapgen_piece
             }
             dat.m.ter_set( point( x.get(), y.get() ), chosen_id );
             // Delete furniture if a wall was just placed over it. TODO: need to do anything for fluid, monsters?
-            if( dat.m.has_flag_ter( "WALL", point( x.get(), y.get() ) ) ) {
+            if( dat.m.has_flag_ter( TFLAG_WALL, point( x.get(), y.get() ) ) ) {
                 dat.m.furn_set( point( x.get(), y.get() ), f_null );
                 // and items, unless the wall has PLACE_ITEM flag indicating it stores things.
-                if( !dat.m.has_flag_ter( "PLACE_ITEM", point( x.get(), y.get() ) ) ) {
+                if( !dat.m.has_flag_ter( ter_furn_flag_PLACE_ITEM, point( x.get(), y.get() ) ) ) {
                     dat.m.i_clear( tripoint( x.get(), y.get(), dat.m.get_abs_sub().z ) );
                 }
             }
@@ -6254,9 +6256,9 @@ std::vector<item *> map::place_items( const item_group_id &loc, const int chance
         auto is_valid_terrain = [this, ongrass]( point  p ) {
             auto &terrain = ter( p ).obj();
             return terrain.movecost == 0           &&
-                   !terrain.has_flag( "PLACE_ITEM" ) &&
+                   !terrain.has_flag( ter_furn_flag_PLACE_ITEM ) &&
                    !ongrass                                   &&
-                   !terrain.has_flag( "FLAT" );
+                   !terrain.has_flag( TFLAG_FLAT );
         };
 
         point p;
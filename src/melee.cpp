@@ -117,6 +117,9 @@ static const efftype_id effect_amigara( "amigara" );
 
 static const species_id HUMAN( "HUMAN" );
 
+static const ter_furn_flag_id ter_furn_flag_SWIMMABLE( "SWIMMABLE" );
+static const ter_furn_flag_id ter_furn_flag_THIN_OBSTACLE( "THIN_OBSTACLE" );
+
 void player_hit_message( Character *attacker, const std::string &message,
                          Creature &t, int dam, bool crit = false );
 int  stumble( Character &u, const item &weap );
@@ -714,7 +717,7 @@ void Character::reach_attack( const tripoint &p )
         } else if( here.impassable( path_point ) &&
                    // Fences etc. Spears can stab through those
                    !( primary_weapon().has_flag( flag_SPEAR ) &&
-                      g->m.has_flag( "THIN_OBSTACLE", path_point ) &&
+                      g->m.has_flag( ter_furn_flag_THIN_OBSTACLE, path_point ) &&
                       x_in_y( skill, 10 ) ) ) {
             /** @EFFECT_STR increases bash effects when reach attacking past something */
             here.bash( path_point, str_cur + primary_weapon().damage_melee( DT_BASH ) );
@@ -1504,7 +1507,7 @@ void Character::perform_technique( const ma_technique &technique, Creature &t, d
         if( technique.knockback_follow ) {
             const optional_vpart_position vp0 = g->m.veh_at( pos() );
             vehicle *const veh0 = veh_pointer_or_null( vp0 );
-            bool to_swimmable = g->m.has_flag( "SWIMMABLE", prev_pos );
+            bool to_swimmable = g->m.has_flag( ter_furn_flag_SWIMMABLE, prev_pos );
             bool to_deepwater = g->m.has_flag( TFLAG_DEEP_WATER, prev_pos );
 
             // Check if it's possible to move to the new tile
@@ -209,6 +209,11 @@ static const mtype_id mon_zombie_skeltal_minion( "mon_zombie_skeltal_minion" );
 
 static const bionic_id bio_uncanny_dodge( "bio_uncanny_dodge" );
 
+static const ter_furn_flag_id ter_furn_flag_DIGGABLE( "DIGGABLE" );
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+static const ter_furn_flag_id ter_furn_flag_PLANT( "PLANT" );
+static const ter_furn_flag_id ter_furn_flag_TREE( "TREE" );
+
 // shared utility functions
 static bool within_visual_range( monster *z, int max_range )
 {
@@ -333,7 +338,7 @@ bool mattack::none( monster * )
 bool mattack::eat_crop( monster *z )
 {
     for( const auto &p : g->m.points_in_radius( z->pos(), 1 ) ) {
-        if( g->m.has_flag( "PLANT", p ) && one_in( 4 ) ) {
+        if( g->m.has_flag( ter_furn_flag_PLANT, p ) && one_in( 4 ) ) {
             g->m.furn_set( p, furn_str_id( g->m.furn( p )->plant->base ) );
             g->m.i_clear( p );
             return true;
@@ -346,7 +351,7 @@ bool mattack::eat_food( monster *z )
 {
     for( const auto &p : g->m.points_in_radius( z->pos(), 1 ) ) {
         //Protect crop seeds from carnivores, give omnivores eat_crop special also
-        if( g->m.has_flag( "PLANT", p ) ) {
+        if( g->m.has_flag( ter_furn_flag_PLANT, p ) ) {
             continue;
         }
         // Don't snap up food RIGHT under the player's nose.
@@ -1453,8 +1458,8 @@ bool mattack::growplants( monster *z )
     for( const auto &p : g->m.points_in_radius( z->pos(), 3 ) ) {
 
         // Only affect natural, dirtlike terrain or trees.
-        if( !( g->m.has_flag_ter( "DIGGABLE", p ) ||
-               g->m.has_flag_ter( "TREE", p ) ||
+        if( !( g->m.has_flag_ter( ter_furn_flag_DIGGABLE, p ) ||
+               g->m.has_flag_ter( ter_furn_flag_TREE, p ) ||
                g->m.ter( p ) == t_tree_young ) ) {
             continue;
         }
@@ -1714,7 +1719,7 @@ bool mattack::fungus( monster *z )
         add_msg( m_warning, _( "Spores are released from the %s!" ), z->name() );
     }
 
-    bool on_fungus = g->m.has_flag_ter( "FUNGUS", z->pos() );
+    bool on_fungus = g->m.has_flag_ter( ter_furn_flag_FUNGUS, z->pos() );
     int radius = one_in( 4 ) ? 2 : 1;
     double spore_chance = ( on_fungus ? 0.5f : 0.2f ) / ( ( radius + 1 ) * ( radius + 1 ) );
     fungal_effects fe( *g, g->m );
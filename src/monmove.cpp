@@ -9,12 +9,14 @@
 #include <iterator>
 #include <list>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <unordered_map>
 
 #include "avatar.h"
 #include "behavior.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "creature_tracker.h"
 #include "debug.h"
@@ -78,7 +80,9 @@ static const species_id SPIDER( "SPIDER" );
 static const species_id ZOMBIE( "ZOMBIE" );
 
 static const std::string flag_AUTODOC_COUCH( "AUTODOC_COUCH" );
-static const std::string flag_LIQUID( "LIQUID" );
+
+static const ter_furn_flag_id ter_furn_flag_BURROWABLE( "BURROWABLE" );
+static const ter_furn_flag_id ter_furn_flag_ROAD( "ROAD" );
 
 enum {
     MONSTER_FOLLOW_DIST = 8
@@ -125,10 +129,10 @@ bool monster::will_move_to( const tripoint &p ) const
     if( g->m.impassable( p ) ) {
         tripoint above_p = p + tripoint_above;
         if( digging() ) {
-            if( !g->m.has_flag( "BURROWABLE", p ) ) {
+            if( !g->m.has_flag( ter_furn_flag_BURROWABLE, p ) ) {
                 return false;
             }
-        } else if( !( can_climb() && g->m.has_flag( "CLIMBABLE", p ) &&
+        } else if( !( can_climb() && g->m.has_flag( TFLAG_CLIMBABLE, p ) &&
                       !g->m.has_floor_or_support( above_p ) ) ) {
             return false;
         }
@@ -138,11 +142,12 @@ bool monster::will_move_to( const tripoint &p ) const
         return false;
     }
 
-    if( digs() && !g->m.has_flag( "DIGGABLE", p ) && !g->m.has_flag( "BURROWABLE", p ) ) {
+    if( digs() && !g->m.has_flag( TFLAG_DIGGABLE, p ) &&
+        !g->m.has_flag( ter_furn_flag_BURROWABLE, p ) ) {
         return false;
     }
 
-    if( has_flag( MF_AQUATIC ) && !g->m.has_flag( "SWIMMABLE", p ) ) {
+    if( has_flag( MF_AQUATIC ) && !g->m.has_flag( TFLAG_SWIMMABLE, p ) ) {
         return false;
     }
 
@@ -200,7 +205,7 @@ bool monster::will_move_to( const tripoint &p ) const
         // Some things are only avoided if we're not attacking
         if( attitude( &g->u ) != MATT_ATTACK ) {
             // Sharp terrain is ignored while attacking
-            if( avoid_simple && g->m.has_flag( "SHARP", p ) &&
+            if( avoid_simple && g->m.has_flag( TFLAG_SHARP, p ) &&
                 !( type->size == creature_size::tiny || flies() ) ) {
                 return false;
             }
@@ -337,7 +342,7 @@ void monster::plan()
 {
     ZoneScoped;
 
-    const auto &factions = g->critter_tracker->factions();
+    const Creature_tracker &tracker = *g->critter_tracker;
 
     // Bots are more intelligent than most living stuff
     bool smart_planning = has_flag( MF_PRIORITIZE_TARGETS );
@@ -345,6 +350,10 @@ void monster::plan()
     int max_sight_range = std::max( type->vision_day, type->vision_night );
     // 8.6f is rating for tank drone 60 tiles away, moose 16 or boomer 33
     float dist = !smart_planning ? max_sight_range : 8.6f;
+    // Nothing further away gets a rating from rate_target: simple minded monsters only
+    // look closer than `dist`, and nothing is seen past both the lit and unlit view range
+    const int target_radius = !smart_planning ? max_sight_range :
+                              std::max( max_sight_range, MAX_VIEW_DISTANCE );
     bool fleeing = false;
     bool docile = friendly != 0 && has_effect( effect_docile );
     bool waiting = has_effect( effect_ai_waiting );
@@ -389,11 +398,12 @@ void monster::plan()
             }
         }
         if( angers_cub_threatened > 0 ) {
-            for( monster &tmp : g->all_monsters() ) {
-                if( type->baby_monster == tmp.type->id ) {
+            // Babies with the player within 3 tiles of them, smart ones rate by power as well
+            const int baby_radius = !smart_planning ? 3 : std::max( max_sight_range, MAX_VIEW_DISTANCE );
+            for( monster *tmp : tracker.monsters_in_radius( g->u.pos(), baby_radius ) ) {
+                if( type->baby_monster == tmp->type->id ) {
                     // baby nearby; is the player too close?
-                    dist = tmp.rate_target( g->u, dist, smart_planning );
-                    if( dist <= 3 ) {
+                    if( tmp->rate_target( g->u, dist, smart_planning ) <= 3 ) {
                         //proximity to baby; monster gets furious and less likely to flee
                         anger += angers_cub_threatened;
                         morale += angers_cub_threatened / 2;
@@ -403,11 +413,11 @@ void monster::plan()
             }
         }
     } else if( friendly != 0 && !docile && !waiting ) {
-        for( monster &tmp : g->all_monsters() ) {
-            if( tmp.friendly == 0 ) {
-                float rating = rate_target( tmp, dist, smart_planning );
+        for( monster *tmp : tracker.monsters_in_radius( pos(), target_radius ) ) {
+            if( tmp->friendly == 0 ) {
+                float rating = rate_target( *tmp, dist, smart_planning );
                 if( rating < dist ) {
-                    target = &tmp;
+                    target = tmp;
                     dist = rating;
                 }
             }
@@ -469,41 +479,34 @@ void monster::plan()
 
     fleeing = fleeing || ( mood == MATT_FLEE );
     if( friendly == 0 ) {
-        for( const auto &fac : factions ) {
-            auto faction_att = faction.obj().attitude( fac.first );
-            if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                continue;
-            }
-
-            for( const weak_ptr_fast<monster> &weak : fac.second ) {
-                const shared_ptr_fast<monster> shared = weak.lock();
-                if( !shared ) {
-                    continue;
-                }
-                monster &mon = *shared;
-                float rating = rate_target( mon, dist, smart_planning );
-                if( rating == dist ) {
-                    ++valid_targets;
-                    if( one_in( valid_targets ) ) {
-                        target = &mon;
-                    }
-                }
-                if( rating < dist ) {
-                    target = &mon;
-                    dist = rating;
-                    valid_targets = 1;
-                }
-                if( rating <= 5 ) {
-                    anger += angers_hostile_near;
-                    morale -= fears_hostile_near;
+        const auto is_hostile_faction = [this]( const mfaction_id & other ) {
+            const auto faction_att = faction.obj().attitude( other );
+            return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+        };
+        for( monster *mon : tracker.monsters_in_radius( pos(), target_radius, is_hostile_faction ) ) {
+            float rating = rate_target( *mon, dist, smart_planning );
+            if( rating == dist ) {
+                ++valid_targets;
+                if( one_in( valid_targets ) ) {
+                    target = mon;
                 }
             }
+            if( rating < dist ) {
+                target = mon;
+                dist = rating;
+                valid_targets = 1;
+            }
+            if( rating <= 5 ) {
+                anger += angers_hostile_near;
+                morale -= fears_hostile_near;
+            }
         }
     }
 
     // Friendly monsters here
     // Avoid for hordes of same-faction stuff or it could get expensive
     const auto actual_faction = friendly == 0 ? faction : mfaction_str_id( "player" );
+    const auto &factions = tracker.factions();
     const auto &myfaction_iter = factions.find( actual_faction );
     if( myfaction_iter == factions.end() ) {
         DebugLog( DL::Error, DC::Game ) << disp_name() << " tried to find faction "
@@ -514,12 +517,13 @@ void monster::plan()
     }
     swarms = swarms && target == nullptr; // Only swarm if we have no target
     if( group_morale || swarms ) {
-        for( const weak_ptr_fast<monster> &weak : myfaction_iter->second ) {
-            const shared_ptr_fast<monster> shared = weak.lock();
-            if( !shared ) {
-                continue;
-            }
-            monster &mon = *shared;
+        const auto is_my_faction = [&actual_faction]( const mfaction_id & other ) {
+            return other == actual_faction;
+        };
+        // Morale only counts allies rated within 10, for simple minded monsters that's 10 tiles
+        const int ally_radius = swarms || smart_planning ? target_radius : std::min( target_radius, 10 );
+        for( monster *ally : tracker.monsters_in_radius( pos(), ally_radius, is_my_faction ) ) {
+            monster &mon = *ally;
             float rating = rate_target( mon, dist, smart_planning );
             if( group_morale && rating <= 10 ) {
                 morale += 10 - rating;
@@ -684,7 +688,7 @@ static float get_stagger_adjust( const tripoint &source, const tripoint &destina
  */
 bool monster::is_aquatic_danger( const tripoint &at_pos )
 {
-    return g->m.has_flag_ter( TFLAG_DEEP_WATER, at_pos ) && g->m.has_flag( flag_LIQUID, at_pos ) &&
+    return g->m.has_flag_ter( TFLAG_DEEP_WATER, at_pos ) && g->m.has_flag( TFLAG_LIQUID, at_pos ) &&
            can_drown() && !g->m.veh_at( at_pos ).part_with_feature( "BOARDABLE", false );
 }
 
@@ -889,12 +893,28 @@ void monster::move()
     }
 
     tripoint destination = this->pos();
+    // Set when our next step was read off the flow field shared by everyone chasing our goal
+    bool follows_flow_field = false;
 
-    if( !this->is_wandering() ) {
+    if( !this->is_wandering() && pathfinding_flow_fields && this->goal.z == this->posz() &&
+        !use_legacy_pathfinding ) {
+        // Reading the field is cheap, so there is no point in keeping a path around
+        this->path.clear();
+        const auto pair = this->get_pathfinding_pair();
+        const std::optional<tripoint> step = Pathfinding::flow_field_step( this->pos(), this->goal,
+                                             pair.first, pair.second );
+        if( !step ) {
+            // No route, go in a straight line
+            destination = goal;
+        } else if( here.valid_move( this->pos(), *step, true, true, true ) ) {
+            destination = *step;
+            follows_flow_field = true;
+        }
+    } else if( !this->is_wandering() ) {
         if( this->repath_requested ) {
             std::vector<tripoint> maybe_new_path;
 
-            if( get_option<bool>( "USE_LEGACY_PATHFINDING" ) ) {
+            if( use_legacy_pathfinding ) {
                 auto pf_settings = get_legacy_pathfinding_settings();
                 maybe_new_path = g->m.route( this->pos(), this->goal, pf_settings, this->get_legacy_path_avoid() );
             } else {
@@ -953,8 +973,8 @@ void monster::move()
     }
 
     const bool have_destination = destination != this->pos();
-    const bool pathed_to_goal = this->path.empty() ? false :
-                                this->path.front() == destination && this->path.back() == goal;
+    const bool pathed_to_goal = follows_flow_field || ( this->path.empty() ? false :
+                                this->path.front() == destination && this->path.back() == goal );
     this->repath_requested = false;
 
     if( !g->m.has_zlevels() ) {
@@ -1380,40 +1400,40 @@ int monster::calc_movecost( const tripoint &f, const tripoint &t ) const
     const int source_cost = g->m.move_cost( f );
     const int dest_cost = g->m.move_cost( t );
     // Digging and flying monsters ignore terrain cost
-    if( flies() || ( digging() && g->m.has_flag( "DIGGABLE", t ) ) ) {
+    if( flies() || ( digging() && g->m.has_flag( TFLAG_DIGGABLE, t ) ) ) {
         movecost = 100;
         // Swimming monsters move super fast in water
     } else if( swims() ) {
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, f ) ) {
             movecost += 25;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, t ) ) {
             movecost += 25;
         } else {
             movecost += 50 * g->m.move_cost( t );
         }
     } else if( can_submerge() ) {
         // No-breathe monsters have to walk underwater slowly
-        if( g->m.has_flag( "SWIMMABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, f ) ) {
             movecost += 250;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "SWIMMABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_SWIMMABLE, t ) ) {
             movecost += 250;
         } else {
             movecost += 50 * g->m.move_cost( t );
         }
         movecost /= 2;
     } else if( climbs() ) {
-        if( g->m.has_flag( "CLIMBABLE", f ) ) {
+        if( g->m.has_flag( TFLAG_CLIMBABLE, f ) ) {
             movecost += 150;
         } else {
             movecost += 50 * g->m.move_cost( f );
         }
-        if( g->m.has_flag( "CLIMBABLE", t ) ) {
+        if( g->m.has_flag( TFLAG_CLIMBABLE, t ) ) {
             movecost += 150;
         } else {
             movecost += 50 * g->m.move_cost( t );
@@ -1513,7 +1533,7 @@ bool monster::bash_at( const tripoint &p )
     bool is_obstructed_by_ter_furn = here.impassable_ter_furn( p );
     bool is_obstructed_by_veh = here.veh_at( p ).obstacle_at_part().has_value();
     bool is_obstructed = is_obstructed_by_ter_furn || is_obstructed_by_veh;
-    bool is_flat_ground = here.has_flag( "ROAD", p ) || here.has_flag( "FLAT", p );
+    bool is_flat_ground = here.has_flag( ter_furn_flag_ROAD, p ) || here.has_flag( TFLAG_FLAT, p );
 
     if( !is_obstructed && is_flat_ground ) {
         bool can_bash_ter = g->m.is_bashable_ter( p );
@@ -1675,7 +1695,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
 
     // Allows climbing monsters to move on terrain with movecost <= 0
     Creature *critter = g->critter_at( destination, is_hallucination() );
-    if( g->m.has_flag( "CLIMBABLE", destination ) ) {
+    if( g->m.has_flag( TFLAG_CLIMBABLE, destination ) ) {
         tripoint above_dest = destination + tripoint_above;
         if( g->m.impassable( destination ) && critter == nullptr &&
             !g->m.has_floor_or_support( above_dest ) ) {
@@ -1684,7 +1704,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
                 force = true;
                 if( g->u.sees( *this ) ) {
                     add_msg( _( "The %1$s flies over the %2$s." ), name(),
-                             g->m.has_flag_furn( "CLIMBABLE", p ) ? g->m.furnname( p ) :
+                             g->m.has_flag_furn( TFLAG_CLIMBABLE, p ) ? g->m.furnname( p ) :
                              g->m.tername( p ) );
                 }
             } else if( climbs() ) {
@@ -1692,7 +1712,7 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
                 force = true;
                 if( g->u.sees( *this ) ) {
                     add_msg( _( "The %1$s climbs over the %2$s." ), name(),
-                             g->m.has_flag_furn( "CLIMBABLE", p ) ? g->m.furnname( p ) :
+                             g->m.has_flag_furn( TFLAG_CLIMBABLE, p ) ? g->m.furnname( p ) :
                              g->m.tername( p ) );
                 }
             }
@@ -1763,17 +1783,17 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
     if( type->size != creature_size::tiny && on_ground ) {
         const int sharp_damage = rng( 1, 10 );
         const int rough_damage = rng( 1, 2 );
-        if( g->m.has_flag( "SHARP", pos() ) && !one_in( 4 ) &&
+        if( g->m.has_flag( TFLAG_SHARP, pos() ) && !one_in( 4 ) &&
             get_armor_cut( bodypart_id( "torso" ) ) < sharp_damage ) {
             apply_damage( nullptr, bodypart_id( "torso" ), sharp_damage );
         }
-        if( g->m.has_flag( "ROUGH", pos() ) && one_in( 6 ) &&
+        if( g->m.has_flag( TFLAG_ROUGH, pos() ) && one_in( 6 ) &&
             get_armor_cut( bodypart_id( "torso" ) ) < rough_damage ) {
             apply_damage( nullptr, bodypart_id( "torso" ), rough_damage );
         }
     }
 
-    if( g->m.has_flag( "UNSTABLE", destination ) && on_ground ) {
+    if( g->m.has_flag( TFLAG_UNSTABLE, destination ) && on_ground ) {
         add_effect( effect_bouldering, 1_turns );
     } else if( has_effect( effect_bouldering ) ) {
         remove_effect( effect_bouldering );
@@ -1790,10 +1810,10 @@ bool monster::move_to( const tripoint &p, bool force, bool step_on_critter,
         return true;
     }
     if( !will_be_water && ( digs() || can_dig() ) ) {
-        set_underwater( g->m.has_flag( "DIGGABLE", pos() ) );
+        set_underwater( g->m.has_flag( TFLAG_DIGGABLE, pos() ) );
     }
     // Diggers turn the dirt into dirtmound
-    if( digging() && g->m.has_flag( "DIGGABLE", pos() ) ) {
+    if( digging() && g->m.has_flag( TFLAG_DIGGABLE, pos() ) ) {
         int factor = 0;
         switch( type->size ) {
             case creature_size::tiny:
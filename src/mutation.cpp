@@ -556,7 +556,7 @@ void Character::activate_mutation( const trait_id &mut )
         // Check for adjacent trees.
         bool adjacent_tree = false;
         for( const tripoint &p2 : g->m.points_in_radius( pos(), 1 ) ) {
-            if( g->m.has_flag( "TREE", p2 ) ) {
+            if( g->m.has_flag( TER_FURN_FLAG( "TREE" ), p2 ) ) {
                 adjacent_tree = true;
             }
         }
@@ -24,12 +24,12 @@
 #include "enums.h"
 #include "enum_traits.h"
 #include "faction.h"
+#include "flat_cache.h"
 #include "game_constants.h"
 #include "int_id.h"
 #include "inventory.h"
 #include "item.h"
 #include "line.h"
-#include "lru_cache.h"
 #include "pimpl.h"
 #include "player.h"
 #include "point.h"
@@ -505,7 +505,7 @@ struct npc_short_term_cache {
     std::vector<sphere> dangerous_explosives;
     std::map<direction, float> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
-    lru_cache<tripoint, int> searched_tiles;
+    flat_cache<tripoint, int> searched_tiles{ 1000 };
 };
 
 struct npc_need_goal_cache {
@@ -22,6 +22,7 @@
 #include "character_id.h"
 #include "clzones.h"
 #include "coordinate_conversions.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "dispersion.h"
@@ -123,6 +124,10 @@ static const itype_id itype_smoxygen_tank( "smoxygen_tank" );
 static const itype_id itype_thorazine( "thorazine" );
 static const itype_id itype_oxygen_tank( "oxygen_tank" );
 
+static const ter_furn_flag_id ter_furn_flag_CLIMBABLE( "CLIMBABLE" );
+static const ter_furn_flag_id ter_furn_flag_DOOR( "DOOR" );
+static const ter_furn_flag_id ter_furn_flag_UNSTABLE( "UNSTABLE" );
+
 static constexpr float NPC_DANGER_VERY_LOW = 5.0f;
 static constexpr float NPC_DANGER_MAX = 150.0f;
 static constexpr float MAX_FLOAT = 5000000000.0f;
@@ -458,7 +463,10 @@ void npc::assess_danger()
         }
     }
 
-    for( const monster &critter : g->all_monsters() ) {
+    // Nothing further away can be seen, allies that far off don't matter either
+    for( const monster *critter_ptr : g->critter_tracker->monsters_in_radius( pos(),
+            MAX_VIEW_DISTANCE ) ) {
+        const monster &critter = *critter_ptr;
         auto att = critter.attitude_to( *this );
         if( att == Attitude::A_FRIENDLY ) {
             ai_cache.friends.emplace_back( g->shared_from( critter ) );
@@ -2416,7 +2424,7 @@ void npc::move_to( const tripoint &pt, bool no_bashing, std::set<tripoint> *nomo
         }
         moves -= 100;
         moved = true;
-    } else if( here.passable( p ) && !here.has_flag( "DOOR", p ) ) {
+    } else if( here.passable( p ) && !here.has_flag( ter_furn_flag_DOOR, p ) ) {
         bool diag = trigdist && posx() != p.x && posy() != p.y;
         if( is_mounted() ) {
             const double base_moves = run_cost( here.combined_movecost( pos(), p ),
@@ -2438,7 +2446,7 @@ void npc::move_to( const tripoint &pt, bool no_bashing, std::set<tripoint> *nomo
             moves -= 100;
             moved = true;
         }
-    } else if( get_dex() > 1 && here.has_flag_ter_or_furn( "CLIMBABLE", p ) &&
+    } else if( get_dex() > 1 && here.has_flag_ter_or_furn( ter_furn_flag_CLIMBABLE, p ) &&
                !ceiling_blocking_climb ) {
         ///\EFFECT_DEX_NPC increases chance to climb CLIMBABLE furniture or terrain
         int climb = get_dex();
@@ -2483,7 +2491,7 @@ void npc::move_to( const tripoint &pt, bool no_bashing, std::set<tripoint> *nomo
                 here.creature_on_trap( *mounted_creature );
             }
         }
-        if( here.has_flag( "UNSTABLE", pos() ) ) {
+        if( here.has_flag( ter_furn_flag_UNSTABLE, pos() ) ) {
             add_effect( effect_bouldering, 1_turns, bodypart_str_id::NULL_ID() );
         } else if( has_effect( effect_bouldering ) ) {
             remove_effect( effect_bouldering );
@@ -2865,7 +2873,7 @@ void npc::find_item()
         }
         auto cache_tile = [this, &abs_p, num_items, &wanted]() {
             if( wanted == nullptr ) {
-                ai_cache.searched_tiles.insert( 1000, abs_p, num_items );
+                ai_cache.searched_tiles.insert( abs_p, num_items );
             }
         };
         bool can_see = false;
@@ -2319,10 +2319,43 @@ void options_manager::add_options_debug()
 
     add_empty_line();
 
+    add( "PARALLEL_LIGHTMAP", debug, translate_marker( "Parallel lightmap" ),
+         translate_marker( "If true, light sources are cast on several threads.  The lighting is identical, but areas with many lights are processed faster on multi-core machines." ),
+         false );
+
+    add( "PARALLEL_MAP_CACHE", debug, translate_marker( "Parallel map cache" ),
+         translate_marker( "If true, the transparency, outside and floor caches of all z-levels are rebuilt on several threads.  Only has an effect with z-levels enabled." ),
+         false );
+
+    add( "PREFETCH_SUBMAPS", debug, translate_marker( "Prefetch submaps" ),
+         translate_marker( "If true, the parts of the map you are heading towards are read from disk in the background, which makes driving fast through explored areas smoother." ),
+         false );
+
+    add( "BINARY_SUBMAPS", debug, translate_marker( "Binary map saves" ),
+         translate_marker( "If true, the map of worlds using the sqlite save format is saved in a compact binary format, which is much faster to save and load.  Maps saved this way can't be loaded by older versions of the game." ),
+         false );
+
+    add( "SAVE_COMPRESSION", debug, translate_marker( "Save compression" ),
+         translate_marker( "How files of worlds using the sqlite save format are compressed.  LZ4 saves several times faster but takes more disk space, and can't be loaded by older versions of the game." ),
+    { { "zlib", translate_marker( "zlib" ) }, { "lz4-block-v1", translate_marker( "LZ4" ) } },
+    "zlib"
+       );
+
+    add( "THREAD_LIMIT", debug, translate_marker( "Thread limit" ),
+         translate_marker( "Most threads the game uses for work that runs in parallel, like generating overmaps and building map caches, the main thread included.  0 uses as many as there are processor cores.  Requires restart." ),
+         0, 256, 0
+       );
+
+    add_empty_line();
+
     add( "USE_LEGACY_PATHFINDING", debug,
          translate_marker( "Use legacy pathfinding" ),
          translate_marker( "If true, opt out of new pathfinding in favor of legacy one. This makes pathfinding mods not work." ),
          false );
+
+    add( "PATHFINDING_FLOW_FIELDS", debug, translate_marker( "Shared monster pathfinding" ),
+         translate_marker( "If true, monsters with the same goal and movement abilities follow one shared map of shortest paths instead of each finding their own route.  Greatly speeds up large hordes.  Has no effect with legacy pathfinding." ),
+         false );
 }
 
 void options_manager::add_options_world_default()
@@ -3478,6 +3511,12 @@ void options_manager::cache_to_globals()
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     overmap_transparency = ::get_option<bool>( "OVERMAP_TRANSPARENCY" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
+    parallel_lightmap = ::get_option<bool>( "PARALLEL_LIGHTMAP" );
+    parallel_map_cache = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
+    use_legacy_pathfinding = ::get_option<bool>( "USE_LEGACY_PATHFINDING" );
+    pathfinding_flow_fields = ::get_option<bool>( "PATHFINDING_FLOW_FIELDS" );
+    prefetch_submaps = ::get_option<bool>( "PREFETCH_SUBMAPS" );
+    binary_submap_saves = ::get_option<bool>( "BINARY_SUBMAPS" );
 
     merge_comestible_mode = ( [] {
         const auto opt = ::get_option<std::string>( "MERGE_COMESTIBLES" );
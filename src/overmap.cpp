@@ -6,6 +6,7 @@
 #include "overmap.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstring>
@@ -2957,6 +2958,18 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
     }
 
     layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    terrain_changed = true;
+}
+
+uint64_t overmap::get_terrain_revision() const
+{
+    if( terrain_changed ) {
+        // Overmaps are generated on several threads at once
+        static std::atomic<uint64_t> last_revision{ 0 };
+        terrain_revision = ++last_revision;
+        terrain_changed = false;
+    }
+    return terrain_revision;
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -3568,6 +3581,7 @@ void overmap::process_mongroups()
         }
         if( mg.empty() ) {
             zg.erase( it++ );
+            horde_cells.valid = false;
         } else {
             ++it;
         }
@@ -3577,6 +3591,7 @@ void overmap::process_mongroups()
 void overmap::clear_mon_groups()
 {
     zg.clear();
+    horde_cells.valid = false;
 }
 
 void overmap::clear_overmap_special_placements()
@@ -3679,27 +3694,39 @@ void mongroup::wander( const overmap &om )
 
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
-    //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
-        if( !mg.horde ) {
-            ++it;
-            continue;
-        }
+    horde_batch batch = gather_hordes();
+    measure_hordes( batch );
+    move_hordes( batch );
+}
 
-        if( mg.horde_behaviour.empty() ) {
-            mg.horde_behaviour = one_in( 2 ) ? "city" : "roam";
+overmap::horde_batch overmap::gather_hordes()
+{
+    horde_batch batch;
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        if( it->second.horde ) {
+            batch.groups.push_back( it );
         }
-
-        // Gradually decrease interest.
-        mg.dec_interest( 1 );
-
-        if( ( mg.pos.xy() == mg.target.xy() ) || mg.interest <= 15 ) {
-            mg.wander( *this );
+    }
+    batch.movement_chance.resize( batch.groups.size() );
+    batch.speed.resize( batch.groups.size() );
+    for( size_t i = 0; i < batch.groups.size(); i++ ) {
+        const mongroup &mg = batch.groups[i]->second;
+        // Groups without monsters go by their monster group definition, look that up here
+        // rather than on a worker thread
+        if( mg.monsters.empty() ) {
+            batch.speed[i] = mg.avg_speed();
         }
+    }
+    return batch;
+}
 
+void overmap::measure_hordes( horde_batch &batch ) const
+{
+    for( size_t i = 0; i < batch.groups.size(); i++ ) {
+        const mongroup &mg = batch.groups[i]->second;
+        if( !mg.monsters.empty() ) {
+            batch.speed[i] = mg.avg_speed();
+        }
         // Decrease movement chance according to the terrain we're currently on.
         const oter_id &walked_into = ter( project_to<coords::omt>( mg.pos ) );
         int movement_chance = 1;
@@ -3710,6 +3737,32 @@ void overmap::move_hordes()
         } else if( walked_into == ot_river_center ) {
             movement_chance = 10;
         }
+        batch.movement_chance[i] = movement_chance;
+    }
+}
+
+void overmap::move_hordes( horde_batch &batch )
+{
+    // The hordes that take a step, their positions and targets side by side
+    std::vector<size_t> stepping;
+    std::vector<int> x;
+    std::vector<int> y;
+    std::vector<int> target_x;
+    std::vector<int> target_y;
+    //MOVE ZOMBIE GROUPS
+    for( size_t i = 0; i < batch.groups.size(); i++ ) {
+        mongroup &mg = batch.groups[i]->second;
+
+        if( mg.horde_behaviour.empty() ) {
+            mg.horde_behaviour = one_in( 2 ) ? "city" : "roam";
+        }
+
+        // Gradually decrease interest.
+        mg.dec_interest( 1 );
+
+        if( ( mg.pos.xy() == mg.target.xy() ) || mg.interest <= 15 ) {
+            mg.wander( *this );
+        }
 
         // If the average horde speed is 50% that of normal, then the chance to
         // move should be 1/2 what it would be if the speed was 100%.
@@ -3719,30 +3772,40 @@ void overmap::move_hordes()
         // 200 or over will move at max speed, and slower hordes will move less
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
-        if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
-            // TODO: Handle moving to adjacent overmaps.
-            if( mg.pos.x() > mg.target.x() ) {
-                mg.pos.x()--;
-            }
-            if( mg.pos.x() < mg.target.x() ) {
-                mg.pos.x()++;
-            }
-            if( mg.pos.y() > mg.target.y() ) {
-                mg.pos.y()--;
-            }
-            if( mg.pos.y() < mg.target.y() ) {
-                mg.pos.y()++;
-            }
-
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( mg.pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
-        }
+        if( one_in( batch.movement_chance[i] ) && rng( 0, 100 ) < mg.interest &&
+            rng( 0, 200 ) < batch.speed[i] ) {
+            stepping.push_back( i );
+            x.push_back( mg.pos.x() );
+            y.push_back( mg.pos.y() );
+            target_x.push_back( mg.target.x() );
+            target_y.push_back( mg.target.y() );
+        }
+    }
+
+    // Every horde that moves takes one step towards its target.
+    // TODO: Handle moving to adjacent overmaps.
+    for( size_t j = 0; j < stepping.size(); j++ ) {
+        x[j] += std::clamp( target_x[j] - x[j], -1, 1 );
+        y[j] += std::clamp( target_y[j] - y[j], -1, 1 );
+    }
+    // Take the groups out and put them back under their new location once all are done,
+    // so none is moved twice. They stay where they are in memory.
+    std::vector<decltype( zg )::node_type> moved;
+    moved.reserve( stepping.size() );
+    for( size_t j = 0; j < stepping.size(); j++ ) {
+        moved.push_back( zg.extract( batch.groups[stepping[j]] ) );
+        mongroup &mg = moved.back().mapped();
+        mg.pos.x() = x[j];
+        mg.pos.y() = y[j];
+        moved.back().key() = mg.pos;
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    for( auto &node : moved ) {
+        zg.insert( std::move( node ) );
+    }
+    if( !moved.empty() ) {
+        horde_cells.valid = false;
+    }
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -3815,6 +3878,41 @@ void overmap::move_hordes()
     }
 }
 
+void overmap::index_hordes()
+{
+    constexpr int num_cells = horde_grid::cells_per_side * horde_grid::cells_per_side;
+    std::vector<mongroup *> hordes;
+    std::vector<int> cells;
+    for( auto &elem : zg ) {
+        if( elem.second.horde ) {
+            hordes.push_back( &elem.second );
+            cells.push_back( horde_grid::cell_of( elem.first.y() ) * horde_grid::cells_per_side +
+                             horde_grid::cell_of( elem.first.x() ) );
+        }
+    }
+    // Counting sort by cell, which keeps the order of zg within each cell
+    horde_cells.cell_start.assign( num_cells + 1, 0 );
+    for( const int cell : cells ) {
+        horde_cells.cell_start[cell + 1]++;
+    }
+    for( int cell = 0; cell < num_cells; cell++ ) {
+        horde_cells.cell_start[cell + 1] += horde_cells.cell_start[cell];
+    }
+    std::vector<uint32_t> next( horde_cells.cell_start.begin(), horde_cells.cell_start.end() - 1 );
+    horde_cells.x.resize( hordes.size() );
+    horde_cells.y.resize( hordes.size() );
+    horde_cells.groups.resize( hordes.size() );
+    horde_cells.order.resize( hordes.size() );
+    for( size_t i = 0; i < hordes.size(); i++ ) {
+        const uint32_t slot = next[cells[i]]++;
+        horde_cells.x[slot] = hordes[i]->pos.x();
+        horde_cells.y[slot] = hordes[i]->pos.y();
+        horde_cells.groups[slot] = hordes[i];
+        horde_cells.order[slot] = static_cast<uint32_t>( i );
+    }
+    horde_cells.valid = true;
+}
+
 /**
 * @param p location of signal relative to this overmap origin
 * @param sig_power - power of signal or max distance for reaction of zombies
@@ -3822,8 +3920,28 @@ void overmap::move_hordes()
 void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
     tripoint_om_sm p( p_rel.raw() );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    if( !horde_cells.valid ) {
+        index_hordes();
+    }
+    // Only the cells within reach of the signal, the hordes in the order of zg as before
+    std::vector<uint32_t> nearby;
+    const int min_x = horde_grid::cell_of( p.x() - sig_power );
+    const int max_x = horde_grid::cell_of( p.x() + sig_power );
+    for( int cy = horde_grid::cell_of( p.y() - sig_power );
+         cy <= horde_grid::cell_of( p.y() + sig_power ); cy++ ) {
+        for( uint32_t i = horde_cells.cell_start[cy * horde_grid::cells_per_side + min_x];
+             i < horde_cells.cell_start[cy * horde_grid::cells_per_side + max_x + 1]; i++ ) {
+            if( std::abs( horde_cells.x[i] - p.x() ) <= sig_power &&
+                std::abs( horde_cells.y[i] - p.y() ) <= sig_power ) {
+                nearby.push_back( i );
+            }
+        }
+    }
+    std::sort( nearby.begin(), nearby.end(), [this]( uint32_t l, uint32_t r ) {
+        return horde_cells.order[l] < horde_cells.order[r];
+    } );
+    for( const uint32_t i : nearby ) {
+        mongroup &mg = *horde_cells.groups[i];
         if( !mg.horde ) {
             continue;
         }
@@ -6204,6 +6322,7 @@ void overmap::save() const
 
 void overmap::add_mon_group( const mongroup &group )
 {
+    horde_cells.valid = false;
     // Monster groups: the old system had large groups (radius > 1),
     // the new system transforms them into groups of radius 1, this also
     // makes the diffuse setting obsolete (as it only controls how the radius
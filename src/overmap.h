@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
@@ -302,12 +303,23 @@ class overmap
         /** Returns the (0, 0) corner of the overmap in the global coordinates. */
         point_abs_omt global_base_point() const;
 
+        /**
+         * Changes whenever the terrain or the paths of the overmap change. No two overmaps
+         * share a revision, so caches can tell a regenerated overmap from the old one.
+         */
+        uint64_t get_terrain_revision() const;
+        /** Marks the terrain or the paths as changed, the revision moves on when it's next read. */
+        void mark_terrain_changed() {
+            terrain_changed = true;
+        }
+
         // TODO: Should depend on coordinates
         const regional_settings &get_settings() const {
             return *settings;
         }
 
         void clear_mon_groups();
+        void add_mon_group( const mongroup &group );
         void clear_overmap_special_placements();
         void clear_cities();
         void clear_connections_out();
@@ -315,6 +327,45 @@ class overmap
                                    om_direction::type dir );
     private:
         std::multimap<tripoint_om_sm, mongroup> zg;
+
+        /**
+         * Positions of the hordes in @ref zg, bucketed into a coarse grid so noise only looks
+         * at the hordes close to it. Set up on demand, and dropped whenever groups are added,
+         * removed or moved.
+         */
+        struct horde_grid {
+            static constexpr int cell_size = 16;
+            static constexpr int cells_per_side = ( OMAPX * 2 + cell_size - 1 ) / cell_size;
+
+            bool valid = false;
+            /** Cell by cell, the hordes of each cell in the order of @ref zg. */
+            std::vector<int> x;
+            std::vector<int> y;
+            std::vector<mongroup *> groups;
+            /** Position of each horde in @ref zg. */
+            std::vector<uint32_t> order;
+            /** Where the hordes of each cell start, with the end of the last one at the back. */
+            std::vector<uint32_t> cell_start;
+
+            /** Cell of a submap coordinate, the edge cells take the groups off the map. */
+            static int cell_of( int sm ) {
+                return std::clamp( sm / cell_size, 0, cells_per_side - 1 );
+            }
+        };
+        horde_grid horde_cells;
+        void index_hordes();
+
+        /** The hordes of @ref zg with what their movement depends on, one entry per horde. */
+        struct horde_batch {
+            std::vector<std::multimap<tripoint_om_sm, mongroup>::iterator> groups;
+            std::vector<int> movement_chance;
+            std::vector<float> speed;
+        };
+        horde_batch gather_hordes();
+        /** Fills in @p batch, only reads the overmap and is safe on any thread. */
+        void measure_hordes( horde_batch &batch ) const;
+        /** Rolls for and moves the hordes of @p batch, and lets zombies join hordes. */
+        void move_hordes( horde_batch &batch );
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
@@ -358,6 +409,9 @@ class overmap
 
         bool nullbool = false;
         point_abs_om loc;
+        // Generating an overmap sets a lot of terrain, so the revision is only taken when read
+        mutable uint64_t terrain_revision = 0;
+        mutable bool terrain_changed = true;
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
@@ -504,8 +558,6 @@ class overmap
         void place_mongroups();
         void place_radios();
 
-        void add_mon_group( const mongroup &group );
-
         void load_monster_groups( JsonIn &jsin );
         void load_legacy_monstergroups( JsonIn &jsin );
         void save_monster_groups( JsonOut &jo ) const;
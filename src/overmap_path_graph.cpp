@@ -0,0 +1,348 @@
+#include "overmap_path_graph.h"
+
+#include <climits>
+#include <cstdlib>
+#include <queue>
+#include <utility>
+
+#include "cata_utility.h"
+#include "line.h"
+#include "profile.h"
+
+namespace
+{
+
+constexpr int unreached = INT_MAX;
+// Past this many clusters the graph starts over instead of growing further
+constexpr size_t max_clusters = 2048;
+// Same bound as the flat search puts on the number of nodes it looks at
+constexpr size_t max_expanded = 100000;
+
+struct scored_tile {
+    int score;
+    int cost;
+    tripoint_abs_omt pos;
+    bool operator>( const scored_tile &other ) const {
+        return score > other.score;
+    }
+};
+
+} // namespace
+
+const std::array<point, 4> overmap_path_graph::sides = {
+    point_east, point_south, point_west, point_north
+};
+
+overmap_path_graph::overmap_path_graph( cost_fn cost, ramp_fn ramp, revision_fn revision )
+    : cost_of( std::move( cost ) ), is_ramp( std::move( ramp ) ),
+      revision_of( std::move( revision ) )
+{
+}
+
+point overmap_path_graph::cluster_of( const tripoint_abs_omt &p )
+{
+    return point( divide_round_down( p.x(), cluster_size ),
+                  divide_round_down( p.y(), cluster_size ) );
+}
+
+int overmap_path_graph::tile_index( const tripoint_abs_omt &p )
+{
+    const point c = cluster_of( p );
+    const int x = p.x() - c.x * cluster_size;
+    const int y = p.y() - c.y * cluster_size;
+    return ( ( p.z() - min_z ) * cluster_size + y ) * cluster_size + x;
+}
+
+tripoint_abs_omt overmap_path_graph::tile_at( const point &c, const int index )
+{
+    const int x = index % cluster_size;
+    const int y = index / cluster_size % cluster_size;
+    const int z = index / ( cluster_size * cluster_size );
+    return tripoint_abs_omt( c.x * cluster_size + x, c.y * cluster_size + y, min_z + z );
+}
+
+overmap_path_graph::cluster &overmap_path_graph::with_costs( const point &c )
+{
+    cluster &cl = clusters[c];
+    const point_abs_omt origin( c * cluster_size );
+    const uint64_t revision = revision_of( project_to<coords::om>( origin ) );
+    if( cl.version != 0 && cl.revision == revision ) {
+        return cl;
+    }
+    cl.revision = revision;
+    cl.version = ++last_version;
+    cl.linked = false;
+    cl.costs.resize( tiles_per_cluster );
+    cl.ramps.resize( tiles_per_cluster );
+    for( int i = 0; i < tiles_per_cluster; i++ ) {
+        const tripoint_abs_omt p = tile_at( c, i );
+        cl.costs[i] = cost_of( p );
+        cl.ramps[i] = cl.costs[i] >= 0 && is_ramp( p );
+    }
+    return cl;
+}
+
+overmap_path_graph::cluster &overmap_path_graph::with_nodes( const point &c )
+{
+    cluster &cl = with_costs( c );
+    std::array<uint64_t, 4> versions;
+    for( size_t side = 0; side < sides.size(); side++ ) {
+        versions[side] = with_costs( c + sides[side] ).version;
+    }
+    if( !cl.linked || cl.neighbour_versions != versions ) {
+        cl.neighbour_versions = versions;
+        link( c, cl );
+    }
+    return cl;
+}
+
+void overmap_path_graph::link( const point &c, cluster &cl )
+{
+    ZoneScoped;
+    cl.nodes.clear();
+    cl.node_at.assign( tiles_per_cluster, -1 );
+    cl.routes.clear();
+    cl.exits.clear();
+    const auto add_exit = [&cl]( const int tile, const int side ) {
+        if( cl.node_at[tile] < 0 ) {
+            cl.node_at[tile] = static_cast<int>( cl.nodes.size() );
+            cl.nodes.push_back( tile );
+            cl.exits.emplace_back();
+        }
+        cl.exits[cl.node_at[tile]].push_back( side );
+    };
+    // Tile at position i along the border on the given side, of this cluster or the neighbour
+    const auto border_tile = []( const point & side, const int i, const int z, const bool far ) {
+        const int sign = far ? -1 : 1;
+        const auto edge = []( const int dir ) {
+            return dir > 0 ? cluster_size - 1 : 0;
+        };
+        const point local = side.x != 0 ? point( edge( side.x * sign ), i ) :
+                            point( i, edge( side.y * sign ) );
+        return ( z * cluster_size + local.y ) * cluster_size + local.x;
+    };
+
+    // The neighbour finds the same entrances on its side, it looks at the same costs
+    for( size_t side = 0; side < sides.size(); side++ ) {
+        const cluster &other = clusters.at( c + sides[side] );
+        for( int z = 0; z < layers; z++ ) {
+            int opening = -1;
+            for( int i = 0; i <= cluster_size; i++ ) {
+                const bool open = i < cluster_size &&
+                                  cl.costs[border_tile( sides[side], i, z, false )] >= 0 &&
+                                  other.costs[border_tile( sides[side], i, z, true )] >= 0;
+                if( open && opening < 0 ) {
+                    opening = i;
+                } else if( !open && opening >= 0 ) {
+                    // Wide openings get an entrance at either end, narrow ones one in the middle
+                    const int width = i - opening;
+                    if( width >= 6 ) {
+                        add_exit( border_tile( sides[side], opening, z, false ), side );
+                        add_exit( border_tile( sides[side], i - 1, z, false ), side );
+                    } else {
+                        add_exit( border_tile( sides[side], opening + width / 2, z, false ), side );
+                    }
+                    opening = -1;
+                }
+            }
+        }
+    }
+
+    std::vector<int> dist;
+    cl.routes.resize( cl.nodes.size() );
+    for( size_t from = 0; from < cl.nodes.size(); from++ ) {
+        search( cl, cl.nodes[from], false, -1, dist );
+        for( size_t to = 0; to < cl.nodes.size(); to++ ) {
+            if( to != from && dist[cl.nodes[to]] != unreached ) {
+                cl.routes[from].emplace_back( static_cast<int>( to ), dist[cl.nodes[to]] );
+            }
+        }
+    }
+    cl.linked = true;
+}
+
+void overmap_path_graph::search( const cluster &cl, const int start, const bool reverse,
+                                 const int free_tile, std::vector<int> &dist,
+                                 std::vector<int> *prev, const int target )
+{
+    dist.assign( tiles_per_cluster, unreached );
+    if( prev != nullptr ) {
+        prev->assign( tiles_per_cluster, -1 );
+    }
+    using entry = std::pair<int, int>;
+    std::priority_queue<entry, std::vector<entry>, std::greater<>> open;
+    dist[start] = 0;
+    open.emplace( 0, start );
+    while( !open.empty() ) {
+        const auto [cost, tile] = open.top();
+        open.pop();
+        if( cost > dist[tile] ) {
+            continue;
+        }
+        if( tile == target ) {
+            return;
+        }
+        const auto relax = [&]( const int next, const bool z_change ) {
+            // Going forward the current tile is left, going backward the next one
+            const int left = reverse ? next : tile;
+            if( next != free_tile && cl.costs[next] < 0 ) {
+                return;
+            }
+            if( z_change && !cl.ramps[left] ) {
+                return;
+            }
+            const int next_cost = cost + ( left == free_tile ? 0 : cl.costs[left] );
+            if( next_cost < dist[next] ) {
+                dist[next] = next_cost;
+                if( prev != nullptr ) {
+                    ( *prev )[next] = tile;
+                }
+                open.emplace( next_cost, next );
+            }
+        };
+        const int x = tile % cluster_size;
+        const int y = tile / cluster_size % cluster_size;
+        const int z = tile / ( cluster_size * cluster_size );
+        if( x > 0 ) {
+            relax( tile - 1, false );
+        }
+        if( x < cluster_size - 1 ) {
+            relax( tile + 1, false );
+        }
+        if( y > 0 ) {
+            relax( tile - cluster_size, false );
+        }
+        if( y < cluster_size - 1 ) {
+            relax( tile + cluster_size, false );
+        }
+        if( z > 0 ) {
+            relax( tile - cluster_size * cluster_size, true );
+        }
+        if( z < layers - 1 ) {
+            relax( tile + cluster_size * cluster_size, true );
+        }
+    }
+}
+
+std::optional<std::vector<tripoint_abs_omt>> overmap_path_graph::find_path(
+            const tripoint_abs_omt &source, const tripoint_abs_omt &dest, const int radius )
+{
+    const auto covered = []( const tripoint_abs_omt & p ) {
+        return p.z() >= min_z && p.z() <= max_z;
+    };
+    if( !covered( source ) || !covered( dest ) ||
+        octile_dist( source.xy().raw(), dest.xy().raw() ) < 2 * cluster_size ) {
+        return std::nullopt;
+    }
+    ZoneScoped;
+    if( clusters.size() > max_clusters ) {
+        clusters.clear();
+    }
+
+    std::vector<tripoint_abs_omt> path;
+    const point source_c = cluster_of( source );
+    const point dest_c = cluster_of( dest );
+    const int source_tile = tile_index( source );
+    const int dest_tile = tile_index( dest );
+    const cluster &source_cl = with_nodes( source_c );
+    const cluster &dest_cl = with_nodes( dest_c );
+    if( dest_cl.costs[dest_tile] < 0 ) {
+        return path;
+    }
+    // Leaving the source is free, like in the flat search
+    std::vector<int> from_source;
+    std::vector<int> to_dest;
+    search( source_cl, source_tile, false, source_tile, from_source );
+    search( dest_cl, dest_tile, true, source_c == dest_c ? source_tile : -1, to_dest );
+
+    struct visit {
+        int cost;
+        tripoint_abs_omt prev;
+    };
+    std::unordered_map<tripoint_abs_omt, visit> visits;
+    std::priority_queue<scored_tile, std::vector<scored_tile>, std::greater<>> open;
+    const auto reach = [&]( const tripoint_abs_omt & p, const int cost,
+    const tripoint_abs_omt & prev ) {
+        if( octile_dist( source.xy().raw(), p.xy().raw() ) > radius ) {
+            return;
+        }
+        const auto iter = visits.find( p );
+        if( iter != visits.end() && iter->second.cost <= cost ) {
+            return;
+        }
+        visits.insert_or_assign( p, visit{ cost, prev } );
+        const int estimate = octile_dist( p.xy().raw(), dest.xy().raw(), 10 ) +
+                             std::abs( p.z() - dest.z() ) * 10;
+        open.push( scored_tile{ cost + estimate, cost, p } );
+    };
+
+    visits.emplace( source, visit{ 0, source } );
+    open.push( scored_tile{ 0, 0, source } );
+    for( const int tile : source_cl.nodes ) {
+        if( from_source[tile] != unreached ) {
+            reach( tile_at( source_c, tile ), from_source[tile], source );
+        }
+    }
+    if( source_c == dest_c && from_source[dest_tile] != unreached ) {
+        reach( dest, from_source[dest_tile], source );
+    }
+
+    bool found = false;
+    size_t expanded = 0;
+    while( !open.empty() && expanded++ < max_expanded ) {
+        const scored_tile cur = open.top();
+        open.pop();
+        if( cur.cost > visits.at( cur.pos ).cost ) {
+            continue;
+        }
+        if( cur.pos == dest ) {
+            found = true;
+            break;
+        }
+        const point c = cluster_of( cur.pos );
+        const cluster &cl = with_nodes( c );
+        const int tile = tile_index( cur.pos );
+        if( c == dest_c && to_dest[tile] != unreached ) {
+            reach( dest, cur.cost + to_dest[tile], cur.pos );
+        }
+        const int node = cl.node_at[tile];
+        if( node < 0 ) {
+            continue;
+        }
+        for( const std::pair<int, int> &route : cl.routes[node] ) {
+            reach( tile_at( c, cl.nodes[route.first] ), cur.cost + route.second, cur.pos );
+        }
+        const int leave_cost = cur.pos == source ? 0 : cl.costs[tile];
+        for( const int side : cl.exits[node] ) {
+            reach( cur.pos + sides[side], cur.cost + leave_cost, cur.pos );
+        }
+    }
+    if( !found ) {
+        // Giving up isn't the same as there being no route, let the caller search itself
+        if( !open.empty() ) {
+            return std::nullopt;
+        }
+        return path;
+    }
+
+    // Fill in the tiles between the nodes, the route between two nodes of a cluster stays
+    // inside it and nodes in different clusters are next to each other
+    std::vector<int> dist;
+    std::vector<int> prev;
+    path.push_back( dest );
+    for( tripoint_abs_omt to = dest; to != source; ) {
+        const tripoint_abs_omt from = visits.at( to ).prev;
+        if( cluster_of( from ) == cluster_of( to ) ) {
+            const point c = cluster_of( from );
+            const int from_tile = tile_index( from );
+            const int free_tile = from == source ? source_tile : -1;
+            search( with_nodes( c ), from_tile, false, free_tile, dist, &prev, tile_index( to ) );
+            for( int tile = prev[tile_index( to )]; tile != from_tile; tile = prev[tile] ) {
+                path.push_back( tile_at( c, tile ) );
+            }
+        }
+        path.push_back( from );
+        to = from;
+    }
+    return path;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "coordinates.h"
+#include "point.h"
+
+/**
+ * Coarse graph over the overmap for hierarchical path finding (HPA*) with one cost profile.
+ *
+ * The overmap is cut into square clusters. Wherever passable terrain crosses the border of
+ * two clusters there is an entrance, a node on either side of the border, and the nodes of
+ * a cluster are linked by the cheapest routes between them that stay inside the cluster.
+ * Long routes are searched on these nodes first and then refined cluster by cluster, so only
+ * the clusters along the route are ever looked at tile by tile.
+ *
+ * Clusters are set up the first time a search reaches them. Each remembers the terrain
+ * revision of its overmap and is set up anew once the terrain has changed.
+ *
+ * Only the surface and the level above it, where the bridges are, take part. Routes that
+ * start or end elsewhere, or are short enough for a flat search, are not covered.
+ */
+class overmap_path_graph
+{
+    public:
+        /** Cost of leaving the tile, negative if it can't be entered. */
+        using cost_fn = std::function<int( const tripoint_abs_omt & )>;
+        /** Whether routes may go up or down from the tile. */
+        using ramp_fn = std::function<bool( const tripoint_abs_omt & )>;
+        /** Terrain revision of the overmap, 0 if it doesn't exist. */
+        using revision_fn = std::function<uint64_t( const point_abs_om & )>;
+
+        /** Width of a cluster in overmap terrain, overmaps are made up of whole clusters. */
+        static constexpr int cluster_size = 20;
+        static constexpr int min_z = 0;
+        static constexpr int max_z = 1;
+
+        overmap_path_graph( cost_fn cost, ramp_fn ramp, revision_fn revision );
+
+        /**
+         * Finds a route like @ref pf::find_overmap_path does, destination first, or nothing
+         * if there is none within @p radius of the source. Returns std::nullopt for routes
+         * the graph doesn't cover and when the search gives up before finding either.
+         */
+        std::optional<std::vector<tripoint_abs_omt>> find_path( const tripoint_abs_omt &source,
+                const tripoint_abs_omt &dest, int radius );
+
+        /** Number of clusters that are set up, for tests. */
+        size_t cluster_count() const {
+            return clusters.size();
+        }
+
+    private:
+        static constexpr int layers = max_z - min_z + 1;
+        static constexpr int tiles_per_cluster = cluster_size * cluster_size * layers;
+        /** Neighbouring clusters, in the order of @ref cluster::neighbour_versions. */
+        static const std::array<point, 4> sides;
+
+        struct cluster {
+            /** Terrain revision of the overmap the costs were read at. */
+            uint64_t revision = 0;
+            /** Changes whenever the costs are read anew, 0 before they are read. */
+            uint64_t version = 0;
+            std::vector<int> costs;
+            std::vector<bool> ramps;
+
+            /** The nodes below are up to date with the costs of these clusters. */
+            bool linked = false;
+            std::array<uint64_t, 4> neighbour_versions = {};
+            /** Tile of every node, and the node of every tile (-1 for none). */
+            std::vector<int> nodes;
+            std::vector<int> node_at;
+            /** Cheapest routes from each node to the other ones, as node and cost. */
+            std::vector<std::vector<std::pair<int, int>>> routes;
+            /** Sides each node has an entrance on. */
+            std::vector<std::vector<int>> exits;
+        };
+
+        cost_fn cost_of;
+        ramp_fn is_ramp;
+        revision_fn revision_of;
+        std::unordered_map<point, cluster> clusters;
+        uint64_t last_version = 0;
+
+        static point cluster_of( const tripoint_abs_omt &p );
+        static int tile_index( const tripoint_abs_omt &p );
+        static tripoint_abs_omt tile_at( const point &c, int index );
+
+        /** The cluster with its costs up to date. */
+        cluster &with_costs( const point &c );
+        /** The cluster with its costs and nodes up to date. */
+        cluster &with_nodes( const point &c );
+        void link( const point &c, cluster &cl );
+
+        /**
+         * Cheapest costs inside the cluster from @p start to every tile, or from every tile
+         * to @p start if @p reverse is set. Leaving @p free_tile costs nothing. Stops once
+         * @p target is reached if it's set, @p prev then leads back from it to @p start.
+         */
+        static void search( const cluster &cl, int start, bool reverse, int free_tile,
+                            std::vector<int> &dist, std::vector<int> *prev = nullptr,
+                            int target = -1 );
+};
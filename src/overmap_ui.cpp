@@ -1906,7 +1906,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
         params = overmap_path_params::for_player();
         const oter_id dest_ter = overmap_buffer.ter_existing( dest );
         // already in water or going to a water tile
-        if( here.has_flag( "SWIMMABLE", player_character.pos() ) || is_river_or_lake( dest_ter ) ) {
+        if( here.has_flag( TER_FURN_FLAG( "SWIMMABLE" ), player_character.pos() ) || is_river_or_lake( dest_ter ) ) {
             params.water_cost = 100;
         }
     }
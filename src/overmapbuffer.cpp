@@ -1,15 +1,18 @@
 #include "overmapbuffer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <climits>
 #include <cstdint>
+#include <deque>
 #include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <queue>
-#include <future>
+#include <thread>
 
 #include "avatar.h"
 #include "calendar.h"
@@ -34,6 +37,7 @@
 #include "npc.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_path_graph.h"
 #include "overmap_special.h"
 #include "overmap_types.h"
 #include "popup.h"
@@ -42,6 +46,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_utils.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
@@ -121,34 +126,33 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
 {
     using overmap_loc = std::pair<point_abs_om, std::unique_ptr<overmap>>;
 
-    std::vector<std::future<overmap_loc>> async_data;
+    std::vector<overmap_loc> generated;
     for( auto &loc : locs ) {
-        if( overmap_buffer.has( loc ) ) {
-            continue;
+        if( !overmap_buffer.has( loc ) ) {
+            generated.emplace_back( loc, nullptr );
         }
+    }
 
-        auto gen_func = [&]() {
-            auto map = std::make_unique<overmap>( loc );
+    task_group group;
+    for( overmap_loc &entry : generated ) {
+        group.run( [this, &entry]() {
+            auto map = std::make_unique<overmap>( entry.first );
             map->populate();
             fix_mongroups( *map );
             fix_npcs( *map );
-            return std::make_pair( loc, std::move( map ) );
-        };
-        async_data.push_back( std::async( std::launch::async, gen_func ) );
+            entry.second = std::move( map );
+        } );
     }
 
     auto popup = make_shared_fast<throbber_popup>( _( "Please wait..." ) );
-    for( auto &f : async_data ) {
-        while( f.wait_for( std::chrono::milliseconds( 10 ) ) != std::future_status::ready ) {
-            popup->refresh();
-        }
-    }
+    group.wait( [&popup]() {
+        popup->refresh();
+    } );
 
     {
         write_lock<std::shared_mutex> _l( mutex );
-        for( auto &m : async_data ) {
-            auto result = m.get();
-            overmaps[result.first] = std::move( result.second );
+        for( overmap_loc &entry : generated ) {
+            overmaps[entry.first] = std::move( entry.second );
         }
     }
 }
@@ -161,6 +165,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
             new_overmap.zg.erase( it++ );
+            new_overmap.horde_cells.valid = false;
             continue;
         }
         // Inside the bounds of the overmap?
@@ -183,6 +188,7 @@ void overmapbuffer::fix_mongroups( overmap &new_overmap )
         mg.pos = tripoint_om_sm( sm_rem, mg.pos.z() );
         om.add_mon_group( mg );
         new_overmap.zg.erase( it++ );
+        new_overmap.horde_cells.valid = false;
     }
 }
 
@@ -255,6 +261,7 @@ void overmapbuffer::clear()
     overmaps.clear();
     known_non_existing.clear();
     placed_unique_specials.clear();
+    path_graphs.clear();
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -460,6 +467,7 @@ void overmapbuffer::toggle_path( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
     om_loc.om->path( om_loc.local ) = !om_loc.om->path( om_loc.local );
+    om_loc.om->mark_terrain_changed();
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -563,8 +571,20 @@ void overmapbuffer::move_hordes()
     const auto radius = MAPSIZE * 2;
     // TODO: fix point types
     const tripoint_abs_sm center( get_player_character().global_sm_location() );
-    for( auto &om : get_overmaps_near( center, radius ) ) {
-        om->move_hordes();
+    const std::vector<overmap *> near = get_overmaps_near( center, radius );
+    // Gather the hordes of all overmaps and size them up one overmap per task, sizing up a
+    // single horde is too little work to hand to another thread. The rolls and the moves
+    // then happen in order on this thread.
+    std::vector<overmap::horde_batch> batches;
+    batches.reserve( near.size() );
+    for( overmap *om : near ) {
+        batches.push_back( om->gather_hordes() );
+    }
+    get_thread_pool().parallel_for( near.size(), [&]( size_t om ) {
+        near[om]->measure_hordes( batches[om] );
+    } );
+    for( size_t om = 0; om < near.size(); om++ ) {
+        near[om]->move_hordes( batches[om] );
     }
 }
 
@@ -894,10 +914,36 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     };
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
+    // What the player knows and thinks is dangerous changes all the time, the graph only
+    // keeps up with the terrain
+    if( !params.only_known_by_player && !params.avoid_danger ) {
+        std::optional<std::vector<tripoint_abs_omt>> path = path_graph_for( params ).find_path( src,
+                dest, radius );
+        if( path ) {
+            return *path;
+        }
+    }
     const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
     return path.points;
 }
 
+overmap_path_graph &overmapbuffer::path_graph_for( const overmap_path_params &params )
+{
+    for( auto &graph : path_graphs ) {
+        if( graph.first == params ) {
+            return *graph.second;
+        }
+    }
+    auto graph = std::make_unique<overmap_path_graph>( [params]( const tripoint_abs_omt & p ) {
+        return get_terrain_cost( p, params );
+    }, is_ramp, [this]( const point_abs_om & p ) -> uint64_t {
+        const overmap *om = get_existing( p );
+        return om != nullptr ? om->get_terrain_revision() : 0;
+    } );
+    path_graphs.emplace_back( params, std::move( graph ) );
+    return *path_graphs.back().second;
+}
+
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                                   const omt_route_params &params )
 {
@@ -1142,8 +1188,7 @@ struct find_task_generator {
 std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
-    const auto concurrency = std::max( 1u, std::thread::hardware_concurrency() - 1 );
-    if( concurrency == 1 ) {
+    if( get_thread_pool().concurrency() == 1 ) {
         return find_all_sync( origin, params );
     } else {
         return find_all_async( origin, params );
@@ -1222,19 +1267,23 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
 
     find_task_generator gen( origin.raw().xy(), min_dist, max_dist, min_layer, max_layer, 256 );
 
-    std::deque<std::future<std::vector<tripoint_abs_omt>>> tasks;
+    // Results of the queued searches, collected in the order they were queued
+    struct find_task {
+        std::vector<tripoint_abs_omt> result;
+        std::atomic<bool> done{ false };
+    };
+    std::deque<std::shared_ptr<find_task>> tasks;
+    task_group group;
 
     std::vector<tripoint_abs_omt> find_result;
-    int free_tasks = std::max( 1u, std::thread::hardware_concurrency() - 1 );
-    auto try_finish_task = []( std::future<std::vector<tripoint_abs_omt>> &task,
-    std::vector<tripoint_abs_omt> &dst, omt_find_params params ) -> bool {
-        if( task.wait_for( std::chrono::milliseconds( 0 ) ) == std::future_status::ready )
+    size_t free_tasks = std::max<size_t>( 1, get_thread_pool().concurrency() - 1 );
+    auto try_finish_task = []( find_task & task, std::vector<tripoint_abs_omt> &dst,
+    const omt_find_params & params ) -> bool {
+        if( task.done )
         {
-            auto task_result = task.get();
-
             if( !params.max_results.has_value() ||
                 dst.size() < static_cast<size_t>( params.max_results.value() ) ) {
-                std::ranges::copy( task_result, std::back_inserter( dst ) );
+                std::ranges::copy( task.result, std::back_inserter( dst ) );
                 if( params.max_results.has_value() &&
                     dst.size() > static_cast<uint64_t>( params.max_results.value() ) ) {
                     dst.resize( params.max_results.value() );
@@ -1245,6 +1294,12 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
         }
         return false;
     };
+    // Helps with queued work instead of spinning while the searches run
+    auto wait_a_bit = []() {
+        if( !get_thread_pool().run_one_task() ) {
+            std::this_thread::yield();
+        }
+    };
 
     while( true ) {
         if( params.popup ) {
@@ -1252,7 +1307,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
         }
 
         if( !tasks.empty() ) {
-            if( try_finish_task( tasks.front(), find_result, params ) ) {
+            if( try_finish_task( *tasks.front(), find_result, params ) ) {
                 tasks.pop_front();
                 ++free_tasks;
             }
@@ -1263,6 +1318,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
         }
 
         if( free_tasks == 0 ) {
+            wait_a_bit();
             continue;
         }
 
@@ -1277,35 +1333,32 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             continue;
         }
 
-        auto task_func = [&]( point_abs_om l,
-        std::vector<std::pair<tripoint_abs_omt, tripoint_om_omt>> locals ) {
-            std::vector<tripoint_abs_omt> result;
-
+        auto task = std::make_shared<find_task>();
+        group.run( [this, &params, task, l = task_om, locals = std::move( task_omts )]() {
+            // Mark it done even if the search throws, the error comes out of group.wait()
+            on_out_of_scope mark_done( [&task]() {
+                task->done = true;
+            } );
             overmap *om_loc;
             if( params.existing_only ) {
                 om_loc = get_existing( l );
             } else {
                 om_loc = &get( l );
             }
-            if( !om_loc ) {
-                return result;
-            }
-
-            for( const auto &loc : locals ) {
-                overmap_with_local_coords q{ om_loc, loc.second };
-                if( is_findable_location( q, params ) ) {
-                    result.push_back( loc.first );
-                }
-                if( params.max_results.has_value() &&
-                    result.size() == static_cast<uint64_t>( params.max_results.value() ) ) {
-                    break;
+            if( om_loc ) {
+                std::vector<tripoint_abs_omt> &result = task->result;
+                for( const auto &loc : locals ) {
+                    overmap_with_local_coords q{ om_loc, loc.second };
+                    if( is_findable_location( q, params ) ) {
+                        result.push_back( loc.first );
+                    }
+                    if( params.max_results.has_value() &&
+                        result.size() == static_cast<uint64_t>( params.max_results.value() ) ) {
+                        break;
+                    }
                 }
             }
-
-            return result;
-        };
-
-        auto task = std::async( std::launch::async, task_func, task_om, std::move( task_omts ) );
+        } );
 
         tasks.push_back( std::move( task ) );
 
@@ -1317,11 +1370,14 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             params.popup->refresh();
         }
 
-        if( try_finish_task( tasks.front(), find_result, params ) ) {
+        if( try_finish_task( *tasks.front(), find_result, params ) ) {
             tasks.pop_front();
             ++free_tasks;
+        } else {
+            wait_a_bit();
         }
     }
+    group.wait();
 
     return find_result;
 }
@@ -27,6 +27,7 @@ class map_extra;
 class monster;
 class npc;
 class overmap;
+class overmap_path_graph;
 class overmap_special;
 class overmap_special_batch;
 class throbber_popup;
@@ -58,6 +59,8 @@ struct overmap_path_params {
     bool only_known_by_player = true;
 
     static constexpr int standard_cost = 10;
+
+    bool operator==( const overmap_path_params & ) const = default;
     static overmap_path_params for_player();
     static overmap_path_params for_npc();
     static overmap_path_params for_land_vehicle( float offroad_coeff, bool tiny, bool amphibious );
@@ -508,6 +511,10 @@ class overmapbuffer
 
     private:
         std::shared_mutex mutex;
+        /** Graphs for hierarchical path finding, one per cost profile. */
+        using path_graph_entry = std::pair<overmap_path_params, std::unique_ptr<overmap_path_graph>>;
+        std::vector<path_graph_entry> path_graphs;
+        overmap_path_graph &path_graph_for( const overmap_path_params &params );
         /**
          * Common function used by the find_closest/all/random to determine if the location is
          * findable based on the specified criteria.
@@ -1,11 +1,13 @@
 #include "pathfinding.h"
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <vector>
 
+#include "cuboid_rectangle.h"
 #include "game.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -17,6 +19,8 @@
 #include "vehicle_part.h"
 #include "vpart_position.h"
 
+static const ter_furn_flag_id ter_furn_flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+
 static constexpr std::array<point, 8> DIRS_2D = {
     point_north_east,
     point_north_west,
@@ -34,6 +38,7 @@ decltype( Pathfinding::z_area ) Pathfinding::z_area = {};
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
 decltype( Pathfinding::cached_closest_z_changes ) Pathfinding::cached_closest_z_changes = {};
+decltype( Pathfinding::d_maps_area ) Pathfinding::d_maps_area = {};
 
 // Thanks for nothing, MVSC
 // For our MVSC builds, std::is_nan and std::is_inf are not constexpr
@@ -197,20 +202,115 @@ void Pathfinding::produce_d_map( point dest, int z, PathfindingSettings settings
 
     Pathfinding::d_maps.push_back( std::move( d_map ) );
 }
-void Pathfinding::clear_d_maps()
+Pathfinding *Pathfinding::get_d_map( const point &dest, const int z,
+                                     const PathfindingSettings &settings )
 {
-    for( auto &map : Pathfinding::d_maps ) {
+    // Local coords of all d_maps are off once the map shifts
+    point cur_area = get_map().get_abs_sub().xy();
+    sm_to_ms( cur_area );
+    if( cur_area != Pathfinding::d_maps_area ) {
+        Pathfinding::clear_d_maps();
+        Pathfinding::d_maps_area = cur_area;
+    }
+
+    auto d_map_it = std::ranges::find_if(
+                        Pathfinding::d_maps,
+    [&dest, &settings, z]( auto & map ) {
+        return map->dest == dest && map->z == z && map->settings == settings;
+    } );
+
+    Pathfinding *d_map;
+    if( d_map_it == Pathfinding::d_maps.end() ) {
+        Pathfinding::produce_d_map( dest, z, settings );
+        d_map = Pathfinding::d_maps.back().get();
+    } else {
+        d_map = d_map_it->get();
+    }
+    d_map->is_used_this_turn = true;
+
+    return d_map;
+}
+void Pathfinding::release_d_maps( const std::function<bool( const Pathfinding & )> &predicate )
+{
+    std::erase_if( Pathfinding::d_maps, [&predicate]( std::unique_ptr<Pathfinding> &map ) {
+        if( !predicate( *map ) ) {
+            return false;
+        }
         map->reset_maps();
         map->reset_tile_state();
         map->unbiased_frontier.clear();
         map->forbidden_moves.clear();
         map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
         map->is_explored = false;
+        map->is_used_this_turn = false;
+        map->is_repair_needed = false;
         Pathfinding::d_maps_store.push_back( std::move( map ) );
+        return true;
+    } );
+}
+void Pathfinding::clear_d_maps()
+{
+    Pathfinding::release_d_maps( []( const Pathfinding & ) {
+        return true;
+    } );
+    Pathfinding::cached_closest_z_changes.clear();
+}
+void Pathfinding::prune_d_maps()
+{
+    Pathfinding::release_d_maps( []( const Pathfinding & map ) {
+        // Critters move around every turn, so maps that avoid them can't be reused
+        return !map.is_used_this_turn || map.settings.mob_presence_penalty > 0;
+    } );
+
+    for( auto &map : Pathfinding::d_maps ) {
+        map->is_used_this_turn = false;
+        // Every rebuild visits the same tiles again, don't let the reset list grow without bound
+        if( map->map_modify_set.size() > MAPSIZE_X * MAPSIZE_Y ) {
+            std::vector<point> &modified = map->map_modify_set;
+            std::sort( modified.begin(), modified.end() );
+            modified.erase( std::unique( modified.begin(), modified.end() ), modified.end() );
+        }
     }
-    Pathfinding::d_maps.clear();
+    // Z-level changes are rescanned on terrain changes, don't trust the closest ones found this turn
     Pathfinding::cached_closest_z_changes.clear();
 }
+void Pathfinding::mark_dirty_tile( const tripoint &p )
+{
+    for( auto &map : Pathfinding::d_maps ) {
+        if( map->z == p.z && map->invalidate_around( p.xy() ) ) {
+            map->is_repair_needed = true;
+        }
+    }
+}
+void Pathfinding::mark_dirty_z_level( const int z )
+{
+    Pathfinding::release_d_maps( [z]( const Pathfinding & map ) {
+        return map.z == z;
+    } );
+}
+bool Pathfinding::invalidate_around( const point &p )
+{
+    // A tile's g-value depends on its own contents and on vehicles and roofs next to it
+    const inclusive_rectangle<point> affected( p - point_south_east, p + point_south_east );
+
+    bool was_visited = false;
+    for( int y = std::max( affected.p_min.y, 0 ); y <= std::min( affected.p_max.y, MAPSIZE_Y - 1 ); y++ ) {
+        for( int x = std::max( affected.p_min.x, 0 ); x <= std::min( affected.p_max.x, MAPSIZE_X - 1 ); x++ ) {
+            const point cur( x, y );
+            if( cur == this->dest ) {
+                continue;
+            }
+            was_visited |= this->tile_state_at( cur ) != State::UNVISITED;
+            this->g_at( cur ) = 0.0;
+        }
+    }
+
+    std::erase_if( this->forbidden_moves, [&affected]( const std::pair<point, point> &move ) {
+        return affected.contains( move.first ) || affected.contains( move.second );
+    } );
+
+    return was_visited;
+}
 void Pathfinding::reset_maps()
 {
     this->p_at( this->dest ) = 0.0;
@@ -473,11 +573,13 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
         return ExpansionOutcome::PATH_FOUND;
     }
 
-    const bool rebuild_needed = this->domain == MapDomain::ABSOLUTE_DOMAIN ?
-                                // Do not rebuild only if and only if
-                                //   cur domain is absolute and we are searching in absolute domain as well
-                                route_settings.is_relative_search_domain() :
-                                true;
+    const bool rebuild_needed = this->is_repair_needed ||
+                                ( this->domain == MapDomain::ABSOLUTE_DOMAIN ?
+                                  // Do not rebuild only if and only if
+                                  //   cur domain is absolute and we are searching in absolute domain as well
+                                  route_settings.is_relative_search_domain() :
+                                  true );
+    this->is_repair_needed = false;
 
     this->domain = route_settings.is_relative_search_domain() ?
                    MapDomain::RELATIVE_DOMAIN :
@@ -509,6 +611,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     } else {
         // Only reset tile state, we will reuse already calculated g-values
         this->reset_tile_state();
+        this->is_explored = false;
 
         biased_frontier.emplace( this->get_f_biased( this->dest, start, route_settings.h_coeff ),
                                  this->dest );
@@ -700,8 +803,8 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                     }
                     if( is_door && can_open_doors ) {
                         // Doors that can only be open from the inside
-                        const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                                            furniture.has_flag( "OPENCLOSE_INSIDE" );
+                        const bool door_opens_from_inside = terrain.has_flag( ter_furn_flag_OPENCLOSE_INSIDE ) ||
+                                                            furniture.has_flag( ter_furn_flag_OPENCLOSE_INSIDE );
                         const bool is_cur_point_inside = !here.is_outside( cur_point );
                         const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
                         if( valid_to_open ) {
@@ -801,19 +904,7 @@ std::vector<tripoint> Pathfinding::get_route_2d(
         return std::vector<tripoint> { tripoint( from, z ), tripoint( to, z ) };
     }
 
-    auto d_map_it = std::ranges::find_if(
-                        Pathfinding::d_maps,
-    [&to, &path_settings, z]( auto & map ) {
-        return map->dest == to && map->z == z && map->settings == path_settings;
-    } );
-
-    Pathfinding *d_map;
-    if( d_map_it == Pathfinding::d_maps.end() ) {
-        Pathfinding::produce_d_map( to, z, path_settings );
-        d_map = Pathfinding::d_maps.back().get();
-    } else {
-        d_map = d_map_it->get();
-    }
+    Pathfinding *d_map = Pathfinding::get_d_map( to, z, path_settings );
 
     if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
         // This should only fail if max f-limit is failed
@@ -1093,3 +1184,57 @@ std::vector<tripoint> Pathfinding::route(
     }
     return Pathfinding::get_route_3d( from, to, path_settings, route_settings );
 };
+
+std::optional<tripoint> Pathfinding::flow_field_step(
+    tripoint from, tripoint to,
+    const PathfindingSettings &path_settings,
+    const RouteSettings &route_settings )
+{
+    const map &here = get_map();
+
+    here.clip_to_bounds( from );
+    here.clip_to_bounds( to );
+
+    if( from.z != to.z || rl_dist_exact( from, to ) > route_settings.max_dist ) {
+        return std::nullopt;
+    }
+    if( from == to ) {
+        return to;
+    }
+
+    // The field must not depend on who reads it: expand as plain Dijkstra over the absolute domain
+    RouteSettings field_settings = route_settings;
+    field_settings.h_coeff = 0.0;
+    field_settings.search_radius_coeff = INFINITY;
+    field_settings.search_cone_angle = 180.0;
+
+    Pathfinding *d_map = Pathfinding::get_d_map( to.xy(), to.z, path_settings );
+
+    const point start = from.xy();
+    if( !d_map->is_in_limited_domain( start, start, field_settings ) ||
+        d_map->expand_2d_up_to( start, field_settings ) != ExpansionOutcome::PATH_FOUND ) {
+        return std::nullopt;
+    }
+
+    // Steepest descent, ties go to the first direction in `DIRS_2D`
+    std::optional<point> best;
+    float best_cost = d_map->get_f_unbiased( start );
+    for( const point &dir : DIRS_2D ) {
+        const point next_point = start + dir;
+        if( !d_map->in_bounds( next_point ) ||
+            d_map->tile_state_at( next_point ) != Pathfinding::State::ACCESSIBLE ||
+            d_map->forbidden_moves.contains( { start, next_point } ) ) {
+            continue;
+        }
+        const float cost = d_map->get_f_unbiased( next_point );
+        if( cost < best_cost ) {
+            best_cost = cost;
+            best = next_point;
+        }
+    }
+
+    if( !best ) {
+        return std::nullopt;
+    }
+    return tripoint( *best, from.z );
+}
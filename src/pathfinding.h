@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstring>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -242,6 +243,10 @@ class Pathfinding
         // Global state: We cache `z_path` information taken to prevent multiple iterations for the same target
         static std::map<std::tuple<bool, int, tripoint>, ZLevelChange> cached_closest_z_changes;
 
+        // Area the memoized d_maps were built for (in global coords, top left loaded submap).
+        // d_maps use local coords, so they are all dropped once the map shifts away from it.
+        static point d_maps_area;
+
         // Smallest adjacent f
         std::array<std::array<float, MAPSIZE_X>, MAPSIZE_Y> p_map;
         // Associated tile's g cost [movement, bashing down...]
@@ -273,6 +278,13 @@ class Pathfinding
         // Moves we don't allow to happen
         std::set<std::pair<point, point>> forbidden_moves;
 
+        // Was this map routed on during the current turn? Maps nobody used are dropped at the end of the turn.
+        bool is_used_this_turn = false;
+
+        // Some visited tiles had their g-values reset since the last expansion,
+        //   so the wave has to be propagated again from `dest` [reusing all other g-values]
+        bool is_repair_needed = false;
+
         // Possibly shift or move all Z-changes if our `z_area` moved
         //   and scan for new changes.
         // Only process OPEN_AIR changes if `update_open_air` is true. OPEN_AIR tiles are numerous on higher Z levels
@@ -284,6 +296,8 @@ class Pathfinding
         static std::unordered_map<point, ZLevelChangeOpenAirPair> &get_z_cache_open_air( const int z );
 
         static void produce_d_map( point dest, int z, PathfindingSettings settings );
+        // Find the memoized d_map for `dest`, `z` and `settings`, creating it if there is none yet
+        static Pathfinding *get_d_map( const point &dest, int z, const PathfindingSettings &settings );
 
         // Get `p`-value at `p`
         float &p_at( const point &p );
@@ -296,6 +310,12 @@ class Pathfinding
 
         void reset_maps();
         void reset_tile_state();
+        // Forget g-values and forbidden moves of tiles around `p` whose cost might have changed.
+        //   Returns whether any of these tiles was already visited.
+        bool invalidate_around( const point &p );
+
+        // Return d_maps matching `predicate` to `d_maps_store`
+        static void release_d_maps( const std::function<bool( const Pathfinding & )> &predicate );
         State &tile_state_at( const point &p );
         bool in_bounds( const point &p );
 
@@ -330,9 +350,27 @@ class Pathfinding
                                             const std::optional<PathfindingSettings> path_settings = std::nullopt,
                                             const std::optional<RouteSettings> route_settings = std::nullopt );
 
+        // Shared flow field mode: get the tile to step into next on the way from `from` to `to`, if there is a route.
+        // All callers heading to the same `to` with the same `path_settings` read the same d_map,
+        //   which is expanded as a plain Dijkstra map [`route_settings` only limit it by distance and f-value]
+        //   so once it has reached `from` the step is a lookup of the 8 neighbours.
+        static std::optional<tripoint> flow_field_step( tripoint from, tripoint to,
+                const PathfindingSettings &path_settings,
+                const RouteSettings &route_settings );
+
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
+        // Drop d_maps that can't be reused on the next turn. Call once at the end of every turn.
+        static void prune_d_maps();
+
+        // Terrain, furniture, trap or vehicle at `p` [local coords] changed.
+        //   Only g-values around `p` are recalculated on the next route through the affected d_maps.
+        static void mark_dirty_tile( const tripoint &p );
+
+        // Something changed all over `z` level, drop all its d_maps
+        static void mark_dirty_z_level( int z );
+
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
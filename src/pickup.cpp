@@ -62,6 +62,8 @@
 #include "vehicle_selector.h"
 #include "vpart_position.h"
 
+static const ter_furn_flag_id ter_furn_flag_SEALED( "SEALED" );
+
 using item_count = std::pair<item *, int>;
 using pickup_map = std::map<std::string, item_count>;
 
@@ -597,7 +599,7 @@ void pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
             from_vehicle = cargo_part >= 0;
         } else {
             // Nothing to change, default is to pick from ground anyway.
-            if( g->m.has_flag( "SEALED", p ) ) {
+            if( g->m.has_flag( ter_furn_flag_SEALED, p ) ) {
                 return;
             }
         }
@@ -654,7 +656,7 @@ void pickup::pick_up( const tripoint &p, int min, from_where get_items_from )
         // Bail out if this square cannot be auto-picked-up
         if( g->check_zone( zone_type_id( "NO_AUTO_PICKUP" ), p ) ) {
             return;
-        } else if( g->m.has_flag( "SEALED", p ) ) {
+        } else if( g->m.has_flag( ter_furn_flag_SEALED, p ) ) {
             return;
         }
     }
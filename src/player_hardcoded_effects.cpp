@@ -112,6 +112,9 @@ static const trait_id trait_SCHIZOPHRENIC( "SCHIZOPHRENIC" );
 static const trait_id trait_THRESH_MYCUS( "THRESH_MYCUS" );
 static const trait_id trait_WATERSLEEP( "WATERSLEEP" );
 
+static const ter_furn_flag_id ter_furn_flag_FLAT( "FLAT" );
+static const ter_furn_flag_id ter_furn_flag_FUNGUS( "FUNGUS" );
+
 static void eff_fun_onfire( player &u, effect &it )
 {
     const int intense = it.get_intensity();
@@ -174,7 +177,7 @@ static void eff_fun_fungus( player &u, effect &it )
             break;
         case 3: {
             // Permanent symptoms
-            bool is_fungal_ter = g->m.has_flag_ter( "FUNGUS", u.pos() );
+            bool is_fungal_ter = g->m.has_flag_ter( ter_furn_flag_FUNGUS, u.pos() );
             if( !is_fungal_ter && one_in( 600 + 4 * bonus ) ) {
                 u.add_effect( effect_nausea, 5_minutes );
             }
@@ -1130,7 +1133,7 @@ void Character::hardcoded_effects( effect &it )
             }
             if( has_trait( trait_M_SKIN3 ) ) {
                 // Spores happen!
-                if( g->m.has_flag_ter_or_furn( "FUNGUS", pos() ) ) {
+                if( g->m.has_flag_ter_or_furn( ter_furn_flag_FUNGUS, pos() ) ) {
                     if( get_fatigue() >= 0 ) {
                         mod_fatigue( -5 ); // Local guides need less sleep on fungal soil
                     }
@@ -1228,7 +1231,7 @@ void Character::hardcoded_effects( effect &it )
                         if( mp == pos() ) {
                             continue;
                         }
-                        if( g->m.has_flag( "FLAT", mp ) &&
+                        if( g->m.has_flag( ter_furn_flag_FLAT, mp ) &&
                             g->m.pl_sees( mp, 2 ) ) {
                             g->spawn_hallucination( mp );
                             if( ++count > max_count ) {
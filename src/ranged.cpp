@@ -805,7 +805,7 @@ auto is_mountable( const map &m, const tripoint &pos ) -> bool
     // only allow mounting passable OR climable terrain
     // example: sandbag barricades are impassable but climbable
     if( ( m.climb_difficulty( pos ) <= 5 || m.passable( pos ) ) &&
-        m.has_flag_ter_or_furn( "MOUNTABLE", pos ) ) {
+        m.has_flag_ter_or_furn( TER_FURN_FLAG( "MOUNTABLE" ), pos ) ) {
         return true;
     }
 
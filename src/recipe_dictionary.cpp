@@ -1,6 +1,7 @@
 #include "recipe_dictionary.h"
 
 #include <algorithm>
+#include <climits>
 #include <iterator>
 #include <memory>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 #include "debug.h"
 #include "init.h"
 #include "input.h"
+#include "inventory.h"
 #include "item.h"
 #include "item_factory.h"
 #include "iteminfo_query.h"
@@ -428,6 +430,66 @@ void recipe_dictionary::find_items_on_loops()
     }
 }
 
+static const itype_id itype_adv_UPS_off( "adv_UPS_off" );
+static const itype_id itype_any( "any" );
+static const itype_id itype_UPS( "UPS" );
+static const itype_id itype_UPS_off( "UPS_off" );
+
+void recipe_dictionary::build_requirement_index()
+{
+    static int last_generation = 0;
+    req_index = requirement_index();
+    req_index.generation = ++last_generation;
+
+    const auto add_set = [this]( const requirement_data & reqs ) {
+        const uint32_t set = static_cast<uint32_t>( req_index.set_groups.size() );
+        uint32_t groups = 0;
+        const auto new_group = [&]() {
+            const uint32_t group = static_cast<uint32_t>( req_index.group_set.size() );
+            req_index.group_set.push_back( set );
+            groups++;
+            return group;
+        };
+        const auto add_comps = [&]( const auto & comp_groups ) {
+            for( const auto &alternatives : comp_groups ) {
+                const uint32_t group = new_group();
+                bool always = alternatives.empty();
+                for( const auto &comp : alternatives ) {
+                    // Nested requirements should be expanded by now, but don't rule anything out if not
+                    always |= comp.type == itype_any || comp.requirement;
+                    req_index.groups_by_type[comp.type].push_back( group );
+                }
+                if( always ) {
+                    req_index.always_met.push_back( group );
+                }
+            }
+        };
+        add_comps( reqs.get_tools() );
+        add_comps( reqs.get_components() );
+        for( const std::vector<quality_requirement> &alternatives : reqs.get_qualities() ) {
+            const uint32_t group = new_group();
+            if( alternatives.empty() ) {
+                req_index.always_met.push_back( group );
+            }
+            for( const quality_requirement &qual : alternatives ) {
+                req_index.groups_by_quality[qual.type].emplace_back( group, qual.level );
+            }
+        }
+        req_index.set_groups.push_back( groups );
+    };
+
+    for( const std::pair<const recipe_id, recipe> &e : recipes ) {
+        const recipe &r = e.second;
+        requirement_index::recipe_sets &sets = req_index.sets_of[&r];
+        sets.first = static_cast<uint32_t>( req_index.set_groups.size() );
+        sets.deduped = static_cast<uint32_t>( r.deduped_requirements().alternatives().size() );
+        for( const requirement_data &alternative : r.deduped_requirements().alternatives() ) {
+            add_set( alternative );
+        }
+        add_set( r.simple_requirements() );
+    }
+}
+
 void recipe_dictionary::finalize()
 {
     DynamicDataLoader::get_instance().load_deferred( deferred );
@@ -486,6 +548,7 @@ void recipe_dictionary::finalize()
     }
 
     recipe_dict.find_items_on_loops();
+    recipe_dict.build_requirement_index();
 }
 
 void recipe_dictionary::reset()
@@ -496,6 +559,7 @@ void recipe_dictionary::reset()
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
     recipe_dict.items_on_loops.clear();
+    recipe_dict.req_index = requirement_index();
 }
 
 void recipe_dictionary::delete_if( const std::function<bool( const recipe & )> &pred )
@@ -504,6 +568,126 @@ void recipe_dictionary::delete_if( const std::function<bool( const recipe & )> &
     ::delete_if( recipe_dict.uncraft, pred );
 }
 
+void recipe_candidates::reset()
+{
+    const recipe_dictionary::requirement_index &index = recipe_dict.req_index;
+    types.clear();
+    qualities.clear();
+    group_hits.assign( index.group_set.size(), 0 );
+    unmet_groups = index.set_groups;
+    for( const uint32_t group : index.always_met ) {
+        add_hits( group, 1 );
+    }
+    generation = index.generation;
+}
+
+void recipe_candidates::add_hits( uint32_t group, int delta )
+{
+    const bool was_met = group_hits[group] > 0;
+    group_hits[group] += delta;
+    const bool is_met = group_hits[group] > 0;
+    if( was_met != is_met ) {
+        unmet_groups[recipe_dict.req_index.group_set[group]] += is_met ? -1 : 1;
+    }
+}
+
+void recipe_candidates::update( const inventory &inv )
+{
+    const recipe_dictionary::requirement_index &index = recipe_dict.req_index;
+    if( generation != index.generation ) {
+        reset();
+    }
+
+    std::unordered_set<itype_id> new_types;
+    std::unordered_map<quality_id, int> new_qualities;
+    inv.visit_items( [&]( const item * e ) {
+        const itype_id &type = e->typeId();
+        new_types.insert( type );
+        // The inventory counts the charges of both as UPS charges
+        if( type == itype_UPS_off || type == itype_adv_UPS_off ) {
+            new_types.insert( itype_UPS );
+        }
+        for( const std::pair<const quality_id, int> &qual : e->type->qualities ) {
+            const auto it = new_qualities.emplace( qual.first, qual.second ).first;
+            it->second = std::max( it->second, qual.second );
+        }
+        return VisitResponse::NEXT;
+    } );
+
+    const auto count_type = [&]( const itype_id & type, int delta ) {
+        const auto it = index.groups_by_type.find( type );
+        if( it != index.groups_by_type.end() ) {
+            for( const uint32_t group : it->second ) {
+                add_hits( group, delta );
+            }
+        }
+    };
+    for( const itype_id &type : types ) {
+        if( !new_types.contains( type ) ) {
+            count_type( type, -1 );
+        }
+    }
+    for( const itype_id &type : new_types ) {
+        if( !types.contains( type ) ) {
+            count_type( type, 1 );
+        }
+    }
+
+    const auto level_of = []( const std::unordered_map<quality_id, int> &levels,
+    const quality_id & qual ) {
+        const auto it = levels.find( qual );
+        return it == levels.end() ? INT_MIN : it->second;
+    };
+    const auto change_level = [&]( const quality_id & qual, int from, int to ) {
+        const auto it = index.groups_by_quality.find( qual );
+        if( from == to || it == index.groups_by_quality.end() ) {
+            return;
+        }
+        for( const std::pair<uint32_t, int> &group : it->second ) {
+            const bool was_met = from >= group.second;
+            const bool is_met = to >= group.second;
+            if( was_met != is_met ) {
+                add_hits( group.first, is_met ? 1 : -1 );
+            }
+        }
+    };
+    for( const std::pair<const quality_id, int> &qual : qualities ) {
+        if( !new_qualities.contains( qual.first ) ) {
+            change_level( qual.first, qual.second, INT_MIN );
+        }
+    }
+    for( const std::pair<const quality_id, int> &qual : new_qualities ) {
+        change_level( qual.first, level_of( qualities, qual.first ), qual.second );
+    }
+
+    types = std::move( new_types );
+    qualities = std::move( new_qualities );
+}
+
+bool recipe_candidates::may_make( const recipe &r ) const
+{
+    const recipe_dictionary::requirement_index &index = recipe_dict.req_index;
+    const auto it = index.sets_of.find( &r );
+    if( generation != index.generation || it == index.sets_of.end() || it->second.deduped == 0 ) {
+        return true;
+    }
+    const uint32_t first = it->second.first;
+    return std::any_of( unmet_groups.begin() + first,
+    unmet_groups.begin() + first + it->second.deduped, []( uint32_t unmet ) {
+        return unmet == 0;
+    } );
+}
+
+bool recipe_candidates::may_make_simple( const recipe &r ) const
+{
+    const recipe_dictionary::requirement_index &index = recipe_dict.req_index;
+    const auto it = index.sets_of.find( &r );
+    if( generation != index.generation || it == index.sets_of.end() ) {
+        return true;
+    }
+    return unmet_groups[it->second.first + it->second.deduped] == 0;
+}
+
 void recipe_subset::include( const recipe *r, int custom_difficulty )
 {
     if( custom_difficulty < 0 ) {
@@ -1,12 +1,15 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "recipe.h"
@@ -15,11 +18,13 @@
 class JsonIn;
 class JsonOut;
 class JsonObject;
+class inventory;
 
 class recipe_dictionary
 {
         friend class Item_factory; // allow removal of blacklisted recipes
         friend recipe_id;
+        friend class recipe_candidates;
 
     public:
         /** Returns all recipes that can be automatically learned */
@@ -58,18 +63,78 @@ class recipe_dictionary
                              std::map<recipe_id, recipe> &out );
 
     private:
+        /**
+         * The requirement groups of all recipes, by the item types and qualities that
+         * can meet them. A requirement set is one alternative of a recipe's deduped
+         * requirements, or its simple requirements, and is met when all its groups are.
+         */
+        struct requirement_index {
+            struct recipe_sets {
+                uint32_t first = 0;
+                // Deduped alternatives come first, the simple requirements right after them
+                uint32_t deduped = 0;
+            };
+            std::unordered_map<const recipe *, recipe_sets> sets_of;
+            // Set of each group
+            std::vector<uint32_t> group_set;
+            // Groups any inventory meets, like ones that accept "any" item
+            std::vector<uint32_t> always_met;
+            // Number of groups of each set
+            std::vector<uint32_t> set_groups;
+            std::unordered_map<itype_id, std::vector<uint32_t>> groups_by_type;
+            // Group and required level
+            std::unordered_map<quality_id, std::vector<std::pair<uint32_t, int>>> groups_by_quality;
+            // Tells trackers built on an older index to start over
+            int generation = 0;
+        };
+
         std::map<recipe_id, recipe> recipes;
         std::map<recipe_id, recipe> uncraft;
         std::set<const recipe *> autolearn;
         std::set<const recipe *> blueprints;
         std::unordered_set<itype_id> items_on_loops;
+        requirement_index req_index;
 
         static void finalize_internal( std::map<recipe_id, recipe> &obj );
         void find_items_on_loops();
+        void build_requirement_index();
 };
 
 extern recipe_dictionary recipe_dict;
 
+/**
+ * Which recipes could be made from an inventory, found through the recipe dictionary's
+ * index of requirement groups by item type and quality.
+ *
+ * A group counts as met when one of its item types is in the inventory at all, or one of
+ * its qualities at the required level; amounts and charges aren't checked. So recipes it
+ * rules out can't be made, the others still need requirement_data::can_make_with_inventory.
+ * Updating with a changed inventory only revisits the groups of the item types and
+ * qualities that came or went.
+ */
+class recipe_candidates
+{
+    public:
+        /** Catches up with the items and qualities in @p inv. */
+        void update( const inventory &inv );
+        /** False if the deduped requirements of @p r can't be met, true if they might. */
+        bool may_make( const recipe &r ) const;
+        /** The same for the simple requirements of @p r. */
+        bool may_make_simple( const recipe &r ) const;
+
+    private:
+        std::unordered_set<itype_id> types;
+        std::unordered_map<quality_id, int> qualities;
+        // Met alternatives of each group
+        std::vector<uint32_t> group_hits;
+        // Groups of each set that aren't met
+        std::vector<uint32_t> unmet_groups;
+        int generation = -1;
+
+        void reset();
+        void add_hits( uint32_t group, int delta );
+};
+
 using recipe_filter = std::function<bool( const recipe &r )>;
 
 recipe_filter recipe_filter_by_component( const itype_id &c );
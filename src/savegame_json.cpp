@@ -32,6 +32,7 @@
 #include "auto_pickup.h"
 #include "avatar.h"
 #include "bionics.h"
+#include "binary_io.h"
 #include "bodypart.h"
 #include "calendar.h"
 #include "cata_io.h"
@@ -3692,9 +3693,6 @@ void stats_tracker::deserialize( JsonIn &jsin )
 
 void submap::store( JsonOut &jsout ) const
 {
-    jsout.member( "turn_last_touched", last_touched );
-    jsout.member( "temperature", temperature );
-
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
     // this feature but the algorithm is backward compatible.
     jsout.member( "terrain" );
@@ -3780,20 +3778,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( int j = 0; j < SEEY; j++ ) {
-        for( int i = 0; i < SEEX; i++ ) {
-            if( itm[i][j].empty() ) {
-                continue;
-            }
-            jsout.write( i );
-            jsout.write( j );
-            jsout.write( itm[i][j] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3812,6 +3796,28 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_contents( jsout );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
+    jsout.member( "turn_last_touched", last_touched );
+    jsout.member( "temperature", temperature );
+
+    jsout.member( "items" );
+    jsout.start_array();
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( itm[i][j].empty() ) {
+                continue;
+            }
+            jsout.write( i );
+            jsout.write( j );
+            jsout.write( itm[i][j] );
+        }
+    }
+    jsout.end_array();
+
     jsout.member( "fields" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -3912,6 +3918,115 @@ void submap::store( JsonOut &jsout ) const
     jsout.end_array();
 }
 
+namespace
+{
+
+constexpr int submap_tiles = SEEX * SEEY;
+
+// Grids are traversed row by row, same as in the json format
+template<typename T>
+void store_palette_runs( std::ostream &out, const int_id<T>( &grid )[SEEX][SEEY] )
+{
+    std::vector<int_id<T>> palette;
+    std::vector<std::pair<size_t, int>> runs;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            const int_id<T> id = grid[i][j];
+            if( !runs.empty() && palette[runs.back().first] == id ) {
+                runs.back().second++;
+                continue;
+            }
+            const auto iter = std::ranges::find( palette, id );
+            runs.emplace_back( iter - palette.begin(), 1 );
+            if( iter == palette.end() ) {
+                palette.push_back( id );
+            }
+        }
+    }
+
+    binary_io::write_varint( out, palette.size() );
+    for( const int_id<T> &id : palette ) {
+        binary_io::write_string( out, id.id().str() );
+    }
+    binary_io::write_varint( out, runs.size() );
+    for( const std::pair<size_t, int> &run : runs ) {
+        binary_io::write_varint( out, run.first );
+        binary_io::write_varint( out, run.second );
+    }
+}
+
+template<typename T>
+void load_palette_runs( std::istream &in, int_id<T>( &grid )[SEEX][SEEY] )
+{
+    std::vector<int_id<T>> palette( binary_io::read_varint( in ) );
+    for( int_id<T> &id : palette ) {
+        id = string_id<T>( binary_io::read_string( in ) ).id();
+    }
+    const uint64_t num_runs = binary_io::read_varint( in );
+    uint64_t tile = 0;
+    for( uint64_t run = 0; run < num_runs; run++ ) {
+        const uint64_t index = binary_io::read_varint( in );
+        const uint64_t length = binary_io::read_varint( in );
+        if( index >= palette.size() || length > submap_tiles - tile ) {
+            throw std::runtime_error( "corrupt submap grid" );
+        }
+        for( const uint64_t end = tile + length; tile < end; tile++ ) {
+            grid[tile % SEEX][tile / SEEX] = palette[index];
+        }
+    }
+    if( tile != submap_tiles ) {
+        throw std::runtime_error( "corrupt submap grid" );
+    }
+}
+
+} // namespace
+
+void submap::store_grids( std::ostream &out ) const
+{
+    store_palette_runs( out, ter );
+    store_palette_runs( out, frn );
+    store_palette_runs( out, trp );
+
+    std::vector<std::pair<int, int>> rad_runs;
+    for( int j = 0; j < SEEY; j++ ) {
+        for( int i = 0; i < SEEX; i++ ) {
+            if( !rad_runs.empty() && rad_runs.back().first == rad[i][j] ) {
+                rad_runs.back().second++;
+            } else {
+                rad_runs.emplace_back( rad[i][j], 1 );
+            }
+        }
+    }
+    binary_io::write_varint( out, rad_runs.size() );
+    for( const std::pair<int, int> &run : rad_runs ) {
+        binary_io::write_svarint( out, run.first );
+        binary_io::write_varint( out, run.second );
+    }
+}
+
+void submap::load_grids( std::istream &in )
+{
+    load_palette_runs( in, ter );
+    load_palette_runs( in, frn );
+    load_palette_runs( in, trp );
+
+    const uint64_t num_runs = binary_io::read_varint( in );
+    uint64_t tile = 0;
+    for( uint64_t run = 0; run < num_runs; run++ ) {
+        const int strength = static_cast<int>( binary_io::read_svarint( in ) );
+        const uint64_t length = binary_io::read_varint( in );
+        if( length > submap_tiles - tile ) {
+            throw std::runtime_error( "corrupt submap radiation" );
+        }
+        for( const uint64_t end = tile + length; tile < end; tile++ ) {
+            rad[tile % SEEX][tile / SEEX] = strength;
+        }
+    }
+    if( tile != submap_tiles ) {
+        throw std::runtime_error( "corrupt submap radiation" );
+    }
+}
+
 void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                    const tripoint offset )
 {
@@ -3957,7 +4072,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             int rad_num = jsin.get_int();
             for( int i = 0; i < rad_num; ++i ) {
                 if( rad_cell < SEEX * SEEY ) {
-                    set_radiation( { 0 % SEEX, rad_cell / SEEX }, rad_strength );
+                    set_radiation( { rad_cell % SEEX, rad_cell / SEEX }, rad_strength );
                     rad_cell++;
                 }
             }
@@ -4044,6 +4159,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                     field_count++;
                 }
                 fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                set_field_tile( point( i, j ) );
             }
         }
     } else if( member_name == "graffiti" ) {
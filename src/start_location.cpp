@@ -31,6 +31,12 @@
 #include "rng.h"
 #include "string_id.h"
 
+static const ter_furn_flag_id ter_furn_flag_DOOR( "DOOR" );
+static const ter_furn_flag_id ter_furn_flag_FLAMMABLE( "FLAMMABLE" );
+static const ter_furn_flag_id ter_furn_flag_FLAMMABLE_ASH( "FLAMMABLE_ASH" );
+static const ter_furn_flag_id ter_furn_flag_GOES_UP( "GOES_UP" );
+static const ter_furn_flag_id ter_furn_flag_OPENCLOSE_INSIDE( "OPENCLOSE_INSIDE" );
+
 class item;
 
 static const efftype_id effect_bleed( "bleed" );
@@ -326,7 +332,7 @@ static int rate_location( map &m, const tripoint &p, const bool must_be_inside,
         checked[cur.x][cur.y] = attempt;
         if( cur.x == 0 || cur.x == MAPSIZE_X - 1 ||
             cur.y == 0 || cur.y == MAPSIZE_Y - 1 ||
-            m.has_flag( "GOES_UP", cur ) ) {
+            m.has_flag( ter_furn_flag_GOES_UP, cur ) ) {
             return INT_MAX;
         }
 
@@ -414,11 +420,11 @@ void start_location::burn( const tripoint_abs_omt &omtstart, const size_t count,
     const point u( g->u.posx() % HALF_MAPSIZE_X, g->u.posy() % HALF_MAPSIZE_Y );
     std::vector<tripoint> valid;
     for( const tripoint &p : m.points_on_zlevel() ) {
-        if( !( m.has_flag_ter( "DOOR", p ) ||
-               m.has_flag_ter( "OPENCLOSE_INSIDE", p ) ||
+        if( !( m.has_flag_ter( ter_furn_flag_DOOR, p ) ||
+               m.has_flag_ter( ter_furn_flag_OPENCLOSE_INSIDE, p ) ||
                m.is_outside( p ) ||
                ( p.x >= u.x - rad && p.x <= u.x + rad && p.y >= u.y - rad && p.y <= u.y + rad ) ) ) {
-            if( m.has_flag( "FLAMMABLE", p ) || m.has_flag( "FLAMMABLE_ASH", p ) ) {
+            if( m.has_flag( ter_furn_flag_FLAMMABLE, p ) || m.has_flag( ter_furn_flag_FLAMMABLE_ASH, p ) ) {
                 valid.push_back( p );
             }
         }
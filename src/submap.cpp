@@ -23,6 +23,9 @@ void maptile_soa<sx, sy>::swap_soa_tile( point p1, point p2 )
     std::swap( lum[p1.x][p1.y], lum[p2.x][p2.y] );
     std::swap( itm[p1.x][p1.y], itm[p2.x][p2.y] );
     std::swap( fld[p1.x][p1.y], fld[p2.x][p2.y] );
+    const bool p1_fields = field_tiles[p1.x * sy + p1.y];
+    field_tiles[p1.x * sy + p1.y] = field_tiles[p2.x * sy + p2.y];
+    field_tiles[p2.x * sy + p2.y] = p1_fields;
     std::swap( trp[p1.x][p1.y], trp[p2.x][p2.y] );
     std::swap( rad[p1.x][p1.y], rad[p2.x][p2.y] );
 }
@@ -33,6 +36,7 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.frn, second.frn );
     std::swap( first.lum, second.lum );
     std::swap( first.fld, second.fld );
+    std::swap( first.field_tiles, second.field_tiles );
     std::swap( first.trp, second.trp );
     std::swap( first.rad, second.rad );
     std::swap( first.is_uniform, second.is_uniform );
@@ -48,6 +52,8 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.legacy_computer, second.legacy_computer );
     std::swap( first.temperature, second.temperature );
     std::swap( first.cosmetics, second.cosmetics );
+    first.is_dirty = true;
+    second.is_dirty = true;
 
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <iosfwd>
 #include <memory>
 #include <vector>
 #include <string>
@@ -78,6 +80,9 @@ struct maptile_soa {
         field              fld[sx][sy];  // Field on each square
         trap_id            trp[sx][sy];  // Trap on each square
         int                rad[sx][sy];  // Irradiation of each square
+        // Squares that may have fields, bit x * sy + y. Never misses one, but may
+        // keep squares whose fields are gone until the next field processing.
+        std::bitset<sx * sy> field_tiles;
 
         void swap_soa_tile( point p1, point p2 );
 };
@@ -163,6 +168,18 @@ class submap : maptile_soa<SEEX, SEEY>
             return itm[p.x][p.y];
         }
 
+        /** Call after adding fields to @ref get_field directly, see @ref get_field_tiles. */
+        void set_field_tile( point p ) {
+            field_tiles.set( p.x * SEEY + p.y );
+        }
+        /**
+         * Squares that may have fields, square (x, y) is bit x * SEEY + y. Field processing
+         * only looks at these and clears the bits of squares that turn out to be empty.
+         */
+        std::bitset<SEEX * SEEY> &get_field_tiles() {
+            return field_tiles;
+        }
+
         // TODO: Replace this as it essentially makes fld public
         field &get_field( point p ) {
             return fld[p.x][p.y];
@@ -217,10 +234,28 @@ class submap : maptile_soa<SEEX, SEEY>
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version, const tripoint offset );
 
+        /**
+         * Compact binary encoding of the terrain, furniture, trap and radiation grids,
+         * used by binary map saves. Each grid is stored as a palette of ids followed
+         * by runs of palette indices.
+         * Everything else is written by @ref store_contents and read by @ref load.
+         * @throws std::runtime_error if the data is corrupt.
+         */
+        /**@{*/
+        void store_grids( std::ostream &out ) const;
+        void load_grids( std::istream &in );
+        /**@}*/
+        /** Writes all members @ref store writes, except the ones @ref store_grids covers. */
+        void store_contents( JsonOut &jsout ) const;
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
 
+        // Set whenever this submap may have changed since it was last written out.
+        // Clean submaps outside of the reality bubble are skipped by mapbuffer::save.
+        bool is_dirty = true;
+
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
 
         active_item_cache active_items;
@@ -0,0 +1,354 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "options.h"
+#include "profile.h"
+
+namespace
+{
+
+// The pool the current thread is a worker of, and its index there
+thread_local const thread_pool *current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+thread_pool::thread_pool( const size_t num_workers ) : main_thread( std::this_thread::get_id() )
+{
+    for( size_t i = 0; i <= num_workers; i++ ) {
+        queues.emplace_back( std::make_unique<task_queue>() );
+    }
+    workers.reserve( num_workers );
+    for( size_t i = 0; i < num_workers; i++ ) {
+        workers.emplace_back( [this, i]() {
+            worker_loop( i );
+        } );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+        stopping = true;
+    }
+    task_added.notify_all();
+    for( std::thread &t : workers ) {
+        t.join();
+    }
+}
+
+void thread_pool::worker_loop( const size_t index )
+{
+    current_pool = this;
+    current_worker = index;
+#if defined(USE_TRACY)
+    tracy::SetThreadName( ( "worker " + std::to_string( index ) ).c_str() );
+#endif
+    while( true ) {
+        if( run_one_task() ) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lk( sleep_mutex );
+        task_added.wait( lk, [this]() {
+            return stopping || queued > 0;
+        } );
+        if( stopping && queued == 0 ) {
+            return;
+        }
+    }
+}
+
+void thread_pool::push( task_queue &queue, task &&func, const bool back )
+{
+    {
+        std::lock_guard<std::mutex> lk( queue.mutex );
+        // Counted before a taker can see the task, or its decrement could wrap the count
+        queued++;
+        if( back ) {
+            queue.tasks.push_back( std::move( func ) );
+        } else {
+            queue.tasks.push_front( std::move( func ) );
+        }
+    }
+    {
+        // Taking the lock orders this with a worker that is about to sleep
+        std::lock_guard<std::mutex> lk( sleep_mutex );
+    }
+    task_added.notify_one();
+}
+
+void thread_pool::submit( task func )
+{
+    if( current_pool == this ) {
+        push( *queues[current_worker], std::move( func ), true );
+    } else {
+        push( *queues.back(), std::move( func ), true );
+    }
+}
+
+bool thread_pool::take_task( task &out )
+{
+    if( queued == 0 ) {
+        return false;
+    }
+    const auto take = [&]( task_queue & queue, bool back ) {
+        std::lock_guard<std::mutex> lk( queue.mutex );
+        if( queue.tasks.empty() ) {
+            return false;
+        }
+        if( back ) {
+            out = std::move( queue.tasks.back() );
+            queue.tasks.pop_back();
+        } else {
+            out = std::move( queue.tasks.front() );
+            queue.tasks.pop_front();
+        }
+        queued--;
+        return true;
+    };
+    const bool is_worker = current_pool == this;
+    // Own work newest first, it's the most likely to be in the cache
+    if( is_worker && take( *queues[current_worker], true ) ) {
+        return true;
+    }
+    if( take( *queues.back(), false ) ) {
+        return true;
+    }
+    // Steal the oldest work of the others, starting with the next one so thieves spread out
+    const size_t first = is_worker ? current_worker + 1 : 0;
+    for( size_t i = 0; i < workers.size(); i++ ) {
+        const size_t victim = ( first + i ) % workers.size();
+        if( ( !is_worker || victim != current_worker ) && take( *queues[victim], false ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool thread_pool::run_one_task()
+{
+    task func;
+    if( !take_task( func ) ) {
+        return false;
+    }
+    ZoneScopedN( "thread_pool task" );
+    func();
+    return true;
+}
+
+void thread_pool::submit_to_main_thread( task func )
+{
+    std::lock_guard<std::mutex> lk( main_tasks_mutex );
+    main_tasks.push_back( std::move( func ) );
+}
+
+void thread_pool::run_main_thread_tasks()
+{
+    if( !on_main_thread() ) {
+        return;
+    }
+    std::vector<task> to_run;
+    {
+        std::lock_guard<std::mutex> lk( main_tasks_mutex );
+        to_run.swap( main_tasks );
+    }
+    for( task &func : to_run ) {
+        ZoneScopedN( "thread_pool main thread task" );
+        func();
+    }
+}
+
+namespace
+{
+
+// Shared between the caller of parallel_for and the helper tasks it queued.
+// Helpers may only get to run after the caller has already finished all the work,
+// so they check `closed` before touching anything the caller owns.
+struct parallel_for_state {
+    std::atomic<size_t> next_index{ 0 };
+    std::mutex mutex;
+    std::condition_variable helper_done;
+    size_t active_helpers = 0;
+    bool closed = false;
+    std::exception_ptr error;
+};
+
+void run_indices( parallel_for_state &state, const size_t count,
+                  const std::function<void( size_t )> &func )
+{
+    for( size_t i = state.next_index++; i < count; i = state.next_index++ ) {
+        try {
+            func( i );
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lk( state.mutex );
+            if( !state.error ) {
+                state.error = std::current_exception();
+            }
+            state.next_index = count;
+        }
+    }
+}
+
+} // namespace
+
+void thread_pool::parallel_for( const size_t count, const std::function<void( size_t )> &func )
+{
+    if( count == 0 ) {
+        return;
+    }
+    if( count == 1 || workers.empty() ) {
+        for( size_t i = 0; i < count; i++ ) {
+            func( i );
+        }
+        return;
+    }
+
+    auto state = std::make_shared<parallel_for_state>();
+    const size_t num_helpers = std::min( workers.size(), count - 1 );
+    for( size_t i = 0; i < num_helpers; i++ ) {
+        submit( [state, count, &func]() {
+            {
+                std::lock_guard<std::mutex> state_lk( state->mutex );
+                if( state->closed ) {
+                    return;
+                }
+                state->active_helpers++;
+            }
+            run_indices( *state, count, func );
+            std::lock_guard<std::mutex> state_lk( state->mutex );
+            if( --state->active_helpers == 0 ) {
+                state->helper_done.notify_all();
+            }
+        } );
+    }
+
+    run_indices( *state, count, func );
+
+    std::unique_lock<std::mutex> lk( state->mutex );
+    state->closed = true;
+    state->helper_done.wait( lk, [&state]() {
+        return state->active_helpers == 0;
+    } );
+    if( state->error ) {
+        std::rethrow_exception( state->error );
+    }
+}
+
+task_group::task_group( thread_pool &pool ) : pool( pool )
+{
+}
+
+task_group::task_group() : task_group( get_thread_pool() )
+{
+}
+
+task_group::~task_group()
+{
+    while( !done() ) {
+        if( !pool.run_one_task() ) {
+            std::unique_lock<std::mutex> lk( shared->mutex );
+            shared->finished.wait_for( lk, std::chrono::milliseconds( 10 ), [this]() {
+                return shared->running == 0;
+            } );
+        }
+    }
+}
+
+void task_group::run( thread_pool::task func )
+{
+    {
+        std::lock_guard<std::mutex> lk( shared->mutex );
+        shared->running++;
+    }
+    pool.submit( [this_pool = &pool, s = shared, func = std::move( func )]() {
+        try {
+            func();
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lk( s->mutex );
+            if( !s->error ) {
+                s->error = std::current_exception();
+            }
+        }
+        std::vector<std::pair<thread_pool::task, bool>> ready;
+        {
+            std::lock_guard<std::mutex> lk( s->mutex );
+            if( --s->running == 0 ) {
+                ready.swap( s->continuations );
+                s->finished.notify_all();
+            }
+        }
+        for( std::pair<thread_pool::task, bool> &next : ready ) {
+            if( next.second ) {
+                this_pool->submit_to_main_thread( std::move( next.first ) );
+            } else {
+                this_pool->submit( std::move( next.first ) );
+            }
+        }
+    } );
+}
+
+void task_group::then( thread_pool::task func, const bool on_main_thread )
+{
+    {
+        std::lock_guard<std::mutex> lk( shared->mutex );
+        if( shared->running > 0 ) {
+            shared->continuations.emplace_back( std::move( func ), on_main_thread );
+            return;
+        }
+    }
+    if( on_main_thread ) {
+        pool.submit_to_main_thread( std::move( func ) );
+    } else {
+        pool.submit( std::move( func ) );
+    }
+}
+
+bool task_group::done() const
+{
+    std::lock_guard<std::mutex> lk( shared->mutex );
+    return shared->running == 0;
+}
+
+void task_group::wait( const std::function<void()> &while_waiting )
+{
+    while( !done() ) {
+        pool.run_main_thread_tasks();
+        if( while_waiting ) {
+            while_waiting();
+        }
+        if( !pool.run_one_task() ) {
+            // Everything left is running elsewhere, check back on the caller now and then
+            std::unique_lock<std::mutex> lk( shared->mutex );
+            shared->finished.wait_for( lk, std::chrono::milliseconds( 10 ), [this]() {
+                return shared->running == 0;
+            } );
+        }
+    }
+    pool.run_main_thread_tasks();
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lk( shared->mutex );
+        std::swap( error, shared->error );
+    }
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+thread_pool &get_thread_pool()
+{
+    static thread_pool pool( []() -> size_t {
+        size_t threads = std::max( 2u, std::thread::hardware_concurrency() );
+        if( get_options().has_option( "THREAD_LIMIT" ) && get_option<int>( "THREAD_LIMIT" ) > 0 )
+        {
+            threads = std::min( threads, static_cast<size_t>( get_option<int>( "THREAD_LIMIT" ) ) );
+        }
+        return threads - 1;
+    }() );
+    return pool;
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed set of worker threads that all parallel work of the game shares.
+ *
+ * Every worker has its own queue of tasks. Tasks submitted by a worker go to the back
+ * of its own queue and it takes them from there, so related work stays on one thread.
+ * Tasks from other threads go to a shared queue. Workers that run out of tasks take
+ * from the shared queue and then steal from the front of the other workers' queues.
+ * Threads waiting for a @ref task_group run queued tasks meanwhile instead of idling.
+ *
+ * The pool only provides the threads: the work handed to it must not touch
+ * game state that is not safe to access from several threads at once. Work that has to
+ * happen on the main thread can be queued with @ref submit_to_main_thread.
+ */
+class thread_pool
+{
+    public:
+        using task = std::function<void()>;
+
+        explicit thread_pool( size_t num_workers );
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+        ~thread_pool();
+
+        /** Number of threads that take part in @ref parallel_for, the calling one included. */
+        size_t concurrency() const {
+            return workers.size() + 1;
+        }
+
+        /**
+         * Calls @p func for every index in [0, count) and returns once all of them are done.
+         * Calls happen in no particular order and on any thread, the calling one included.
+         * If @p func throws, remaining indices are skipped and the first exception is rethrown.
+         */
+        void parallel_for( size_t count, const std::function<void( size_t )> &func );
+
+        /**
+         * Queues @p func to run on any thread of the pool. It must not throw, use a
+         * @ref task_group to get exceptions or to wait for the task.
+         */
+        void submit( task func );
+        /**
+         * Queues @p func to run on the main thread, the next time it calls
+         * @ref run_main_thread_tasks or waits for a @ref task_group.
+         */
+        void submit_to_main_thread( task func );
+        /** Runs the tasks queued for the main thread. Does nothing on other threads. */
+        void run_main_thread_tasks();
+        /** Runs one queued task on the calling thread. Returns false if there was none. */
+        bool run_one_task();
+
+        /** Whether this is the thread that created the pool. */
+        bool on_main_thread() const {
+            return std::this_thread::get_id() == main_thread;
+        }
+
+    private:
+        struct task_queue {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+        void worker_loop( size_t index );
+        bool take_task( task &out );
+        void push( task_queue &queue, task &&func, bool back );
+
+        std::vector<std::thread> workers;
+        /** One queue per worker, and the shared one last. */
+        std::vector<std::unique_ptr<task_queue>> queues;
+        /** Tasks in the queues, workers sleep while there are none. */
+        std::atomic<size_t> queued{ 0 };
+        std::mutex sleep_mutex;
+        std::condition_variable task_added;
+        bool stopping = false;
+
+        std::thread::id main_thread;
+        std::mutex main_tasks_mutex;
+        std::vector<task> main_tasks;
+};
+
+/**
+ * Tasks that can be waited for together, and work to do once they are all done.
+ *
+ * Destroying the group waits for its tasks, so they may refer to the creator's locals.
+ */
+class task_group
+{
+    public:
+        explicit task_group( thread_pool &pool );
+        task_group();
+        task_group( const task_group & ) = delete;
+        task_group &operator=( const task_group & ) = delete;
+        ~task_group();
+
+        /** Queues @p func as part of the group. */
+        void run( thread_pool::task func );
+        /**
+         * Queues @p func once every task of the group that was run so far is done, on
+         * the main thread if @p on_main_thread is set. Queues it right away if they are done.
+         */
+        void then( thread_pool::task func, bool on_main_thread = false );
+
+        /** Whether all tasks of the group are done. */
+        bool done() const;
+        /**
+         * Runs queued tasks until all tasks of the group are done, and rethrows the first
+         * exception one of them threw. @p while_waiting is called between the tasks, the
+         * main thread can keep its UI alive with it.
+         */
+        void wait( const std::function<void()> &while_waiting = nullptr );
+
+    private:
+        struct state {
+            std::mutex mutex;
+            std::condition_variable finished;
+            size_t running = 0;
+            std::exception_ptr error;
+            std::vector<std::pair<thread_pool::task, bool>> continuations;
+        };
+
+        thread_pool &pool;
+        std::shared_ptr<state> shared = std::make_shared<state>();
+};
+
+/**
+ * Process-wide pool with one worker less than there are hardware threads, but at least one
+ * unless the THREAD_LIMIT option caps the number of threads, the main one included, at one.
+ */
+thread_pool &get_thread_pool();
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Hierarchical timing wheel: values are scheduled for a future tick and handed back
+ * when that tick comes.
+ *
+ * Scheduling, rescheduling and erasing are O(1), advancing by one tick costs O(1)
+ * amortized on top of the values that are due. Values live in a pool of nodes that are
+ * linked into the slot lists by index, so once the pool has grown to the number of
+ * scheduled values nothing allocates any more.
+ *
+ * Each of the four levels has 64 slots, a level covers 64 times the ticks of the one
+ * below. Values due within the next 64 ticks sit in the first level, later ones are moved
+ * down as the wheel turns. Ticks more than 64^4 ticks ahead are clamped to the last one
+ * the wheel can hold.
+ *
+ * The slot lists are allocated on first insertion, so unused wheels cost next to nothing.
+ */
+template<typename T>
+class timing_wheel
+{
+    public:
+        using handle = uint32_t;
+        using tick_type = uint64_t;
+
+        /** The tick the wheel is at, values are scheduled relative to it. */
+        tick_type now() const {
+            return current;
+        }
+
+        /** Number of values in the wheel, scheduled or not. */
+        size_t size() const {
+            return nodes.size() - free_nodes.size();
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        /** Adds a value that is due at @p due, or at the next tick if that has passed already. */
+        handle insert( T value, tick_type due ) {
+            handle h;
+            if( free_nodes.empty() ) {
+                h = static_cast<handle>( nodes.size() );
+                nodes.emplace_back();
+            } else {
+                h = free_nodes.back();
+                free_nodes.pop_back();
+            }
+            nodes[h].value = std::move( value );
+            nodes[h].in_use = true;
+            link( h, due );
+            return h;
+        }
+
+        /** Removes the value and frees its handle. */
+        void erase( handle h ) {
+            unlink( h );
+            nodes[h].value = T();
+            nodes[h].in_use = false;
+            free_nodes.push_back( h );
+        }
+
+        /** Moves a value, scheduled or already handed out by @ref advance, to another tick. */
+        void reschedule( handle h, tick_type due ) {
+            unlink( h );
+            link( h, due );
+        }
+
+        T &operator[]( handle h ) {
+            return nodes[h].value;
+        }
+        const T &operator[]( handle h ) const {
+            return nodes[h].value;
+        }
+
+        /**
+         * Moves on to the next tick and appends the handles of the values due at it to @p due.
+         * Those values stay in the wheel but are no longer scheduled, until they are
+         * rescheduled or erased.
+         */
+        void advance( std::vector<handle> &due ) {
+            current++;
+            if( slots.empty() ) {
+                return;
+            }
+            // Move the values of the upper level slots that start now down, largest first
+            for( int level = levels - 1; level > 0; level-- ) {
+                if( ( current & ( ( tick_type( 1 ) << ( level * slot_bits ) ) - 1 ) ) == 0 ) {
+                    cascade( level );
+                }
+            }
+            handle &head = slot_head( 0, slot_of( current, 0 ) );
+            while( head != none ) {
+                const handle h = head;
+                unlink( h );
+                due.push_back( h );
+            }
+        }
+
+        /** Calls @p func with the handle of each value in the wheel. */
+        template<typename Func>
+        void for_each( Func func ) {
+            for( size_t h = 0; h < nodes.size(); h++ ) {
+                if( nodes[h].in_use ) {
+                    func( static_cast<handle>( h ) );
+                }
+            }
+        }
+
+    private:
+        static constexpr int levels = 4;
+        static constexpr int slot_bits = 6;
+        static constexpr size_t slots_per_level = size_t( 1 ) << slot_bits;
+        static constexpr handle none = UINT32_MAX;
+
+        struct node {
+            T value{};
+            tick_type due = 0;
+            handle prev = none;
+            handle next = none;
+            int16_t level = -1;
+            bool in_use = false;
+        };
+
+        std::vector<node> nodes;
+        std::vector<handle> free_nodes;
+        /** Head of every slot list, level by level. */
+        std::vector<handle> slots;
+        tick_type current = 0;
+
+        static size_t slot_of( tick_type tick, int level ) {
+            return ( tick >> ( level * slot_bits ) ) & ( slots_per_level - 1 );
+        }
+
+        handle &slot_head( int level, size_t slot ) {
+            return slots[level * slots_per_level + slot];
+        }
+
+        void link( handle h, tick_type due ) {
+            if( slots.empty() ) {
+                slots.assign( levels * slots_per_level, none );
+            }
+            due = std::max( due, current + 1 );
+            int level = 0;
+            while( level < levels - 1 &&
+                   ( due >> ( ( level + 1 ) * slot_bits ) ) != ( current >> ( ( level + 1 ) * slot_bits ) ) ) {
+                level++;
+            }
+            if( level == levels - 1 ) {
+                const int top_shift = levels * slot_bits;
+                if( ( due >> top_shift ) != ( current >> top_shift ) ) {
+                    due = ( ( current >> top_shift ) << top_shift ) + ( tick_type( 1 ) << top_shift ) - 1;
+                }
+            }
+            node &n = nodes[h];
+            n.due = due;
+            n.level = static_cast<int16_t>( level );
+            handle &head = slot_head( level, slot_of( due, level ) );
+            n.prev = none;
+            n.next = head;
+            if( head != none ) {
+                nodes[head].prev = h;
+            }
+            head = h;
+        }
+
+        void unlink( handle h ) {
+            node &n = nodes[h];
+            if( n.level < 0 ) {
+                return;
+            }
+            if( n.prev != none ) {
+                nodes[n.prev].next = n.next;
+            } else {
+                slot_head( n.level, slot_of( n.due, n.level ) ) = n.next;
+            }
+            if( n.next != none ) {
+                nodes[n.next].prev = n.prev;
+            }
+            n.prev = none;
+            n.next = none;
+            n.level = -1;
+        }
+
+        void cascade( int level ) {
+            handle h = slot_head( level, slot_of( current, level ) );
+            slot_head( level, slot_of( current, level ) ) = none;
+            while( h != none ) {
+                const handle next = nodes[h].next;
+                nodes[h].level = -1;
+                // Values due now go to the first level slot that is collected right after
+                link_due_now( h );
+                h = next;
+            }
+        }
+
+        void link_due_now( handle h ) {
+            node &n = nodes[h];
+            if( n.due == current ) {
+                handle &head = slot_head( 0, slot_of( current, 0 ) );
+                n.level = 0;
+                n.prev = none;
+                n.next = head;
+                if( head != none ) {
+                    nodes[head].prev = h;
+                }
+                head = h;
+            } else {
+                link( h, n.due );
+            }
+        }
+};
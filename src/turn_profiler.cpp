@@ -0,0 +1,311 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "calendar.h"
+#include "color.h"
+#include "cursesdef.h"
+#include "output.h"
+#include "path_info.h"
+#include "point.h"
+
+namespace turn_profiler
+{
+
+namespace
+{
+
+struct turn_record {
+    clock::duration total{};
+    stage_times stages{};
+};
+
+// Enough to see stalls that happen every few in-game minutes
+constexpr size_t history_size = 300;
+
+// Upper bounds of the histogram buckets, the last one takes everything above
+constexpr std::array<std::chrono::microseconds, 9> bucket_limits = { {
+        std::chrono::microseconds( 50 ), std::chrono::microseconds( 100 ),
+        std::chrono::microseconds( 250 ), std::chrono::microseconds( 500 ),
+        std::chrono::microseconds( 1000 ), std::chrono::microseconds( 2500 ),
+        std::chrono::microseconds( 5000 ), std::chrono::microseconds( 10000 ),
+        std::chrono::microseconds( 25000 )
+    }
+};
+constexpr size_t num_buckets = bucket_limits.size() + 1;
+
+bool profiling_enabled = false;
+bool show_overlay = false;
+std::unique_ptr<std::ofstream> csv_log;
+
+clock::time_point turn_start;
+bool turn_started = false;
+clock::duration turn_idle{};
+stage_times current_turn{};
+
+stage_times totals{};
+int turns = 0;
+
+std::vector<turn_record> history;
+size_t history_next = 0;
+
+double to_ms( clock::duration time )
+{
+    return std::chrono::duration<double, std::milli>( time ).count();
+}
+
+size_t bucket_of( clock::duration time )
+{
+    for( size_t i = 0; i < bucket_limits.size(); i++ ) {
+        if( time < bucket_limits[i] ) {
+            return i;
+        }
+    }
+    return bucket_limits.size();
+}
+
+void write_csv_header( std::ostream &out )
+{
+    out << "turn,total_ms";
+    for( size_t i = 0; i < num_stages; i++ ) {
+        out << ',' << stage_name( static_cast<stage>( i ) ) << "_ms";
+    }
+    out << '\n';
+}
+
+void write_csv_line( std::ostream &out, const turn_record &record )
+{
+    out << to_turns<int>( calendar::turn - calendar::turn_zero ) << ',' << to_ms( record.total );
+    for( const clock::duration &time : record.stages ) {
+        out << ',' << to_ms( time );
+    }
+    out << '\n';
+}
+
+struct row_summary {
+    clock::duration mean{};
+    clock::duration max{};
+    std::array<int, num_buckets> histogram{};
+};
+
+template<typename Get>
+row_summary summarize( Get get )
+{
+    row_summary summary;
+    clock::duration sum{};
+    for( const turn_record &record : history ) {
+        const clock::duration time = get( record );
+        sum += time;
+        summary.max = std::max( summary.max, time );
+        summary.histogram[bucket_of( time )]++;
+    }
+    if( !history.empty() ) {
+        summary.mean = sum / history.size();
+    }
+    return summary;
+}
+
+// One character per bucket, denser glyphs for more turns
+std::string histogram_string( const std::array<int, num_buckets> &histogram, size_t samples )
+{
+    std::string result;
+    for( const int count : histogram ) {
+        const double share = samples > 0 ? static_cast<double>( count ) / samples : 0.0;
+        if( count == 0 ) {
+            result += ' ';
+        } else if( share < 0.05 ) {
+            result += '.';
+        } else if( share < 0.15 ) {
+            result += ':';
+        } else if( share < 0.35 ) {
+            result += '+';
+        } else {
+            result += '#';
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+const char *stage_name( stage s )
+{
+    switch( s ) {
+        case stage::autosave:
+            return "autosave";
+        case stage::sounds:
+            return "sounds";
+        case stage::scent:
+            return "scent";
+        case stage::vehmove:
+            return "vehmove";
+        case stage::process_fields:
+            return "process_fields";
+        case stage::process_items:
+            return "process_items";
+        case stage::build_map_cache:
+            return "build_map_cache";
+        case stage::monmove:
+            return "monmove";
+        case stage::lua_hooks:
+            return "lua_hooks";
+        case stage::explosions:
+            return "explosions";
+        case stage::num_stages:
+            break;
+    }
+    return "unknown";
+}
+
+bool enabled()
+{
+    return profiling_enabled || show_overlay || csv_log != nullptr;
+}
+
+void set_enabled( bool enable )
+{
+    profiling_enabled = enable;
+}
+
+bool overlay_shown()
+{
+    return show_overlay;
+}
+
+void toggle_overlay()
+{
+    show_overlay = !show_overlay;
+    if( show_overlay ) {
+        // Don't show turns from the last time it was open
+        history.clear();
+        history_next = 0;
+    }
+}
+
+std::string csv_path()
+{
+    return PATH_INFO::config_dir() + "turn_profile.csv";
+}
+
+bool csv_logging()
+{
+    return csv_log != nullptr;
+}
+
+bool toggle_csv_log()
+{
+    if( csv_log ) {
+        csv_log.reset();
+        return true;
+    }
+    csv_log = std::make_unique<std::ofstream>( csv_path(), std::ios::out | std::ios::trunc );
+    if( !*csv_log ) {
+        csv_log.reset();
+        return false;
+    }
+    write_csv_header( *csv_log );
+    return true;
+}
+
+void add_time( stage s, clock::duration time )
+{
+    current_turn[static_cast<size_t>( s )] += time;
+}
+
+void begin_turn()
+{
+    current_turn = {};
+    turn_idle = {};
+    turn_started = enabled();
+    if( turn_started ) {
+        turn_start = clock::now();
+    }
+}
+
+void add_idle_time( clock::duration time )
+{
+    turn_idle += time;
+}
+
+void end_turn()
+{
+    if( !enabled() ) {
+        current_turn = {};
+        return;
+    }
+    turn_record record;
+    record.total = turn_started ? clock::now() - turn_start - turn_idle : clock::duration{};
+    record.stages = current_turn;
+    current_turn = {};
+
+    for( size_t i = 0; i < num_stages; i++ ) {
+        totals[i] += record.stages[i];
+    }
+    turns++;
+
+    if( history.size() < history_size ) {
+        history.push_back( record );
+    } else {
+        history[history_next] = record;
+    }
+    history_next = ( history_next + 1 ) % history_size;
+
+    if( csv_log ) {
+        write_csv_line( *csv_log, record );
+        // Keep the log usable after a crash, that's when it's most interesting
+        csv_log->flush();
+    }
+}
+
+const stage_times &total_times()
+{
+    return totals;
+}
+
+int total_turns()
+{
+    return turns;
+}
+
+void reset()
+{
+    current_turn = {};
+    totals = {};
+    turns = 0;
+}
+
+void draw_overlay( const point &origin )
+{
+    const int width = 56;
+    const int height = static_cast<int>( num_stages ) + 5;
+    catacurses::window w = catacurses::newwin( height, width, origin );
+    werase( w );
+    draw_border( w );
+    mvwprintz( w, point( 2, 0 ), c_white, " Turn profiler, last %d turns ", history.size() );
+    mvwprintz( w, point( 1, 1 ), c_light_gray, "%-16s %8s %8s  %s", "", "avg ms", "max ms",
+               "50us..25ms" );
+
+    const auto print_row = [&]( int y, const char *name, const row_summary & summary,
+    const nc_color & color ) {
+        mvwprintz( w, point( 1, y ), color, "%-16s %8.2f %8.2f [%s]", name, to_ms( summary.mean ),
+                   to_ms( summary.max ), histogram_string( summary.histogram, history.size() ) );
+    };
+    print_row( 2, "turn", summarize( []( const turn_record & record ) {
+        return record.total;
+    } ), c_yellow );
+    for( size_t i = 0; i < num_stages; i++ ) {
+        print_row( 3 + static_cast<int>( i ), stage_name( static_cast<stage>( i ) ),
+        summarize( [i]( const turn_record & record ) {
+            return record.stages[i];
+        } ), c_light_gray );
+    }
+    if( csv_log ) {
+        mvwprintz( w, point( 1, height - 2 ), c_light_green, "Logging to turn_profile.csv" );
+    }
+    wnoutrefresh( w );
+}
+
+} // namespace turn_profiler
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "profile.h"
+
+struct point;
+
+/**
+ * Always compiled timing of the stages of @ref game::do_turn.
+ *
+ * The timers only read the clock while something wants the timings: the debug
+ * overlay, the CSV log or a benchmark. Otherwise leaving them in costs a branch
+ * per stage and turn. They also open a Tracy zone of the same name, so builds with
+ * USE_TRACY see the stages too.
+ */
+namespace turn_profiler
+{
+
+enum class stage : int {
+    autosave,
+    sounds,
+    scent,
+    vehmove,
+    process_fields,
+    process_items,
+    build_map_cache,
+    monmove,
+    lua_hooks,
+    explosions,
+    num_stages
+};
+
+constexpr size_t num_stages = static_cast<size_t>( stage::num_stages );
+
+using clock = std::chrono::steady_clock;
+using stage_times = std::array<clock::duration, num_stages>;
+
+const char *stage_name( stage s );
+
+/** Whether the timers currently record anything. */
+bool enabled();
+/** Record timings regardless of the overlay and CSV log, used by benchmarks. */
+void set_enabled( bool enable );
+
+bool overlay_shown();
+void toggle_overlay();
+
+/** Path of the per-turn CSV log in the config directory. */
+std::string csv_path();
+bool csv_logging();
+/** Starts a new CSV log, or stops the running one. Returns false if the file can't be written. */
+bool toggle_csv_log();
+
+void add_time( stage s, clock::duration time );
+/** Called at the start of every turn. */
+void begin_turn();
+/** Time that shouldn't count towards the turn, like waiting for input. */
+void add_idle_time( clock::duration time );
+/** Called at the end of every turn, records the turn in the totals, history and CSV log. */
+void end_turn();
+
+/** Time spent in each stage over all turns since the last @ref reset. */
+const stage_times &total_times();
+int total_turns();
+void reset();
+
+/** Draws recent stage times and their histograms in a window at the given screen position. */
+void draw_overlay( const point &origin );
+
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( stage s ) : s( s ), running( enabled() ) {
+            if( running ) {
+                start = clock::now();
+            }
+        }
+        ~scoped_timer() {
+            if( running ) {
+                add_time( s, clock::now() - start );
+            }
+        }
+
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        stage s;
+        bool running;
+        clock::time_point start;
+};
+
+/** Leaves the rest of the enclosing scope out of the turn time. */
+class scoped_idle
+{
+    public:
+        scoped_idle() : running( enabled() ) {
+            if( running ) {
+                start = clock::now();
+            }
+        }
+        ~scoped_idle() {
+            if( running ) {
+                add_idle_time( clock::now() - start );
+            }
+        }
+
+        scoped_idle( const scoped_idle & ) = delete;
+        scoped_idle &operator=( const scoped_idle & ) = delete;
+
+    private:
+        bool running;
+        clock::time_point start;
+};
+
+} // namespace turn_profiler
+
+/** Times the rest of the enclosing scope as the given @ref turn_profiler::stage. */
+#define TURN_STAGE_TIMER( name ) \
+    ZoneScopedN( #name ); \
+    turn_profiler::scoped_timer turn_stage_timer_( turn_profiler::stage::name )
@@ -274,6 +274,7 @@ void vehicle::copy_static_from( const vehicle &source )
     engines = source.engines;
     reactors = source.reactors;
     solar_panels = source.solar_panels;
+    batteries = source.batteries;
     wind_turbines = source.wind_turbines;
     water_wheels = source.water_wheels;
     sails = source.sails;
@@ -5290,30 +5291,66 @@ void traverse( StartPoint &start,
 
 } // namespace distribution_graph
 
+namespace
+{
+
+/** Charge a battery holds at @p level percent of its capacity, rounded down. */
+int charge_at_level( const vehicle_part &p, const int level )
+{
+    return level * p.ammo_capacity() / 100;
+}
+
+/**
+ * Highest level in [lo, hi] for which @p moved returns at most @p amount, where @p moved
+ * grows with the level. Returns lo - 1 if even lo needs more.
+ */
+template<typename Moved>
+int highest_level_within( const int amount, int lo, int hi, const Moved &moved )
+{
+    int best = lo - 1;
+    while( lo <= hi ) {
+        const int mid = ( lo + hi ) / 2;
+        if( moved( mid ) <= amount ) {
+            best = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return best;
+}
+
+} // namespace
+
 int vehicle::charge_battery( int amount, bool include_other_vehicles )
 {
-    // Key parts by percentage charge level.
-    std::multimap<int, vehicle_part *> chargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_capacity() > p.ammo_remaining() ) {
-            chargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
+    // Fill the batteries like water, the emptiest ones first, so they end up at the same
+    // percentage of their capacity. The level all of them can be brought to is searched
+    // for instead of charging them one percent at a time.
+    std::vector<vehicle_part *> chargeable_parts;
+    for( const int idx : batteries ) {
+        vehicle_part &p = parts[idx];
+        if( p.is_available() && p.ammo_capacity() > p.ammo_remaining() ) {
+            chargeable_parts.push_back( &p );
         }
     }
-    while( amount > 0 && !chargeable_parts.empty() ) {
-        // Grab first part, charge until it reaches the next %, then re-insert with new % key.
-        auto iter = chargeable_parts.begin();
-        int charge_level = iter->first;
-        vehicle_part *p = iter->second;
-        chargeable_parts.erase( iter );
-        // Calculate number of charges to reach the next %, but insure it's at least
-        // one more than current charge.
-        int next_charge_level = ( ( charge_level + 1 ) * p->ammo_capacity() ) / 100;
-        next_charge_level = std::max( next_charge_level, p->ammo_remaining() + 1 );
-        int qty = std::min( amount, next_charge_level - p->ammo_remaining() );
-        p->ammo_set( fuel_type_battery, p->ammo_remaining() + qty );
-        amount -= qty;
-        if( p->ammo_capacity() > p->ammo_remaining() ) {
-            chargeable_parts.insert( { ( p->ammo_remaining() * 100 ) / p->ammo_capacity(), p } );
+    const auto needed_for = [&chargeable_parts]( const int level ) {
+        int64_t needed = 0;
+        for( const vehicle_part *p : chargeable_parts ) {
+            needed += std::max( 0, charge_at_level( *p, level ) - p->ammo_remaining() );
+        }
+        return needed;
+    };
+    if( amount > 0 && !chargeable_parts.empty() ) {
+        const int level = highest_level_within( amount, 0, 100, needed_for );
+        amount -= static_cast<int>( needed_for( level ) );
+        for( vehicle_part *p : chargeable_parts ) {
+            const int charge = std::max( p->ammo_remaining(), charge_at_level( *p, level ) );
+            // What is left isn't enough to bring all of them to the next level
+            const int extra = level < 100 ? std::min( amount,
+                              std::max( 0, charge_at_level( *p, level + 1 ) - charge ) ) : 0;
+            amount -= extra;
+            p->ammo_set( fuel_type_battery, charge + extra );
         }
     }
 
@@ -5339,27 +5376,35 @@ int vehicle::charge_battery( int amount, bool include_other_vehicles )
 
 int vehicle::discharge_battery( int amount, bool recurse )
 {
-    // Key parts by percentage charge level.
-    std::multimap<int, vehicle_part *> dischargeable_parts;
-    for( vehicle_part &p : parts ) {
-        if( p.is_available() && p.is_battery() && p.ammo_remaining() > 0 ) {
-            dischargeable_parts.insert( { ( p.ammo_remaining() * 100 ) / p.ammo_capacity(), &p } );
+    // The fullest batteries give first, until they are all at the same percentage
+    std::vector<vehicle_part *> dischargeable_parts;
+    for( const int idx : batteries ) {
+        vehicle_part &p = parts[idx];
+        if( p.is_available() && p.ammo_remaining() > 0 ) {
+            dischargeable_parts.push_back( &p );
         }
     }
-    while( amount > 0 && !dischargeable_parts.empty() ) {
-        // Grab first part, discharge until it reaches the next %, then re-insert with new % key.
-        auto iter = std::prev( dischargeable_parts.end() );
-        int charge_level = iter->first;
-        vehicle_part *p = iter->second;
-        dischargeable_parts.erase( iter );
-        // Calculate number of charges to reach the previous %.
-        int prev_charge_level = ( ( charge_level - 1 ) * p->ammo_capacity() ) / 100;
-        prev_charge_level = std::max( 0, prev_charge_level );
-        int amount_to_discharge = std::min( p->ammo_remaining() - prev_charge_level, amount );
-        p->ammo_consume( amount_to_discharge, global_part_pos3( *p ) );
-        amount -= amount_to_discharge;
-        if( p->ammo_remaining() > 0 ) {
-            dischargeable_parts.insert( { ( p->ammo_remaining() * 100 ) / p->ammo_capacity(), p } );
+    // Searched for as the level counted down from full, so that more is taken the higher it is
+    const auto taken_for = [&dischargeable_parts]( const int below_full ) {
+        int64_t taken = 0;
+        for( const vehicle_part *p : dischargeable_parts ) {
+            taken += std::max( 0, p->ammo_remaining() - charge_at_level( *p, 100 - below_full ) );
+        }
+        return taken;
+    };
+    if( amount > 0 && !dischargeable_parts.empty() ) {
+        const int level = 100 - highest_level_within( amount, 0, 100, taken_for );
+        amount -= static_cast<int>( taken_for( 100 - level ) );
+        for( vehicle_part *p : dischargeable_parts ) {
+            const int charge = std::min( p->ammo_remaining(), charge_at_level( *p, level ) );
+            // What is left isn't enough to bring all of them to the next level down
+            const int extra = level > 0 ? std::min( amount,
+                              std::max( 0, charge - charge_at_level( *p, level - 1 ) ) ) : 0;
+            amount -= extra;
+            const int qty = p->ammo_remaining() - ( charge - extra );
+            if( qty > 0 ) {
+                p->ammo_consume( qty, global_part_pos3( *p ) );
+            }
         }
     }
 
@@ -5864,6 +5909,7 @@ void vehicle::refresh()
     engines.clear();
     reactors.clear();
     solar_panels.clear();
+    batteries.clear();
     wind_turbines.clear();
     sails.clear();
     water_wheels.clear();
@@ -5921,6 +5967,10 @@ void vehicle::refresh()
         if( vpi.has_flag( VPFLAG_FLOATS ) ) {
             floating.push_back( p );
         }
+        // Broken batteries still count, whether they are usable is checked when they are used
+        if( vp.part().is_battery() ) {
+            batteries.push_back( p );
+        }
 
         if( vp.part().is_unavailable() ) {
             continue;
@@ -89,6 +89,9 @@ static const fault_id fault_starter( "fault_engine_starter" );
 
 static const skill_id skill_mechanics( "mechanics" );
 
+static const ter_furn_flag_id ter_furn_flag_PLOWABLE( "PLOWABLE" );
+static const ter_furn_flag_id ter_furn_flag_SEALED( "SEALED" );
+
 
 enum change_types : int {
     OPENCURTAINS = 0,
@@ -1450,7 +1453,7 @@ void vehicle::operate_planter()
                     break;
                 } else if( g->m.ter( loc ) == t_dirtmound ) {
                     g->m.set( loc, t_dirt, f_plant_seed );
-                } else if( !g->m.has_flag( "PLOWABLE", loc ) ) {
+                } else if( !g->m.has_flag( ter_furn_flag_PLOWABLE, loc ) ) {
                     //If it isn't plowable terrain, then it will most likely be damaged.
                     damage( planter_id, rng( 1, 10 ), DT_BASH, false );
                     sounds::sound( loc, rng( 10, 20 ), sounds::sound_t::combat, _( "Clink" ), false, "smash_success",
@@ -1498,7 +1501,7 @@ void vehicle::operate_scoop()
             }
             item *that_item_there = nullptr;
             map_stack items = g->m.i_at( position );
-            if( g->m.has_flag( "SEALED", position ) ) {
+            if( g->m.has_flag( ter_furn_flag_SEALED, position ) ) {
                 // Ignore it. Street sweepers are not known for their ability to harvest crops.
                 continue;
             }
@@ -1633,6 +1636,7 @@ void vehicle::open_or_close( const int part_index, const bool opening )
     insides_dirty = true;
     map &here = get_map();
     here.set_transparency_cache_dirty( sm_pos.z );
+    here.set_pathfinding_cache_dirty( sm_pos.z );
     const tripoint part_location = mount_to_tripoint( parts[part_index].mount );
     here.set_seen_cache_dirty( part_location );
     const int dist = rl_dist( get_player_character().pos(), part_location );
@@ -1827,7 +1831,7 @@ void vehicle::interact_with( const tripoint &pos, int interact_part )
     std::vector<std::string> menu_items;
     std::vector<uilist_entry> options_message;
     const bool has_items_on_ground = here.sees_some_items( pos, g->u );
-    const bool items_are_sealed = here.has_flag( "SEALED", pos );
+    const bool items_are_sealed = here.has_flag( ter_furn_flag_SEALED, pos );
 
     auto turret = turret_query( pos );
 
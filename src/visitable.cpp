@@ -48,6 +48,9 @@ static const bionic_id bio_ups( "bio_ups" );
 
 static const flag_id flag_BIONIC_ARMOR_INTERFACE( "BIONIC_ARMOR_INTERFACE" );
 
+static const ter_furn_flag_id ter_furn_flag_LIQUIDCONT( "LIQUIDCONT" );
+static const ter_furn_flag_id ter_furn_flag_SEALED( "SEALED" );
+
 /** @relates visitable */
 template <typename T>
 item *visitable<T>::find_parent( const item &it )
@@ -529,7 +532,7 @@ VisitResponse visitable<map_cursor>::visit_items(
     auto cur = static_cast<map_cursor *>( this );
     map &here = get_map();
     // skip inaccessible items
-    if( here.has_flag( "SEALED", *cur ) && !here.has_flag( "LIQUIDCONT", *cur ) ) {
+    if( here.has_flag( ter_furn_flag_SEALED, *cur ) && !here.has_flag( ter_furn_flag_LIQUIDCONT, *cur ) ) {
         return VisitResponse::NEXT;
     }
 
@@ -967,7 +967,7 @@ double get_local_windpower( double windpower, const oter_id &omter, const tripoi
 
 bool is_wind_blocker( const tripoint &location )
 {
-    return g->m.has_flag( "BLOCK_WIND", location );
+    return g->m.has_flag( TER_FURN_FLAG( "BLOCK_WIND" ), location );
 }
 
 // Description of Wind Speed - https://en.wikipedia.org/wiki/Beaufort_scale
@@ -3,7 +3,10 @@
 #include <algorithm>
 #include <sstream>
 #include <cstring>
+#include <functional>
 #include <chrono>
+#include <iterator>
+#include <map>
 
 #include "game.h"
 #include "avatar.h"
@@ -15,7 +18,9 @@
 #include "mod_manager.h"
 #include "path_info.h"
 #include "compress.h"
+#include "options.h"
 #include "sqlite3.h"
+#include "thread_pool.h"
 #include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
@@ -299,21 +304,11 @@ static bool file_exist_in_db( sqlite3 *db, const std::string &path )
     return fileCount > 0;
 }
 
-static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+static sqlite3_stmt *prepare_file_insert( sqlite3 *db )
 {
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
-
-    std::vector<std::byte> compressedData;
-    zlib_compress( data, compressedData );
-
-    size_t basePos = path.find_last_of( "/\\" );
-    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
-
     auto sql = R"sql(
         INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
+        VALUES (:path, :parent, :data, :compression)
         ON CONFLICT(path) DO UPDATE
             SET data = excluded.data,
                 parent = excluded.parent,
@@ -326,26 +321,65 @@ static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn wri
         dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
         throw std::runtime_error( "DB query failed" );
     }
+    return stmt;
+}
+
+// Runs a statement from prepare_file_insert, it can be reused afterwards
+static void insert_file( sqlite3 *db, sqlite3_stmt *stmt, const std::string &path,
+                         const std::vector<std::byte> &compressedData, const std::string &compression )
+{
+    size_t basePos = path.find_last_of( "/\\" );
+    auto parent = ( basePos == std::string::npos ) ? "" : path.substr( 0, basePos );
 
     if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ||
         sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), parent.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ||
         sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), compressedData.data(),
-                           compressedData.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
+                           compressedData.size(), SQLITE_STATIC ) != SQLITE_OK ||
+        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":compression" ),
+                           compression.c_str(), -1, SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
+        sqlite3_reset( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
     if( sqlite3_step( stmt ) != SQLITE_DONE ) {
         dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
     }
+    sqlite3_reset( stmt );
+    sqlite3_clear_bindings( stmt );
+}
+
+static std::string get_save_compression()
+{
+    return get_options().has_option( "SAVE_COMPRESSION" ) ?
+           ::get_option<std::string>( "SAVE_COMPRESSION" ) : "zlib";
+}
+
+static void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer )
+{
+    std::ostringstream oss;
+    writer( oss );
+    auto data = oss.str();
+
+    const std::string compression = get_save_compression();
+    std::vector<std::byte> compressedData;
+    compress_with( compression, data, compressedData );
+
+    sqlite3_stmt *stmt = prepare_file_insert( db );
+    try {
+        insert_file( db, stmt, path, compressedData, compression );
+    } catch( ... ) {
+        sqlite3_finalize( stmt );
+        throw;
+    }
     sqlite3_finalize( stmt );
 }
 
-static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                          bool optional )
+// Hands the decompressed contents of the file to the reader
+static bool read_data_from_db( sqlite3 *db, const std::string &path,
+                               const std::function<void( std::string & )> &reader, bool optional )
 {
     const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
 
@@ -379,12 +413,13 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
             dataString = std::string( static_cast<const char *>( blobData ), blobSize );
         } else if( compression == "zlib" ) {
             zlib_decompress( blobData, blobSize, dataString );
+        } else if( compression == "lz4-block-v1" ) {
+            lz4_decompress( blobData, blobSize, dataString );
         } else {
             throw std::runtime_error( "Unknown compression format: " + compression );
         }
 
-        std::istringstream stream( dataString );
-        reader( stream );
+        reader( dataString );
         sqlite3_finalize( stmt );
     } else {
         auto err = sqlite3_errmsg( db );
@@ -400,11 +435,20 @@ static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn rea
     return true;
 }
 
+static bool read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                          bool optional )
+{
+    return read_data_from_db( db, path, [&]( std::string & data ) {
+        std::istringstream stream( std::move( data ) );
+        reader( stream );
+    }, optional );
+}
+
 static bool read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
                                bool optional )
 {
-    return read_from_db( db, path, [&]( std::istream & fin ) {
-        JsonIn jsin( fin, path );
+    return read_data_from_db( db, path, [&]( std::string & data ) {
+        JsonIn jsin( data, path );
         reader( jsin );
     }, optional );
 }
@@ -428,9 +472,22 @@ world::world( WORLDINFO *info )
 
 world::~world()
 {
+    if( prefetch_thread.joinable() ) {
+        {
+            std::lock_guard<std::mutex> lk( prefetch_mutex );
+            prefetch_stopping = true;
+        }
+        prefetch_requested.notify_all();
+        prefetch_thread.join();
+    }
+    if( map_prefetch_db ) {
+        sqlite3_close( map_prefetch_db );
+    }
+
     if( save_tx_start_ts != 0 ) {
         dbg( DL::Error ) << "Save transaction was not committed before world destruction";
     }
+    pending_writes.clear();
 
     if( map_db ) {
         sqlite3_close( map_db );
@@ -465,6 +522,8 @@ int64_t world::commit_save_tx()
         throw std::runtime_error( "Attempted to commit a save transaction while none was in progress" );
     }
 
+    flush_pending_writes();
+
     if( map_db ) {
         sqlite3_exec( map_db, "COMMIT", NULL, NULL, NULL );
     }
@@ -481,6 +540,55 @@ int64_t world::commit_save_tx()
     return duration;
 }
 
+void world::write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer ) const
+{
+    if( save_tx_start_ts == 0 ) {
+        ::write_to_db( db, path, writer );
+        return;
+    }
+
+    std::ostringstream oss;
+    writer( oss );
+    pending_writes.push_back( { db, path, oss.str() } );
+    pending_bytes += pending_writes.back().data.size();
+    // Bounds the memory held by serialized but unwritten files
+    static constexpr size_t max_pending_bytes = 64 * 1024 * 1024;
+    if( pending_bytes > max_pending_bytes ) {
+        flush_pending_writes();
+    }
+}
+
+void world::flush_pending_writes() const
+{
+    if( pending_writes.empty() ) {
+        return;
+    }
+    std::map<sqlite3 *, sqlite3_stmt *> statements;
+    on_out_of_scope cleanup( [&]() {
+        for( const auto &stmt : statements ) {
+            sqlite3_finalize( stmt.second );
+        }
+        pending_writes.clear();
+        pending_bytes = 0;
+    } );
+
+    const std::string compression = get_save_compression();
+    std::vector<std::vector<std::byte>> compressed( pending_writes.size() );
+    get_thread_pool().parallel_for( pending_writes.size(), [&]( size_t i ) {
+        compress_with( compression, pending_writes[i].data, compressed[i] );
+    } );
+
+    // In order of writing, so the last write to a path wins
+    for( size_t i = 0; i < pending_writes.size(); i++ ) {
+        sqlite3 *db = pending_writes[i].db;
+        sqlite3_stmt *&stmt = statements[db];
+        if( stmt == nullptr ) {
+            stmt = prepare_file_insert( db );
+        }
+        insert_file( db, stmt, pending_writes[i].path, compressed[i], compression );
+    }
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -496,28 +604,134 @@ static std::string get_quad_filename( const tripoint &om_addr )
     return string_format( "%d.%d.%d.map", om_addr.x, om_addr.y, om_addr.z );
 }
 
-bool world::read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const
+std::string world::get_map_quad_path( const tripoint &om_addr ) const
 {
     const std::string dirname = get_quad_dirname( om_addr );
     std::string quad_path = dirname + "/" + get_quad_filename( om_addr );
 
+    if( info->world_save_format != save_format::V2_COMPRESSED_SQLITE3 && !file_exist( quad_path ) ) {
+        // Fix for old saves where the path was generated using std::stringstream, which
+        // did format the number using the current locale. That formatting may insert
+        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+        // of "map/1234.7.8.map".
+        std::ostringstream buffer;
+        buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
+        if( file_exist( buffer.str() ) ) {
+            quad_path = buffer.str();
+        }
+    }
+
+    return quad_path;
+}
+
+bool world::read_map_quad( const tripoint &om_addr, file_read_fn reader ) const
+{
+    const std::string quad_path = get_map_quad_path( om_addr );
+
     // V2 logic
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        return read_from_db_json( map_db, quad_path, reader, true );
+        flush_pending_writes();
+        return read_from_db( map_db, quad_path, reader, true );
     } else {
-        if( !file_exist( quad_path ) ) {
-            // Fix for old saves where the path was generated using std::stringstream, which
-            // did format the number using the current locale. That formatting may insert
-            // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-            // of "map/1234.7.8.map".
-            std::ostringstream buffer;
-            buffer << dirname << "/" << om_addr.x << "." << om_addr.y << "." << om_addr.z << ".map";
-            if( file_exist( buffer.str() ) ) {
-                quad_path = buffer.str();
+        return read_from_file( quad_path, reader, true );
+    }
+}
+
+void world::prefetch_map_quad( const tripoint &om_addr )
+{
+    {
+        std::lock_guard<std::mutex> lk( prefetch_mutex );
+        prefetch_queue.push_back( om_addr );
+    }
+    if( !prefetch_thread.joinable() ) {
+        prefetch_thread = std::thread( [this]() {
+            prefetch_loop();
+        } );
+    }
+    prefetch_requested.notify_one();
+}
+
+std::vector<std::pair<tripoint, std::string>> world::take_prefetched_map_quads()
+{
+    std::lock_guard<std::mutex> lk( prefetch_mutex );
+    return std::exchange( prefetched_quads, {} );
+}
+
+void world::cancel_map_quad_prefetch()
+{
+    std::unique_lock<std::mutex> lk( prefetch_mutex );
+    prefetch_queue.clear();
+    prefetch_idle.wait( lk, [this]() {
+        return !prefetch_busy;
+    } );
+    prefetched_quads.clear();
+}
+
+void world::prefetch_loop()
+{
+    while( true ) {
+        tripoint om_addr;
+        {
+            std::unique_lock<std::mutex> lk( prefetch_mutex );
+            prefetch_requested.wait( lk, [this]() {
+                return prefetch_stopping || !prefetch_queue.empty();
+            } );
+            if( prefetch_stopping ) {
+                return;
+            }
+            om_addr = prefetch_queue.front();
+            prefetch_queue.pop_front();
+            prefetch_busy = true;
+        }
+
+        std::string data;
+        const bool found = read_map_quad_data( om_addr, data );
+        {
+            std::lock_guard<std::mutex> lk( prefetch_mutex );
+            if( found ) {
+                prefetched_quads.emplace_back( om_addr, std::move( data ) );
+            }
+            prefetch_busy = false;
+        }
+        prefetch_idle.notify_all();
+    }
+}
+
+// Runs on the prefetch thread: must not report errors through the usual channels
+bool world::read_map_quad_data( const tripoint &om_addr, std::string &data )
+{
+    const std::string quad_path = get_map_quad_path( om_addr );
+    const auto read_all = [&data]( std::istream & fin ) {
+        data.assign( std::istreambuf_iterator<char>( fin ), std::istreambuf_iterator<char>() );
+    };
+
+    try {
+        if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+            if( map_prefetch_db == nullptr ) {
+                // The main thread keeps using `map_db` in the meantime
+                const std::string path = info->folder_path() + "/map.sqlite3";
+                if( sqlite3_open_v2( path.c_str(), &map_prefetch_db, SQLITE_OPEN_READONLY,
+                                     nullptr ) != SQLITE_OK ) {
+                    sqlite3_close( map_prefetch_db );
+                    map_prefetch_db = nullptr;
+                    return false;
+                }
             }
+            // Fails while the main thread is in the middle of a save, that's fine
+            return read_data_from_db( map_prefetch_db, quad_path, [&data]( std::string & contents ) {
+                data = std::move( contents );
+            }, true );
         }
 
-        return read_from_file_json( quad_path, reader, true );
+        cata_ifstream fin = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open(
+                                           info->folder_path() + "/" + quad_path ) );
+        if( !fin.is_open() ) {
+            return false;
+        }
+        read_all( *fin );
+        return !fin.bad();
+    } catch( const std::exception & ) {
+        return false;
     }
 }
 
@@ -553,6 +767,7 @@ std::string world::overmap_player_filename( const point_abs_om &p ) const
 bool world::overmap_exists( const point_abs_om &p ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return file_exist_in_db( map_db, overmap_terrain_filename( p ) );
     } else {
         return file_exist( overmap_terrain_filename( p ) );
@@ -562,6 +777,7 @@ bool world::overmap_exists( const point_abs_om &p ) const
 bool world::read_overmap( const point_abs_om &p, file_read_fn reader ) const
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        flush_pending_writes();
         return read_from_db( map_db, overmap_terrain_filename( p ), reader, true );
     } else {
         return read_from_file( overmap_terrain_filename( p ), reader, true );
@@ -572,6 +788,7 @@ bool world::read_overmap_player_visibility( const point_abs_om &p, file_read_fn
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db( playerdb, overmap_player_filename( p ), reader, true );
     } else {
         return read_from_player_file( overmap_player_filename( p ), reader, true );
@@ -611,6 +828,7 @@ bool world::read_player_mm_quad( const tripoint &p, file_read_json_fn reader )
 {
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
         sqlite3 *playerdb = get_player_db();
+        flush_pending_writes();
         return read_from_db_json( playerdb, get_mm_filename( p ), reader, true );
     } else {
         return read_from_player_file_json( ".mm1/" + get_mm_filename( p ), reader, true );
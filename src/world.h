@@ -1,7 +1,13 @@
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 #include "json.h"
 #include "options.h"
 #include "type_id.h"
@@ -110,9 +116,24 @@ class world
          * lay out files differently, so centralize file placement logic here rather than
          * scattering it throughout the codebase.
          */
-        bool read_map_quad( const tripoint &om_addr, file_read_json_fn reader ) const;
+        /** Map quads may be json or binary, see @ref mapbuffer::write_quad. */
+        bool read_map_quad( const tripoint &om_addr, file_read_fn reader ) const;
         bool write_map_quad( const tripoint &om_addr, file_write_fn writer ) const;
 
+        /**
+         * Map quads can be read ahead of time on a background thread, see @ref mapbuffer::prefetch.
+         * Only the reading (and decompression) happens there, parsing is left to the caller.
+         * Quads that don't exist or fail to read are silently dropped, they will be read
+         * normally when they are needed.
+         */
+        /**@{*/
+        void prefetch_map_quad( const tripoint &om_addr );
+        /** Returns contents of the quads read since the last call. */
+        std::vector<std::pair<tripoint, std::string>> take_prefetched_map_quads();
+        /** Drop all requests and results, waits for the read in progress to finish. */
+        void cancel_map_quad_prefetch();
+        /**@}*/
+
         bool overmap_exists( const point_abs_om &p ) const;
         bool read_overmap( const point_abs_om &p, file_read_fn reader ) const;
         bool read_overmap_player_visibility( const point_abs_om &p, file_read_fn reader );
@@ -175,9 +196,43 @@ class world
 
         sqlite3 *map_db = nullptr;
 
+        std::string get_map_quad_path( const tripoint &om_addr ) const;
+        bool read_map_quad_data( const tripoint &om_addr, std::string &data );
+        void prefetch_loop();
+
+        /** Read-only connection to the map db used by the prefetch thread */
+        sqlite3 *map_prefetch_db = nullptr;
+        std::thread prefetch_thread;
+        std::mutex prefetch_mutex;
+        std::condition_variable prefetch_requested;
+        std::condition_variable prefetch_idle;
+        bool prefetch_stopping = false;
+        // Guarded by `prefetch_mutex`
+        bool prefetch_busy = false;
+        // Guarded by `prefetch_mutex`
+        std::deque<tripoint> prefetch_queue;
+        // Guarded by `prefetch_mutex`
+        std::vector<std::pair<tripoint, std::string>> prefetched_quads;
+
         sqlite3 *save_db = nullptr;
         std::string last_save_id = "";
         sqlite3 *get_player_db();
+
+        /**
+         * During a save transaction, files written to a db are only serialized right away.
+         * They are compressed in batches on the thread pool and inserted together,
+         * see @ref flush_pending_writes.
+         */
+        void write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer ) const;
+        /** Must be called before reading from a db, so the reads see everything written so far. */
+        void flush_pending_writes() const;
+        struct pending_write {
+            sqlite3 *db;
+            std::string path;
+            std::string data;
+        };
+        mutable std::vector<pending_write> pending_writes;
+        mutable size_t pending_bytes = 0;
 };
 
 
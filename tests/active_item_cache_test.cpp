@@ -1,8 +1,12 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <set>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "game.h"
 #include "game_constants.h"
@@ -10,6 +14,7 @@
 #include "map.h"
 #include "point.h"
 #include "state_helpers.h"
+#include "timing_wheel.h"
 
 TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
 {
@@ -50,3 +55,92 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "timing_wheel_hands_out_values_when_due", "[item]" )
+{
+    timing_wheel<int> wheel;
+    std::vector<timing_wheel<int>::handle> due;
+    // Spread over all levels, including ones that wrap around
+    const std::vector<int> delays = { 1, 2, 63, 64, 65, 600, 4095, 4096, 4097, 300000 };
+    std::map<timing_wheel<int>::handle, int> handles;
+    for( const int delay : delays ) {
+        handles.emplace( wheel.insert( delay, wheel.now() + delay ), delay );
+    }
+    const timing_wheel<int>::handle cancelled = wheel.insert( -1, wheel.now() + 100 );
+    wheel.erase( cancelled );
+    CHECK( wheel.size() == delays.size() );
+
+    std::vector<int> seen;
+    for( int tick = 1; tick <= 300000; tick++ ) {
+        due.clear();
+        wheel.advance( due );
+        for( const timing_wheel<int>::handle h : due ) {
+            CHECK( wheel[h] == tick );
+            seen.push_back( wheel[h] );
+        }
+    }
+    CHECK( seen == delays );
+
+    // Rescheduled values come back again
+    const timing_wheel<int>::handle h = handles.begin()->first;
+    wheel.reschedule( h, wheel.now() + 5 );
+    for( int i = 0; i < 4; i++ ) {
+        due.clear();
+        wheel.advance( due );
+        CHECK( due.empty() );
+    }
+    due.clear();
+    wheel.advance( due );
+    CHECK( due == std::vector<timing_wheel<int>::handle> { h } );
+}
+
+TEST_CASE( "active_items_are_processed_at_their_speed", "[item]" )
+{
+    clear_all_state();
+    active_item_cache cache;
+    std::vector<item *> fast;
+    std::vector<item *> slow;
+    for( int i = 0; i < 3; i++ ) {
+        fast.push_back( item::spawn_temporary( "firecracker_act" ) );
+        slow.push_back( item::spawn_temporary( "meat_cooked" ) );
+    }
+    for( int i = 0; i < 3; i++ ) {
+        cache.add( *fast[i] );
+        cache.add( *slow[i] );
+        // Adding twice changes nothing
+        cache.add( *fast[i] );
+    }
+    REQUIRE( slow[0]->processing_speed() > 1 );
+    const int interval = slow[0]->processing_speed();
+    CHECK( cache.get().size() == 6 );
+
+    std::map<const item *, std::vector<int>> processed_at;
+    for( int turn = 0; turn < 3 * interval; turn++ ) {
+        for( const item *it : cache.get_for_processing() ) {
+            processed_at[it].push_back( turn );
+        }
+    }
+    for( const item *it : fast ) {
+        CHECK( processed_at[it].size() == static_cast<size_t>( 3 * interval ) );
+    }
+    for( const item *it : slow ) {
+        const std::vector<int> &turns = processed_at[it];
+        REQUIRE( turns.size() == 3 );
+        CHECK( turns[0] < interval );
+        CHECK( turns[1] - turns[0] == interval );
+        CHECK( turns[2] - turns[1] == interval );
+    }
+    // First runs are offset by the number of items added before, 2 * i + 1 for slow[i]
+    for( int i = 0; i < 3; i++ ) {
+        CHECK( processed_at[slow[i]][0] == ( 2 * i + 1 ) % interval );
+    }
+
+    cache.remove( fast[0] );
+    cache.remove( slow[1] );
+    CHECK( cache.get().size() == 4 );
+    for( int turn = 0; turn < interval; turn++ ) {
+        const std::vector<item *> &items = cache.get_for_processing();
+        CHECK( std::find( items.begin(), items.end(), fast[0] ) == items.end() );
+        CHECK( std::find( items.begin(), items.end(), slow[1] ) == items.end() );
+    }
+}
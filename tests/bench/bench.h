@@ -0,0 +1,17 @@
+#pragma once
+#ifndef CATA_TESTS_BENCH_BENCH_H
+#define CATA_TESTS_BENCH_BENCH_H
+
+#include <functional>
+#include <string>
+
+/**
+ * Runs game::do_turn for the number of turns given on the command line and records
+ * the throughput and per-stage times of the scenario for the final report.
+ *
+ * @param per_turn Called before every turn, outside of the timed part. Use it to
+ * undo whatever would otherwise make the scenario drift, like a car leaving the map.
+ */
+void run_bench_turns( const std::string &scenario, const std::function<void()> &per_turn = nullptr );
+
+#endif // CATA_TESTS_BENCH_BENCH_H
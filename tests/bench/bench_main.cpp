@@ -0,0 +1,221 @@
+#define CATCH_CONFIG_RUNNER
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "bench.h"
+#include "cata_utility.h"
+#include "debug.h"
+#include "game.h"
+#include "init.h"
+#include "mod_manager.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "turn_profiler.h"
+#include "worldfactory.h"
+
+// Headless turn throughput benchmark.
+//
+// Every scenario is a Catch test case in this directory that builds a map with the
+// usual test helpers and then hands over to run_bench_turns. The RNG is reseeded with
+// the same seed before each scenario, so two runs of the same binary simulate the
+// exact same turns and only differ in how long they take.
+
+namespace
+{
+
+struct bench_result {
+    std::string scenario;
+    int turns = 0;
+    double seconds = 0.0;
+    turn_profiler::stage_times stage_times{};
+};
+
+int bench_turns = 500;
+int warmup_turns = 20;
+unsigned int bench_seed = 42;
+std::vector<bench_result> results;
+
+double to_seconds( turn_profiler::clock::duration time )
+{
+    return std::chrono::duration<double>( time ).count();
+}
+
+// Removes --name=value from args and returns value, or an empty string if not given.
+std::string take_argument( std::vector<const char *> &args, const std::string &name )
+{
+    for( auto iter = args.begin(); iter != args.end(); iter++ ) {
+        if( strncmp( *iter, name.c_str(), name.length() ) == 0 ) {
+            std::string value( *iter + name.length() );
+            args.erase( iter );
+            return value;
+        }
+    }
+    return std::string();
+}
+
+void print_report()
+{
+    for( const bench_result &result : results ) {
+        const double ms_per_turn = 1000.0 * result.seconds / result.turns;
+        cata_printf( "\n%s: %d turns in %.3f s, %.1f turns/s, %.3f ms/turn\n",
+                     result.scenario, result.turns, result.seconds, result.turns / result.seconds,
+                     ms_per_turn );
+        for( size_t i = 0; i < turn_profiler::num_stages; i++ ) {
+            const double stage_ms = 1000.0 * to_seconds( result.stage_times[i] ) / result.turns;
+            cata_printf( "    %-16s %9.3f ms/turn %5.1f%%\n",
+                         turn_profiler::stage_name( static_cast<turn_profiler::stage>( i ) ),
+                         stage_ms, ms_per_turn > 0 ? 100.0 * stage_ms / ms_per_turn : 0.0 );
+        }
+    }
+}
+
+bool write_csv( const std::string &path )
+{
+    std::ofstream out( path );
+    out << "scenario,turns,seconds,turns_per_second";
+    for( size_t i = 0; i < turn_profiler::num_stages; i++ ) {
+        out << ',' << turn_profiler::stage_name( static_cast<turn_profiler::stage>( i ) ) << "_ms";
+    }
+    out << '\n';
+    for( const bench_result &result : results ) {
+        out << result.scenario << ',' << result.turns << ',' << result.seconds << ','
+            << result.turns / result.seconds;
+        for( const turn_profiler::clock::duration &time : result.stage_times ) {
+            out << ',' << 1000.0 * to_seconds( time );
+        }
+        out << '\n';
+    }
+    return static_cast<bool>( out );
+}
+
+} // namespace
+
+void run_bench_turns( const std::string &scenario, const std::function<void()> &per_turn )
+{
+    const auto prepare_turn = [&]() {
+        // The avatar never gets to act, so do_turn never waits for input, and nothing
+        // gets to kill them either.
+        g->u.moves = 0;
+        g->u.set_all_parts_hp_to_max();
+        if( per_turn ) {
+            per_turn();
+        }
+    };
+
+    for( int i = 0; i < warmup_turns; i++ ) {
+        prepare_turn();
+        REQUIRE_FALSE( g->do_turn() );
+    }
+
+    turn_profiler::reset();
+    turn_profiler::set_enabled( true );
+    turn_profiler::clock::duration elapsed{};
+    for( int i = 0; i < bench_turns; i++ ) {
+        prepare_turn();
+        const turn_profiler::clock::time_point start = turn_profiler::clock::now();
+        const bool game_over = g->do_turn();
+        elapsed += turn_profiler::clock::now() - start;
+        REQUIRE_FALSE( game_over );
+    }
+    turn_profiler::set_enabled( false );
+
+    results.push_back( { scenario, bench_turns, to_seconds( elapsed ), turn_profiler::total_times() } );
+}
+
+struct BenchListener : Catch::TestEventListenerBase {
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void testCaseStarting( Catch::TestCaseInfo const &testInfo ) override {
+        TestEventListenerBase::testCaseStarting( testInfo );
+        rng_set_engine_seed( bench_seed );
+    }
+};
+
+CATCH_REGISTER_LISTENER( BenchListener )
+
+int main( int argc, const char *argv[] )
+{
+    Catch::Session session;
+
+    std::vector<const char *> arg_vec( argv, argv + argc );
+    const std::string turns_arg = take_argument( arg_vec, "--turns=" );
+    const std::string warmup_arg = take_argument( arg_vec, "--warmup=" );
+    const std::string seed_arg = take_argument( arg_vec, "--seed=" );
+    const std::string csv_path = take_argument( arg_vec, "--csv=" );
+    std::string user_dir = take_argument( arg_vec, "--user-dir=" );
+    if( user_dir.empty() ) {
+        user_dir = "./bench_user_dir/";
+    } else if( !user_dir.ends_with( "/" ) ) {
+        user_dir += "/";
+    }
+    if( !turns_arg.empty() ) {
+        bench_turns = std::max( 1, std::atoi( turns_arg.c_str() ) );
+    }
+    if( !warmup_arg.empty() ) {
+        warmup_turns = std::max( 0, std::atoi( warmup_arg.c_str() ) );
+    }
+    if( !seed_arg.empty() ) {
+        bench_seed = static_cast<unsigned int>( std::strtoul( seed_arg.c_str(), nullptr, 10 ) );
+    }
+
+    int result = session.applyCommandLine( arg_vec.size(), arg_vec.data() );
+    if( result != 0 || session.configData().showHelp ) {
+        cata_printf( "Cataclysm: BN benchmark options:\n" );
+        cata_printf( "  --turns=<n>         Number of timed turns per scenario (default 500).\n" );
+        cata_printf( "  --warmup=<n>        Untimed turns before the timed ones (default 20).\n" );
+        cata_printf( "  --seed=<n>          RNG seed used for every scenario (default 42).\n" );
+        cata_printf( "  --csv=<file>        Also write the results as CSV.\n" );
+        cata_printf( "  --user-dir=<dir>    Where the benchmark world is created.\n" );
+        cata_printf( "                      All contents will be erased!\n" );
+        cata_printf( "Scenarios are selected like tests, by name or with [bench].\n" );
+        return result;
+    }
+
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+    rng_set_engine_seed( bench_seed );
+
+    auto _on_out_of_scope = on_out_of_scope( []() {
+        g.reset();
+        DynamicDataLoader::get_instance().unload_data();
+    } );
+
+    // Anything depending on real time would make runs differ
+    const option_overrides_t option_overrides = {
+        { "AUTOSAVE", "false" },
+        { "FORCE_REDRAW", "false" },
+    };
+    try {
+        init_global_game_state( { mod_management::get_default_core_content_pack() },
+                                option_overrides, user_dir );
+    } catch( const std::exception &err ) {
+        cata_print_stderr( string_format( "Terminated: %s\n", err.what() ) );
+        cata_print_stderr( "Make sure that you're in the correct working directory and your data isn't corrupted.\n" );
+        return EXIT_FAILURE;
+    }
+
+    cata_printf( "Running %d turns per scenario with seed %u\n", bench_turns, bench_seed );
+    result = session.run();
+
+    clear_all_state();
+    world_generator->delete_world( world_generator->active_world->info->world_name, true );
+
+    print_report();
+    if( !csv_path.empty() && !write_csv( csv_path ) ) {
+        cata_print_stderr( string_format( "Failed to write %s\n", csv_path ) );
+        return EXIT_FAILURE;
+    }
+
+    return result;
+}
@@ -0,0 +1,159 @@
+#include "catch/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "bench.h"
+#include "calendar.h"
+#include "faction.h"
+#include "field_type.h"
+#include "game.h"
+#include "item.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "npc.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "type_id.h"
+#include "units_angle.h"
+#include "vehicle.h"
+
+static const tripoint bench_center( 60, 60, 0 );
+
+// A walled room with a door in the middle of the south wall
+static void build_room( const tripoint &corner, const point &size, const ter_id &wall,
+                        const ter_id &floor )
+{
+    map &here = get_map();
+    for( int x = 0; x < size.x; x++ ) {
+        for( int y = 0; y < size.y; y++ ) {
+            const tripoint p = corner + point( x, y );
+            const bool edge = x == 0 || y == 0 || x == size.x - 1 || y == size.y - 1;
+            here.ter_set( p, edge ? wall : floor );
+        }
+    }
+    here.ter_set( corner + point( size.x / 2, size.y - 1 ), t_door_c );
+}
+
+static void fill_room( const tripoint &corner, const point &size, int items )
+{
+    map &here = get_map();
+    const std::vector<furn_id> furniture = { f_table, f_chair, f_bookcase, f_bed, f_dresser };
+    const std::vector<std::string> loot = { "apple", "meat", "water_clean", "rock", "2x4", "rag", "lighter" };
+    for( int i = 0; i < items; i++ ) {
+        const tripoint p = corner + point( rng( 1, size.x - 2 ), rng( 1, size.y - 2 ) );
+        if( i % 8 == 0 ) {
+            here.furn_set( p, random_entry( furniture ) );
+        }
+        here.add_item( p, item::spawn( random_entry( loot ), calendar::turn ) );
+    }
+}
+
+static void finish_map()
+{
+    map &here = get_map();
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0, true );
+}
+
+TEST_CASE( "idle_base", "[bench]" )
+{
+    clear_all_state();
+    build_test_map( t_grass );
+    const tripoint corner = bench_center - point( 10, 10 );
+    build_room( corner, point( 21, 21 ), t_wall_wood, t_floor );
+    fill_room( corner, point( 21, 21 ), 300 );
+    g->u.setpos( bench_center );
+    finish_map();
+
+    run_bench_turns( "idle_base" );
+}
+
+TEST_CASE( "zombie_horde", "[bench]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    g->u.setpos( bench_center );
+    int spawned = 0;
+    while( spawned < 200 ) {
+        const tripoint p = bench_center + point( rng( -40, 40 ), rng( -40, 40 ) );
+        if( square_dist( p, bench_center ) > 10 && g->critter_at( p ) == nullptr ) {
+            spawn_test_monster( "mon_zombie", p );
+            spawned++;
+        }
+    }
+    finish_map();
+
+    run_bench_turns( "zombie_horde" );
+}
+
+TEST_CASE( "high_speed_driving", "[bench]" )
+{
+    clear_all_state();
+    build_test_map( t_pavement );
+    g->u.setpos( bench_center + point( 0, 30 ) );
+    map &here = get_map();
+    vehicle *veh_ptr = here.add_vehicle( vproto_id( "car" ), bench_center, -90_degrees, 100, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+    veh.tags.insert( "IN_CONTROL_OVERRIDE" );
+    veh.engine_on = true;
+    veh.cruise_velocity = veh.safe_ground_velocity( false );
+    veh.velocity = veh.cruise_velocity;
+    const tripoint start = veh.global_pos3();
+    finish_map();
+
+    run_bench_turns( "high_speed_driving", [&]() {
+        // Keep it on the map, like vehicle_efficiency_test does
+        here.displace_vehicle( veh, start - veh.global_pos3() );
+    } );
+}
+
+TEST_CASE( "town_fire", "[bench]" )
+{
+    clear_all_state();
+    build_test_map( t_grass );
+    g->u.setpos( bench_center + point( 50, 50 ) );
+    map &here = get_map();
+    for( int x = 0; x < 4; x++ ) {
+        for( int y = 0; y < 4; y++ ) {
+            const tripoint corner = bench_center + point( x * 14 - 28, y * 14 - 28 );
+            build_room( corner, point( 10, 10 ), t_wall_wood, t_floor );
+            fill_room( corner, point( 10, 10 ), 20 );
+        }
+    }
+    for( int i = 0; i < 6; i++ ) {
+        here.add_field( bench_center + point( rng( -25, 25 ), rng( -25, 25 ) ), fd_fire, 3 );
+    }
+    finish_map();
+
+    run_bench_turns( "town_fire" );
+}
+
+TEST_CASE( "npc_camp", "[bench]" )
+{
+    clear_all_state();
+    build_test_map( t_dirt );
+    const tripoint corner = bench_center - point( 12, 12 );
+    build_room( corner, point( 25, 25 ), t_wall_wood, t_floor );
+    fill_room( corner, point( 25, 25 ), 150 );
+    g->u.setpos( bench_center );
+    for( int i = 0; i < 8; i++ ) {
+        npc &guy = spawn_npc( bench_center.xy() + point( i % 4 * 3 - 5, i / 4 * 4 - 2 ),
+                              i % 2 == 0 ? "survivor_chef" : "farmer" );
+        guy.set_fac( faction_id( "your_followers" ) );
+        guy.set_attitude( NPCATT_FOLLOW );
+    }
+    // Something for them to worry about outside the walls
+    for( int i = 0; i < 10; i++ ) {
+        spawn_test_monster( "mon_zombie", bench_center + point( 30 + i, -30 + 2 * i ) );
+    }
+    finish_map();
+
+    run_bench_turns( "npc_camp" );
+}
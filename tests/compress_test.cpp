@@ -0,0 +1,97 @@
+#include "catch/catch.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "compress.h"
+#include "rng.h"
+
+static std::string round_trip( const std::string &compression, const std::string &input )
+{
+    std::vector<std::byte> compressed;
+    compress_with( compression, input, compressed );
+    std::string output;
+    if( compression == "lz4-block-v1" ) {
+        lz4_decompress( compressed.data(), compressed.size(), output );
+    } else {
+        zlib_decompress( compressed.data(), compressed.size(), output );
+    }
+    return output;
+}
+
+TEST_CASE( "save_compression_round_trips", "[compress]" )
+{
+    const std::string compression = GENERATE( "zlib", "lz4-block-v1" );
+    CAPTURE( compression );
+
+    std::string json_like;
+    for( int i = 0; i < 2000; i++ ) {
+        json_like += "[\"t_floor\"," + std::to_string( rng( 1, 144 ) ) + "],";
+    }
+    std::string noise;
+    for( int i = 0; i < 5000; i++ ) {
+        noise += static_cast<char>( rng( 0, 255 ) );
+    }
+
+    for( const std::string &input : {
+             std::string(), std::string( "a" ), std::string( "abcdabcdabcdabcd" ),
+             std::string( 100000, 'x' ), json_like, noise
+         } ) {
+        CAPTURE( input.size() );
+        CHECK( round_trip( compression, input ) == input );
+    }
+}
+
+TEST_CASE( "lz4_rejects_truncated_data", "[compress]" )
+{
+    std::vector<std::byte> compressed;
+    lz4_compress( std::string( 1000, 'y' ) + "tail of the data", compressed );
+    std::string output;
+    CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size() - 3, output ) );
+}
+
+TEST_CASE( "lz4_rejects_impossible_sizes", "[compress]" )
+{
+    std::vector<std::byte> compressed;
+    lz4_compress( "some data", compressed );
+    // Claim 4 GiB of output, far more than the input could ever expand to
+    for( int i = 0; i < 4; i++ ) {
+        compressed[i] = std::byte{ 0xff };
+    }
+    std::string output;
+    CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size(), output ) );
+}
+
+TEST_CASE( "lz4_round_trips_inputs_too_short_for_matches", "[compress]" )
+{
+    // Inputs up to 12 bytes long are stored as literals only
+    for( size_t size = 0; size <= 16; size++ ) {
+        CAPTURE( size );
+        const std::string input( size, 'z' );
+        CHECK( round_trip( "lz4-block-v1", input ) == input );
+    }
+}
+
+TEST_CASE( "lz4_rejects_corrupt_data", "[compress]" )
+{
+    std::string output;
+    // Size 8, then a match of 8 bytes at offset 1 before any output was written
+    const std::vector<std::byte> bad_offset = {
+        std::byte{ 8 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 },
+        std::byte{ 0x04 }, std::byte{ 1 }, std::byte{ 0 }
+    };
+    CHECK_THROWS( lz4_decompress( bad_offset.data(), bad_offset.size(), output ) );
+
+    // Literals running past the end of the data
+    std::vector<std::byte> compressed;
+    lz4_compress( "short", compressed );
+    compressed[4] = std::byte{ 0xf0 };
+    CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size(), output ) );
+
+    // Fewer bytes than the size header promises
+    compressed.clear();
+    lz4_compress( "short", compressed );
+    compressed[0] = std::byte{ 9 };
+    CHECK_THROWS( lz4_decompress( compressed.data(), compressed.size(), output ) );
+}
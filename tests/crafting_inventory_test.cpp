@@ -0,0 +1,129 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "avatar.h"
+#include "calendar.h"
+#include "field_type.h"
+#include "game_constants.h"
+#include "inventory.h"
+#include "item.h"
+#include "map.h"
+#include "mapdata.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "type_id.h"
+
+// Everything in the inventory, independent of the order it was put together in.
+// Pseudo items and water sources are spawned anew every time, so only their type and
+// charges count.
+static std::vector<std::string> describe( inventory inv )
+{
+    std::vector<std::string> result;
+    for( const std::vector<item *> *stack : inv.const_slice() ) {
+        for( const item *it : *stack ) {
+            const std::string address = it->has_position() ?
+                                        std::to_string( reinterpret_cast<uintptr_t>( it ) ) : "spawned";
+            result.push_back( string_format( "%s %d %s", it->typeId().str(), it->charges, address ) );
+        }
+    }
+    inv.update_quality_cache();
+    for( const auto &quality : inv.get_quality_cache() ) {
+        for( const std::pair<const int, int> &level : quality.second ) {
+            result.push_back( string_format( "%s %d: %d", quality.first.str(), level.first,
+                                             level.second ) );
+        }
+    }
+    std::sort( result.begin(), result.end() );
+    return result;
+}
+
+TEST_CASE( "crafting_inventory_matches_full_rebuild", "[crafting]" )
+{
+    clear_all_state();
+    map &m = get_map();
+    avatar &u = get_avatar();
+    const tripoint origin( 60, 60, 0 );
+    u.setpos( origin );
+    const bool clear_path = GENERATE( false, true );
+    CAPTURE( clear_path );
+
+    map_inventory_cache cache;
+    const auto check_matches = [&]( const tripoint & at ) {
+        inventory full;
+        full.form_from_map( m, at, PICKUP_RANGE, &u, false, clear_path );
+        CHECK( describe( cache.update( m, at, PICKUP_RANGE, &u, clear_path ) ) == describe( full ) );
+    };
+
+    m.add_item( origin + point_east, item::spawn( "hammer" ) );
+    m.add_item( origin + point_south, item::spawn( "rag", calendar::turn, 5 ) );
+    detached_ptr<item> new_lighter = item::spawn( "lighter" );
+    item &lighter = *new_lighter;
+    m.add_item( origin + point_north, std::move( new_lighter ) );
+    check_matches( origin );
+    const int formed = cache.get_revision();
+    check_matches( origin );
+    CHECK( cache.get_revision() == formed );
+
+    SECTION( "items added and removed" ) {
+        m.add_item( origin + point( 2, 2 ), item::spawn( "knife_butcher" ) );
+        check_matches( origin );
+        detached_ptr<item> new_pot = item::spawn( "pot" );
+        item &pot = *new_pot;
+        m.add_item( origin + point( -3, 1 ), std::move( new_pot ) );
+        check_matches( origin );
+        pot.put_in( item::spawn( "water_clean", calendar::turn, 2 ) );
+        check_matches( origin );
+        lighter.charges /= 2;
+        check_matches( origin );
+        m.i_rem( origin + point_east, &m.i_at( origin + point_east ).only_item() );
+        check_matches( origin );
+        m.i_clear( origin + point_south );
+        check_matches( origin );
+    }
+
+    SECTION( "items out of range change nothing" ) {
+        const int before = cache.get_revision();
+        m.add_item( origin + point( PICKUP_RANGE + 2, 0 ), item::spawn( "hammer" ) );
+        check_matches( origin );
+        CHECK( cache.get_revision() == before );
+    }
+
+    SECTION( "fires come and go with the turns" ) {
+        m.add_field( origin + point_west, fd_fire, 1 );
+        check_matches( origin );
+        calendar::turn += 1_turns;
+        check_matches( origin );
+        m.remove_field( origin + point_west, fd_fire );
+        check_matches( origin );
+    }
+
+    SECTION( "terrain changes and moving the origin" ) {
+        for( int y = -PICKUP_RANGE; y <= PICKUP_RANGE; y++ ) {
+            m.ter_set( origin + point( 2, y ), t_wall );
+        }
+        check_matches( origin );
+        m.ter_set( origin + point( -2, 0 ), t_water_sh );
+        check_matches( origin );
+        check_matches( origin + point_south_east );
+    }
+
+    SECTION( "the character's inventory" ) {
+        u.invalidate_crafting_inventory();
+        const std::vector<std::string> before = describe( u.crafting_inventory() );
+        u.i_add( item::spawn( "screwdriver" ) );
+        m.add_item( origin + point( 1, 1 ), item::spawn( "saw" ) );
+        // Picking things up and dropping them takes moves
+        u.moves -= 100;
+        const std::vector<std::string> incremental = describe( u.crafting_inventory() );
+        CHECK( incremental != before );
+        u.invalidate_crafting_inventory();
+        CHECK( incremental == describe( u.crafting_inventory() ) );
+    }
+}
@@ -779,3 +779,67 @@ TEST_CASE( "tool selection ui", "[crafting][ui]" )
         }
     }
 }
+
+TEST_CASE( "recipe_candidates_keep_every_craftable_recipe", "[crafting]" )
+{
+    clear_all_state();
+    std::vector<detached_ptr<item>> owned;
+    inventory inv;
+    const auto add = [&]( const char *type, int charges ) -> item & {
+        owned.push_back( item::spawn( type, calendar::start_of_cataclysm, charges ) );
+        return inv.add_item( *owned.back(), false );
+    };
+
+    recipe_candidates candidates;
+    // Returns how many recipes were ruled out
+    const auto check_candidates = [&]() {
+        inv.update_quality_cache();
+        candidates.update( inv );
+        recipe_candidates fresh;
+        fresh.update( inv );
+        int ruled_out = 0;
+        std::vector<recipe_id> wrong;
+        for( const auto &e : recipe_dict ) {
+            const recipe &r = e.second;
+            const auto filter = r.get_component_filter();
+            if( candidates.may_make( r ) != fresh.may_make( r ) ||
+                candidates.may_make_simple( r ) != fresh.may_make_simple( r ) ) {
+                wrong.push_back( r.ident() );
+            } else if( !candidates.may_make( r ) ) {
+                ruled_out++;
+                if( r.deduped_requirements().can_make_with_inventory( inv, filter ) ) {
+                    wrong.push_back( r.ident() );
+                }
+            }
+            if( !candidates.may_make_simple( r ) &&
+                r.simple_requirements().can_make_with_inventory( inv, filter ) ) {
+                wrong.push_back( r.ident() );
+            }
+        }
+        CHECK( wrong.empty() );
+        return ruled_out;
+    };
+
+    const int ruled_out_empty = check_candidates();
+    CHECK( ruled_out_empty > 0 );
+
+    add( "screwdriver", -1 );
+    add( "mold_plastic", -1 );
+    add( "solder_wire", 10 );
+    add( "plastic_chunk", -1 );
+    add( "cable", 5 );
+    item &hotplate = add( "hotplate", -1 );
+    hotplate.put_in( item::spawn( "battery_ups" ) );
+    item &ups = add( "UPS_off", 500 );
+    add( "soldering_iron", 20 );
+    const int ruled_out_tools = check_candidates();
+    CHECK( ruled_out_tools < ruled_out_empty );
+
+    inv.remove_item( &ups );
+    add( "hammer", -1 );
+    add( "rag", 20 );
+    check_candidates();
+
+    inv.clear();
+    CHECK( check_candidates() == ruled_out_empty );
+}
@@ -0,0 +1,77 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "creature_tracker.h"
+#include "game.h"
+#include "line.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "monster.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+
+// The slow way of answering the same question
+static std::vector<monster *> brute_force_in_radius( const tripoint &pos, int radius )
+{
+    std::vector<monster *> result;
+    for( monster &critter : g->all_monsters() ) {
+        if( square_dist( critter.pos(), pos ) <= radius ) {
+            result.push_back( &critter );
+        }
+    }
+    return result;
+}
+
+static std::vector<monster *> sorted( std::vector<monster *> monsters )
+{
+    std::sort( monsters.begin(), monsters.end() );
+    return monsters;
+}
+
+TEST_CASE( "monsters_in_radius_follows_monsters_around", "[creature_tracker]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    const Creature_tracker &tracker = *g->critter_tracker;
+
+    std::vector<monster *> monsters;
+    for( int i = 0; i < 40; i++ ) {
+        const tripoint p( rng( 20, 100 ), rng( 20, 100 ), 0 );
+        if( g->critter_at( p ) == nullptr ) {
+            monsters.push_back( &spawn_test_monster( one_in( 2 ) ? "mon_zombie" : "mon_dog", p ) );
+        }
+    }
+
+    const tripoint center( 60, 60, 0 );
+    for( int round = 0; round < 5; round++ ) {
+        CAPTURE( round );
+        for( const int radius : {
+                 0, 5, 12, 30, 100
+             } ) {
+            CAPTURE( radius );
+            CHECK( sorted( tracker.monsters_in_radius( center, radius ) ) ==
+                   sorted( brute_force_in_radius( center, radius ) ) );
+        }
+        // Moves across submap borders have to update the grid
+        for( monster *critter : monsters ) {
+            const tripoint dest = critter->pos() + tripoint( rng( -13, 13 ), rng( -13, 13 ), 0 );
+            if( g->critter_at( dest ) == nullptr && square_dist( dest, center ) < 50 ) {
+                critter->setpos( dest );
+            }
+        }
+    }
+
+    const mfaction_id zombie_faction = monster( mtype_id( "mon_zombie" ) ).faction;
+    const auto only_zombies = [&]( const mfaction_id & faction ) {
+        return faction == zombie_faction;
+    };
+    for( const monster *critter : tracker.monsters_in_radius( center, 100, only_zombies ) ) {
+        CHECK( critter->faction == zombie_faction );
+    }
+
+    clear_creatures();
+    CHECK( tracker.monsters_in_radius( center, 100 ).empty() );
+}
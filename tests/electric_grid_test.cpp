@@ -1,5 +1,6 @@
 #include "catch/catch.hpp"
 
+#include <optional>
 #include <vector>
 
 #include "active_tile_data.h"
@@ -373,6 +374,58 @@ TEST_CASE( "steady_consumer_in_bubble", "[grids]" )
     }
 }
 
+TEST_CASE( "steady_consumer_grid_waits_until_the_battery_runs_low", "[grids]" )
+{
+    clear_all_state();
+    calendar::turn = calendar::turn_zero;
+    put_player_underground();
+    distribution_grid_tracker &tracker = get_distribution_grid_tracker();
+    auto _cleanup = on_out_of_scope( [&]() {
+        tracker.get_transform_queue().clear();
+    } );
+
+    grid_setup_consumer setup = set_up_grid_with_consumer<steady_consumer_tile, grid_setup_consumer>
+                                ( get_map(), f_floor_lamp_on );
+    steady_consumer_tile &consumer = setup.consumer;
+    battery_tile &battery = setup.battery;
+    const tripoint consumer_local_pos = get_map().getlocal( setup.consumer_pos.raw() );
+    // Enough for 10 consumer ticks
+    REQUIRE( setup.grid.mod_resource( consumer.power * 10 ) == 0 );
+    tracker.update( calendar::turn );
+    const time_point start = calendar::turn;
+    REQUIRE( consumer.get_last_updated() == start );
+
+    WHEN( "5 consumer ticks pass" ) {
+        while( calendar::turn < start + consumer.consume_every * 5 ) {
+            calendar::turn += 1_turns;
+            tracker.update( calendar::turn );
+        }
+        THEN( "the grid was left alone" ) {
+            CHECK( consumer.get_last_updated() == start );
+            CHECK( battery.get_resource() == consumer.power * 10 );
+            AND_THEN( "it catches up once it's used" ) {
+                CHECK( tracker.grid_at( setup.consumer_pos ).get_resource() == consumer.power * 5 );
+                CHECK( consumer.get_last_updated() == calendar::turn );
+            }
+        }
+    }
+
+    WHEN( "the battery runs out" ) {
+        std::optional<time_point> lamp_died;
+        while( calendar::turn < start + consumer.consume_every * 12 && !lamp_died ) {
+            calendar::turn += 1_turns;
+            tracker.update( calendar::turn );
+            if( get_map().furn( consumer_local_pos ).id() == f_floor_lamp ) {
+                lamp_died = calendar::turn;
+            }
+        }
+        THEN( "the lamp dies on the first tick without power, as if it was checked every turn" ) {
+            REQUIRE( lamp_died );
+            CHECK( *lamp_died == start + consumer.consume_every * 11 );
+        }
+    }
+}
+
 TEST_CASE( "charge_watcher_in_bubble", "[grids]" )
 {
     clear_all_state();
@@ -0,0 +1,154 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "calendar.h"
+#include "coordinate_conversions.h"
+#include "field.h"
+#include "field_type.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "submap.h"
+#include "type_id.h"
+
+static std::set<field_type_id> types_in( const field &fld )
+{
+    std::set<field_type_id> result;
+    for( const field::value_type &entry : fld ) {
+        result.insert( entry.first );
+    }
+    return result;
+}
+
+TEST_CASE( "field_entries_stay_in_place", "[field]" )
+{
+    field fld;
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.begin() == fld.end() );
+
+    // More than fit inline
+    const std::vector<field_type_id> types = { fd_blood, fd_bile, fd_slime, fd_acid, fd_smoke };
+    for( const field_type_id &type : types ) {
+        CHECK( fld.add_field( type, 1 ) );
+    }
+    CHECK_FALSE( fld.add_field( fd_acid, 1 ) );
+    CHECK( fld.field_count() == types.size() );
+    CHECK( types_in( fld ) == std::set<field_type_id>( types.begin(), types.end() ) );
+
+    field_entry *const acid = fld.find_field( fd_acid );
+    REQUIRE( acid != nullptr );
+    CHECK( acid->get_field_intensity() == 2 );
+
+    // Adding and removing others doesn't move it
+    CHECK( fld.remove_field( fd_blood ) );
+    CHECK_FALSE( fld.remove_field( fd_blood ) );
+    CHECK( fld.add_field( fd_fire, 1 ) );
+    CHECK( fld.add_field( fd_sludge, 1 ) );
+    CHECK( fld.find_field( fd_acid ) == acid );
+    CHECK( fld.find_field( fd_blood ) == nullptr );
+    CHECK( fld.field_count() == types.size() + 1 );
+
+    // Removing through an iterator while going through them
+    for( auto it = fld.begin(); it != fld.end(); ) {
+        if( it->first == fd_slime || it->first == fd_fire ) {
+            fld.remove_field( it++ );
+        } else {
+            ++it;
+        }
+    }
+    CHECK( types_in( fld ) == std::set<field_type_id> { fd_bile, fd_acid, fd_smoke, fd_sludge } );
+    CHECK( fld.displayed_field_type() );
+
+    const field copy = fld;
+    CHECK( types_in( copy ) == types_in( fld ) );
+    CHECK( copy.find_field( fd_acid ) != acid );
+    CHECK( copy.find_field( fd_acid )->get_field_intensity() == 2 );
+
+    for( const field_type_id type : types_in( copy ) ) {
+        CHECK( fld.remove_field( type ) );
+    }
+    CHECK( fld.field_count() == 0 );
+    CHECK( fld.begin() == fld.end() );
+    CHECK_FALSE( fld.displayed_field_type() );
+}
+
+// Processing, the random numbers it draws and saving all go through the fields of a
+// tile in this order, so it must not depend on where the entries are stored
+TEST_CASE( "field_entries_are_visited_in_type_order", "[field]" )
+{
+    std::vector<field_type_id> types = { fd_blood, fd_bile, fd_slime, fd_acid, fd_smoke, fd_fire };
+    std::sort( types.begin(), types.end() );
+    const auto visited = []( const field & fld ) {
+        std::vector<field_type_id> result;
+        for( const field::value_type &entry : fld ) {
+            result.push_back( entry.first );
+        }
+        return result;
+    };
+
+    field fld;
+    for( auto it = types.rbegin(); it != types.rend(); ++it ) {
+        fld.add_field( *it, 1 );
+    }
+    CHECK( visited( fld ) == types );
+
+    // Holes are filled by later types without changing the order
+    fld.remove_field( types[4] );
+    fld.remove_field( types[0] );
+    fld.add_field( types[0], 1 );
+    CHECK( visited( fld ) == std::vector<field_type_id> { types[0], types[1], types[2], types[3], types[5] } );
+
+    // Like with a std::map, entries added while going through them are only reached
+    // when their type comes after the current one
+    std::vector<field_type_id> reached;
+    for( const field::value_type &entry : fld ) {
+        reached.push_back( entry.first );
+        if( entry.first == types[2] ) {
+            fld.add_field( types[4], 1 );
+            fld.remove_field( types[0] );
+            fld.add_field( types[0], 1 );
+        }
+    }
+    CHECK( reached == std::vector<field_type_id> { types[0], types[1], types[2], types[3], types[4], types[5] } );
+    CHECK( visited( fld ) == types );
+}
+
+TEST_CASE( "field_processing_visits_only_tiles_with_fields", "[field]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    map &here = get_map();
+    const tripoint p( 30, 30, 0 );
+    tripoint sm_pos = here.getabs( p );
+    const point l = ms_to_sm_remain( sm_pos.x, sm_pos.y );
+    submap *const sm = MAPBUFFER.lookup_submap( sm_pos );
+    REQUIRE( sm != nullptr );
+    REQUIRE( sm->get_field_tiles().none() );
+
+    here.add_field( p, fd_blood, 1 );
+    CHECK( sm->get_field_tiles().count() == 1 );
+    CHECK( sm->get_field_tiles()[l.x * SEEY + l.y] );
+
+    // Processing forgets the tile once its fields are gone
+    here.remove_field( p, fd_blood );
+    here.process_fields();
+    CHECK( sm->get_field_tiles().none() );
+
+    // A fire that spreads and smokes keeps every burning tile in the set
+    here.add_field( p, fd_fire, 3, 1_turns );
+    for( int i = 0; i < 20; i++ ) {
+        here.process_fields();
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            if( sm->get_field( point( x, y ) ).field_count() > 0 ) {
+                CHECK( sm->get_field_tiles()[x * SEEY + y] );
+            }
+        }
+    }
+}
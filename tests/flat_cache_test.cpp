@@ -0,0 +1,95 @@
+#include "catch/catch.hpp"
+
+#include <vector>
+
+#include "flat_cache.h"
+#include "lru_cache.h"
+#include "point.h"
+#include "rng.h"
+
+TEST_CASE( "flat_cache_remembers_and_forgets", "[flat_cache]" )
+{
+    flat_cache<tripoint, int> cache( 1000 );
+    CHECK( cache.capacity() == 1024 );
+    CHECK( cache.get( tripoint_zero, -1 ) == -1 );
+
+    cache.insert( tripoint( 1, 2, 3 ), 5 );
+    cache.insert( tripoint( 3, 2, 1 ), 7 );
+    CHECK( cache.get( tripoint( 1, 2, 3 ), -1 ) == 5 );
+    CHECK( cache.get( tripoint( 3, 2, 1 ), -1 ) == 7 );
+
+    cache.insert( tripoint( 1, 2, 3 ), 6 );
+    CHECK( cache.get( tripoint( 1, 2, 3 ), -1 ) == 6 );
+
+    cache.remove( tripoint( 1, 2, 3 ) );
+    CHECK( cache.get( tripoint( 1, 2, 3 ), -1 ) == -1 );
+    CHECK( cache.get( tripoint( 3, 2, 1 ), -1 ) == 7 );
+
+    cache.clear();
+    CHECK( cache.get( tripoint( 3, 2, 1 ), -1 ) == -1 );
+    cache.insert( tripoint( 3, 2, 1 ), 8 );
+    CHECK( cache.get( tripoint( 3, 2, 1 ), -1 ) == 8 );
+}
+
+TEST_CASE( "flat_cache_never_returns_wrong_values_when_full", "[flat_cache]" )
+{
+    flat_cache<point, char> cache( 64 );
+    for( int i = 0; i < 10000; i++ ) {
+        const point p( rng( -100, 100 ), rng( -100, 100 ) );
+        const char value = ( p.x + p.y ) & 1;
+        const char cached = cache.get( p, -1 );
+        if( cached != -1 ) {
+            REQUIRE( cached == value );
+        }
+        cache.insert( p, value );
+        REQUIRE( cache.get( p, -1 ) == value );
+    }
+}
+
+// Same access pattern as map::sees: a few creatures looking at each other repeatedly,
+// with the cache cleared now and then because something changed transparency.
+template<typename Get, typename Insert, typename Clear>
+static int simulate_sees( const std::vector<point> &keys, Get get, Insert insert, Clear clear )
+{
+    int hits = 0;
+    for( size_t i = 0; i < keys.size(); i++ ) {
+        if( i % 20000 == 0 ) {
+            clear();
+        }
+        if( get( keys[i] ) >= 0 ) {
+            hits++;
+        } else {
+            insert( keys[i] );
+        }
+    }
+    return hits;
+}
+
+TEST_CASE( "bench_visibility_caches", "[flat_cache][benchmark][.]" )
+{
+    std::vector<point> keys;
+    for( int i = 0; i < 100000; i++ ) {
+        keys.emplace_back( rng( 0, 200 ), rng( 0, 200 ) );
+    }
+
+    BENCHMARK( "lru_cache" ) {
+        lru_cache<point, char> cache;
+        return simulate_sees( keys, [&]( const point & p ) {
+            return cache.get( p, -1 );
+        }, [&]( const point & p ) {
+            cache.insert( 100000, p, 1 );
+        }, [&]() {
+            cache.clear();
+        } );
+    };
+    BENCHMARK( "flat_cache" ) {
+        flat_cache<point, char> cache( 100000 );
+        return simulate_sees( keys, [&]( const point & p ) {
+            return cache.get( p, -1 );
+        }, [&]( const point & p ) {
+            cache.insert( p, 1 );
+        }, [&]() {
+            cache.clear();
+        } );
+    };
+}
@@ -252,6 +252,11 @@ static void test_get_string( const std::string &str, const std::string &json )
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK( jsin.get_string() == str );
+    JsonIn jsin_memory( json );
+    CHECK( jsin_memory.get_string() == str );
+    JsonIn jsin_view( json );
+    std::string storage;
+    CHECK( jsin_view.get_string_view( storage ) == str );
 }
 
 template<typename Matcher>
@@ -261,6 +266,8 @@ static void test_get_string_throws_matches( Matcher &&matcher, const std::string
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.get_string(), JsonError, matcher );
+    JsonIn jsin_memory( json );
+    CHECK_THROWS_MATCHES( jsin_memory.get_string(), JsonError, matcher );
 }
 
 template<typename Matcher>
@@ -272,6 +279,8 @@ static void test_string_error_throws_matches( Matcher &&matcher, const std::stri
     std::istringstream iss( json );
     JsonIn jsin( iss );
     CHECK_THROWS_MATCHES( jsin.string_error( "<message>", offset ), JsonError, matcher );
+    JsonIn jsin_memory( json );
+    CHECK_THROWS_MATCHES( jsin_memory.string_error( "<message>", offset ), JsonError, matcher );
 }
 
 TEST_CASE( "jsonin_get_string", "[json]" )
@@ -462,6 +471,63 @@ TEST_CASE( "jsonin_get_string", "[json]" )
         R"("foo\nbar")", 5 );
 }
 
+TEST_CASE( "jsonin_memory_matches_stream", "[json]" )
+{
+    const std::string json =
+        R"({ "id": "foo", "name": { "str": "b\u00e4r" }, "list": [ 1, 2.5, "x\ny", true, null ],)" "\n"
+        R"(  "skipped": { "a": [ "\"", { } ], "b": false }, "last": "…" })";
+
+    const auto read_all = [&]( JsonIn & jsin ) {
+        std::ostringstream out;
+        JsonObject jo = jsin.get_object();
+        jo.allow_omitted_members();
+        out << jo.get_string( "id" ) << ';' << jo.get_object( "name" ).get_string( "str" ) << ';';
+        JsonArray list = jo.get_array( "list" );
+        out << list.next_int() << ';' << list.next_float() << ';' << list.next_string() << ';';
+        out << list.next_bool() << ';';
+        list.skip_value();
+        out << jo.get_string( "last" );
+        return out.str();
+    };
+
+    std::istringstream iss( json );
+    JsonIn jsin( iss );
+    JsonIn jsin_memory( json );
+    const std::string from_stream = read_all( jsin );
+    CHECK( from_stream == "foo;b\u00e4r;1;2.5;x\ny;1;…" );
+    CHECK( read_all( jsin_memory ) == from_stream );
+
+    // Member names without escapes point into the data
+    JsonIn jsin_view( json );
+    std::string storage;
+    jsin_view.start_object();
+    const std::string_view name = jsin_view.get_member_name_view( storage );
+    CHECK( name == "id" );
+    CHECK( storage.empty() );
+    CHECK( name.data() >= json.data() );
+    CHECK( name.data() < json.data() + json.size() );
+
+    // Errors point to the same place
+    const std::string broken = "{\n  \"a\": [ 1, 2 ],\n  \"b\": [ 1 2 ]\n}";
+    std::istringstream broken_iss( broken );
+    JsonIn broken_jsin( broken_iss );
+    JsonIn broken_memory( broken );
+    std::string stream_error;
+    std::string memory_error;
+    try {
+        broken_jsin.skip_value();
+    } catch( const JsonError &err ) {
+        stream_error = err.what();
+    }
+    try {
+        broken_memory.skip_value();
+    } catch( const JsonError &err ) {
+        memory_error = err.what();
+    }
+    CHECK_FALSE( stream_error.empty() );
+    CHECK( memory_error == stream_error );
+}
+
 TEST_CASE( "serialize_optional", "[json]" )
 {
     SECTION( "simple_empty_optional" ) {
@@ -0,0 +1,103 @@
+#include "catch/catch.hpp"
+
+#include <string>
+#include <vector>
+
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "point.h"
+#include "rng.h"
+#include "shadowcasting.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "thread_pool.h"
+#include "type_id.h"
+
+// Scatters light emitting terrain, lit monsters and walls over the reality bubble at night.
+static void place_lights( const int num_lights )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    set_time( calendar::turn_zero );
+
+    map &here = get_map();
+    const auto random_point = []() {
+        return tripoint( rng( 0, MAPSIZE_X - 1 ), rng( 0, MAPSIZE_Y - 1 ), 0 );
+    };
+    for( int i = 0; i < num_lights * 4; i++ ) {
+        here.ter_set( random_point(), t_brick_wall );
+    }
+    for( int i = 0; i < num_lights; i++ ) {
+        here.ter_set( random_point(), t_utility_light );
+    }
+    for( int i = 0; i < num_lights / 10; i++ ) {
+        const tripoint p = random_point();
+        if( here.passable( p ) && !g->critter_at( p ) ) {
+            spawn_test_monster( "mon_EMP_hack", p );
+        }
+    }
+    here.invalidate_map_cache( 0 );
+}
+
+static void rebuild_lightmap( const bool parallel )
+{
+    parallel_lightmap = parallel;
+    map &here = get_map();
+    here.invalidate_map_cache( 0 );
+    here.build_map_cache( 0 );
+}
+
+TEST_CASE( "parallel_lightmap_is_identical_to_serial", "[lightmap]" )
+{
+    restore_on_out_of_scope<bool> restore_parallel_lightmap( parallel_lightmap );
+    const int num_lights = GENERATE( 1, 10, 200 );
+    CAPTURE( num_lights );
+    place_lights( num_lights );
+
+    const level_cache &cache = get_map().access_cache( 0 );
+
+    rebuild_lightmap( false );
+    std::vector<four_quadrants> serial_lm( &cache.lm[0][0], &cache.lm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+    std::vector<float> serial_sm( &cache.sm[0][0], &cache.sm[0][0] + MAPSIZE_X * MAPSIZE_Y );
+
+    rebuild_lightmap( true );
+    int lm_mismatches = 0;
+    int sm_mismatches = 0;
+    for( int x = 0; x < MAPSIZE_X; x++ ) {
+        for( int y = 0; y < MAPSIZE_Y; y++ ) {
+            if( cache.lm[x][y].values != serial_lm[x * MAPSIZE_Y + y].values ) {
+                lm_mismatches++;
+            }
+            if( cache.sm[x][y] != serial_sm[x * MAPSIZE_Y + y] ) {
+                sm_mismatches++;
+            }
+        }
+    }
+    CHECK( lm_mismatches == 0 );
+    CHECK( sm_mismatches == 0 );
+}
+
+// Measure how lightmap generation scales with the number of light sources and worker threads
+TEST_CASE( "bench_parallel_lightmap", "[lightmap][benchmark][.]" )
+{
+    restore_on_out_of_scope<bool> restore_parallel_lightmap( parallel_lightmap );
+    cata_printf( "Threads: %d\n", get_thread_pool().concurrency() );
+
+    for( const int num_lights : {
+             10, 100, 1000
+         } ) {
+        place_lights( num_lights );
+        BENCHMARK( string_format( "serial, %d lights", num_lights ) ) {
+            rebuild_lightmap( false );
+        };
+        BENCHMARK( string_format( "parallel, %d lights", num_lights ) ) {
+            rebuild_lightmap( true );
+        };
+    }
+}
@@ -1,14 +1,21 @@
 #include "catch/catch.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
+#include "cata_utility.h"
 #include "enums.h"
 #include "game.h"
 #include "game_constants.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "map_iterator.h"
+#include "mapdata.h"
 #include "point.h"
 #include "state_helpers.h"
 #include "type_id.h"
@@ -144,3 +151,86 @@ TEST_CASE( "bash_through_roof_can_destroy_multiple_times" )
         }
     }
 }
+
+TEST_CASE( "parallel_map_cache_is_identical_to_serial" )
+{
+    clear_all_state();
+    map &here = get_map();
+    REQUIRE( here.has_zlevels() );
+    restore_on_out_of_scope<bool> restore_parallel_map_cache( parallel_map_cache );
+
+    static const ter_str_id t_flat_roof( "t_flat_roof" );
+
+    // A small building with a roof and a hole in the floor, so every cache has something in it
+    for( const tripoint &p : here.points_in_rectangle( tripoint( 60, 60, 0 ), tripoint( 70, 70, 0 ) ) ) {
+        const bool edge = p.x == 60 || p.x == 70 || p.y == 60 || p.y == 70;
+        here.ter_set( p, edge ? t_brick_wall : t_floor );
+        here.ter_set( p + tripoint_above, t_flat_roof );
+    }
+    here.ter_set( tripoint( 65, 65, 0 ), t_open_air );
+    here.ter_set( tripoint( 65, 65, -1 ), t_rock_floor );
+
+    const auto rebuild = [&]( const bool parallel ) {
+        parallel_map_cache = parallel;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            here.invalidate_map_cache( z );
+        }
+        here.build_map_cache( 0, true );
+        std::vector<level_cache> result;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+            result.push_back( here.access_cache( z ) );
+        }
+        return result;
+    };
+
+    const std::vector<level_cache> serial = rebuild( false );
+    const std::vector<level_cache> parallel = rebuild( true );
+    for( size_t i = 0; i < serial.size(); i++ ) {
+        CAPTURE( static_cast<int>( i ) - OVERMAP_DEPTH );
+        CHECK( std::equal( &serial[i].outside_cache[0][0], &serial[i].outside_cache[0][0] + MAPSIZE_X * MAPSIZE_Y,
+                           &parallel[i].outside_cache[0][0] ) );
+        CHECK( std::equal( &serial[i].floor_cache[0][0], &serial[i].floor_cache[0][0] + MAPSIZE_X * MAPSIZE_Y,
+                           &parallel[i].floor_cache[0][0] ) );
+        CHECK( std::equal( &serial[i].transparency_cache[0][0],
+                           &serial[i].transparency_cache[0][0] + MAPSIZE_X * MAPSIZE_Y,
+                           &parallel[i].transparency_cache[0][0] ) );
+    }
+}
+
+TEST_CASE( "terrain_and_furniture_flags_are_interned", "[map]" )
+{
+    clear_all_state();
+    std::set<std::string> all_flags;
+    const auto check_flags = [&]( const map_data_common_t &data ) {
+        for( const std::string &flag : data.get_flags() ) {
+            all_flags.insert( flag );
+            const ter_furn_flag_id id = ter_furn_flag_id::find( flag );
+            REQUIRE( id.is_valid() );
+            CHECK( id.str() == flag );
+            CHECK( data.has_flag( id ) );
+            CHECK( data.has_flag( flag ) );
+        }
+    };
+    for( const ter_t &ter : ter_t::get_all() ) {
+        check_flags( ter );
+    }
+    for( const furn_t &furn : furn_t::get_all() ) {
+        check_flags( furn );
+    }
+
+    // Every flag of some type is missing from the types that don't have it
+    const ter_t &dirt = ter_str_id( "t_dirt" ).obj();
+    for( const std::string &flag : all_flags ) {
+        CHECK( dirt.has_flag( flag ) == dirt.get_flags().contains( flag ) );
+    }
+
+    CHECK_FALSE( ter_furn_flag_id::find( "NOT_A_TERRAIN_FLAG" ).is_valid() );
+    CHECK_FALSE( dirt.has_flag( "NOT_A_TERRAIN_FLAG" ) );
+    const ter_furn_flag_id &unused = TER_FURN_FLAG( "NOT_A_TERRAIN_FLAG_EITHER" );
+    CHECK( unused.is_valid() );
+    CHECK( ter_furn_flag_id::find( "NOT_A_TERRAIN_FLAG_EITHER" ) == unused );
+    CHECK_FALSE( dirt.has_flag( unused ) );
+    CHECK( TER_FURN_FLAG( "DIGGABLE" ) == ter_furn_flag_id( "DIGGABLE" ) );
+    CHECK( get_map().has_flag( TER_FURN_FLAG( "DIGGABLE" ), tripoint_zero ) ==
+           get_map().has_flag( "DIGGABLE", tripoint_zero ) );
+}
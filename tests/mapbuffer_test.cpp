@@ -0,0 +1,179 @@
+#include "catch/catch.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_utility.h"
+#include "coordinate_conversions.h"
+#include "game_constants.h"
+#include "map.h"
+#include "mapbuffer.h"
+#include "mapdata.h"
+#include "point.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+#include "type_id.h"
+
+static std::vector<tripoint> quad_submaps( const tripoint &om_addr )
+{
+    const tripoint origin = omt_to_sm_copy( om_addr );
+    return {
+        origin, origin + point_south, origin + point_east, origin + point_south_east
+    };
+}
+
+// A quad with a bit of everything the binary format encodes on its own
+static void fill_quad( mapbuffer &buffer, const std::vector<tripoint> &submap_addrs )
+{
+    const std::vector<ter_id> terrain = { t_floor, t_dirt, t_grass, t_brick_wall };
+    const std::vector<furn_id> furniture = { f_null, f_null, f_chair, f_table };
+    const std::vector<trap_id> traps = { tr_null, tr_null, tr_null, trap_str_id( "tr_pit" ).id() };
+    for( const tripoint &submap_addr : submap_addrs ) {
+        std::unique_ptr<submap> sm = std::make_unique<submap>( sm_to_ms_copy( submap_addr ) );
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                const point p( x, y );
+                // Mostly long runs, with some noise
+                const int pick = one_in( 5 ) ? rng( 0, 3 ) : y / 3;
+                sm->set_ter( p, terrain[pick] );
+                sm->set_furn( p, furniture[pick] );
+                sm->set_trap( p, traps[pick] );
+                sm->set_radiation( p, x < 4 ? 0 : rng( -1, 20 ) );
+            }
+        }
+        sm->set_graffiti( point( 3, 4 ), "round trip" );
+        sm->set_temperature( rng( -20, 40 ) );
+        sm->last_touched = calendar::turn_zero + time_duration::from_turns( rng( 0, 100000 ) );
+        REQUIRE( buffer.add_submap( submap_addr, sm ) );
+    }
+}
+
+static std::string write_quad( const mapbuffer &buffer, const std::vector<tripoint> &submap_addrs,
+                               bool binary )
+{
+    std::ostringstream out;
+    buffer.write_quad( out, submap_addrs, binary );
+    return out.str();
+}
+
+static void read_quad( mapbuffer &buffer, const std::string &data )
+{
+    std::istringstream in( data );
+    buffer.read_quad( in );
+}
+
+TEST_CASE( "map_quads_survive_a_round_trip_in_both_formats", "[mapbuffer]" )
+{
+    const std::vector<tripoint> submap_addrs = quad_submaps( tripoint( 7, -3, 0 ) );
+    mapbuffer original;
+    fill_quad( original, submap_addrs );
+
+    const bool binary = GENERATE( false, true );
+    CAPTURE( binary );
+    const std::string data = write_quad( original, submap_addrs, binary );
+
+    mapbuffer loaded;
+    read_quad( loaded, data );
+    for( const tripoint &submap_addr : submap_addrs ) {
+        CAPTURE( submap_addr );
+        REQUIRE( loaded.is_submap_loaded( submap_addr ) );
+        const submap &expected = *original.lookup_submap( submap_addr );
+        const submap &actual = *loaded.lookup_submap( submap_addr );
+        int mismatches = 0;
+        for( int x = 0; x < SEEX; x++ ) {
+            for( int y = 0; y < SEEY; y++ ) {
+                const point p( x, y );
+                if( actual.get_ter( p ) != expected.get_ter( p ) ||
+                    actual.get_furn( p ) != expected.get_furn( p ) ||
+                    actual.get_trap( p ) != expected.get_trap( p ) ||
+                    actual.get_radiation( p ) != expected.get_radiation( p ) ) {
+                    mismatches++;
+                }
+            }
+        }
+        CHECK( mismatches == 0 );
+        CHECK( actual.get_graffiti( point( 3, 4 ) ) == "round trip" );
+        CHECK( actual.get_temperature() == expected.get_temperature() );
+        CHECK( actual.last_touched == expected.last_touched );
+    }
+
+    // Saves of either format stay readable whatever the current setting is
+    const std::string other_data = write_quad( loaded, submap_addrs, !binary );
+    mapbuffer reloaded;
+    read_quad( reloaded, other_data );
+    for( const tripoint &submap_addr : submap_addrs ) {
+        CHECK( reloaded.is_submap_loaded( submap_addr ) );
+    }
+}
+
+TEST_CASE( "map_quads_reject_truncated_binary_data", "[mapbuffer]" )
+{
+    const std::vector<tripoint> submap_addrs = quad_submaps( tripoint_zero );
+    mapbuffer original;
+    fill_quad( original, submap_addrs );
+    const std::string data = write_quad( original, submap_addrs, true );
+
+    mapbuffer loaded;
+    CHECK_THROWS( read_quad( loaded, data.substr( 0, data.size() / 2 ) ) );
+}
+
+TEST_CASE( "only_changed_quads_outside_the_bubble_are_saved", "[mapbuffer]" )
+{
+    clear_all_state();
+    // Tests don't write the map unless asked to
+    restore_on_out_of_scope<bool> restore_mapgen( disable_mapgen );
+    disable_mapgen = false;
+
+    const std::vector<tripoint> changed_addrs = quad_submaps( tripoint( 200, 200, 0 ) );
+    const std::vector<tripoint> untouched_addrs = quad_submaps( tripoint( 202, 200, 0 ) );
+    fill_quad( MAPBUFFER, changed_addrs );
+    fill_quad( MAPBUFFER, untouched_addrs );
+    const std::string untouched_data = write_quad( MAPBUFFER, untouched_addrs, false );
+    // Both are new, so both are written, and dropped from the buffer as they are far away
+    MAPBUFFER.save();
+    REQUIRE_FALSE( MAPBUFFER.is_submap_loaded( changed_addrs.front() ) );
+    REQUIRE_FALSE( MAPBUFFER.is_submap_loaded( untouched_addrs.front() ) );
+
+    // Read as it is on disk, without being handed out for changes
+    read_quad( MAPBUFFER, untouched_data );
+    submap *changed = MAPBUFFER.lookup_submap( changed_addrs.front() );
+    REQUIRE( changed != nullptr );
+    const ter_id old_ter = changed->get_ter( point_zero );
+    const ter_id new_ter = old_ter == t_rock_floor ? t_dirt : t_rock_floor;
+    changed->set_ter( point_zero, new_ter );
+    MAPBUFFER.save();
+    CHECK( MAPBUFFER.get_last_save_stats().quads_skipped == 1 );
+
+    mapbuffer reloaded;
+    const submap *saved = reloaded.lookup_submap( changed_addrs.front() );
+    REQUIRE( saved != nullptr );
+    CHECK( saved->get_ter( point_zero ) == new_ter );
+}
+
+TEST_CASE( "bench_map_quad_formats", "[mapbuffer][benchmark][.]" )
+{
+    const std::vector<tripoint> submap_addrs = quad_submaps( tripoint_zero );
+    mapbuffer original;
+    fill_quad( original, submap_addrs );
+
+    for( const bool binary : {
+             false, true
+         } ) {
+        const std::string data = write_quad( original, submap_addrs, binary );
+        cata_printf( "%s quad: %d bytes\n", binary ? "binary" : "json", data.size() );
+        BENCHMARK( binary ? "write binary" : "write json" ) {
+            return write_quad( original, submap_addrs, binary );
+        };
+        BENCHMARK( binary ? "read binary" : "read json" ) {
+            mapbuffer loaded;
+            read_quad( loaded, data );
+            return loaded.is_submap_loaded( submap_addrs.front() );
+        };
+    }
+}
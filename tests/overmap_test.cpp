@@ -7,6 +7,7 @@
 #include "calendar.h"
 #include "enums.h"
 #include "game_constants.h"
+#include "mongroup.h"
 #include "numeric_interval.h"
 #include "omdata.h"
 #include "overmap.h"
@@ -18,6 +19,8 @@
 #include "state_helpers.h"
 #include "type_id.h"
 
+static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+
 TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
 {
     clear_all_state();
@@ -213,3 +216,49 @@ TEST_CASE( "mutable_overmap_placement", "[overmap][slow]" )
         CHECK( successes > num_trials_per_overmap / 2 );
     }
 }
+
+TEST_CASE( "noise_reaches_the_hordes_in_range", "[overmap]" )
+{
+    clear_all_state();
+    overmap &om = overmap_buffer.get( point_abs_om() );
+    om.clear_mon_groups();
+    const point_om_sm far_away( 300, 300 );
+    const auto add_horde = [&]( const point_om_sm & pos ) {
+        mongroup group( GROUP_ZOMBIE, tripoint_om_sm( pos, 0 ), 1, 10 );
+        group.horde = true;
+        group.set_target( far_away );
+        om.add_mon_group( group );
+    };
+    const auto heard = [&]( const point_om_sm & pos, const point_om_sm & noise ) {
+        const std::vector<mongroup *> groups = overmap_buffer.groups_at( tripoint_abs_sm( pos.x(),
+                                               pos.y(), 0 ) );
+        REQUIRE( groups.size() == 1 );
+        return groups.front()->target.xy() == noise;
+    };
+
+    const point_om_sm noise( 100, 100 );
+    // In range, one of them in the next cell of the horde grid
+    const point_om_sm close_by( 105, 100 );
+    const point_om_sm next_cell( 104, 95 );
+    // Out of range, one of them in a cell the noise reaches
+    const point_om_sm beyond( 100, 111 );
+    const point_om_sm far_off( 150, 100 );
+    for( const point_om_sm &pos : { close_by, next_cell, beyond, far_off } ) {
+        add_horde( pos );
+    }
+    overmap_buffer.signal_hordes( tripoint_abs_sm( noise.x(), noise.y(), 0 ), 10 );
+    CHECK( heard( close_by, noise ) );
+    CHECK( heard( next_cell, noise ) );
+    CHECK_FALSE( heard( beyond, noise ) );
+    CHECK_FALSE( heard( far_off, noise ) );
+
+    // Hordes added later are heard too
+    const point_om_sm late( 145, 105 );
+    add_horde( late );
+    const point_om_sm second_noise( 150, 102 );
+    overmap_buffer.signal_hordes( tripoint_abs_sm( second_noise.x(), second_noise.y(), 0 ),
+                                  10 );
+    CHECK( heard( late, second_noise ) );
+    CHECK( heard( far_off, second_noise ) );
+    CHECK( heard( close_by, noise ) );
+}
@@ -0,0 +1,97 @@
+#include "catch/catch.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapdata.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+
+static bool route_crosses( const std::vector<tripoint> &route, const ter_id &ter )
+{
+    const map &here = get_map();
+    return std::ranges::any_of( route, [&]( const tripoint & p ) {
+        return here.ter( p ) == ter;
+    } );
+}
+
+TEST_CASE( "pathfinding_d_maps_follow_terrain_changes_between_turns", "[pathfinding]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    Pathfinding::clear_d_maps();
+
+    map &here = get_map();
+    const tripoint from( 50, 60, 0 );
+    const tripoint to( 70, 60, 0 );
+
+    std::vector<tripoint> route = Pathfinding::route( from, to );
+    REQUIRE( !route.empty() );
+    CHECK( route.front() == from );
+    CHECK( route.back() == to );
+    CHECK( route.size() == 21 );
+
+    // Wall off the straight line, the d_map kept from the previous turn has to notice
+    Pathfinding::prune_d_maps();
+    for( int y = 50; y <= 70; y++ ) {
+        here.ter_set( tripoint( 60, y, 0 ), t_brick_wall );
+    }
+    route = Pathfinding::route( from, to );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    CHECK_FALSE( route_crosses( route, t_brick_wall ) );
+    CHECK( route.size() > 21 );
+
+    // Open a gap in the middle of the wall again
+    Pathfinding::prune_d_maps();
+    here.ter_set( tripoint( 60, 60, 0 ), t_floor );
+    route = Pathfinding::route( from, to );
+    REQUIRE( !route.empty() );
+    CHECK( route.back() == to );
+    CHECK_FALSE( route_crosses( route, t_brick_wall ) );
+    CHECK( route.size() == 21 );
+
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE( "pathfinding_flow_field_leads_everyone_to_the_goal", "[pathfinding]" )
+{
+    clear_all_state();
+    build_test_map( t_floor );
+    Pathfinding::clear_d_maps();
+
+    map &here = get_map();
+    const tripoint goal( 60, 60, 0 );
+    for( int y = 50; y <= 70; y++ ) {
+        here.ter_set( tripoint( 55, y, 0 ), t_brick_wall );
+    }
+
+    const PathfindingSettings path_settings;
+    const RouteSettings route_settings;
+    for( const tripoint &start : {
+             tripoint( 40, 60, 0 ), tripoint( 45, 52, 0 ), tripoint( 80, 75, 0 ), tripoint( 61, 60, 0 )
+         } ) {
+        CAPTURE( start );
+        const std::vector<tripoint> route = Pathfinding::route( start, goal, path_settings, route_settings );
+        REQUIRE( !route.empty() );
+
+        std::vector<tripoint> walked{ start };
+        // Bounded in case the field ever leads in circles
+        while( walked.back() != goal && walked.size() <= 4 * route.size() ) {
+            const std::optional<tripoint> step = Pathfinding::flow_field_step( walked.back(), goal,
+                                                 path_settings, route_settings );
+            REQUIRE( step.has_value() );
+            CHECK( square_dist( *step, walked.back() ) == 1 );
+            walked.push_back( *step );
+        }
+        CHECK( walked.back() == goal );
+        CHECK_FALSE( route_crosses( walked, t_brick_wall ) );
+    }
+
+    Pathfinding::clear_d_maps();
+}
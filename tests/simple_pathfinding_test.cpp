@@ -2,9 +2,15 @@
 
 #include "simple_pathfinding.h"
 
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
 #include "line.h"
+#include "overmap_path_graph.h"
 #include "point.h"
 #include "state_helpers.h"
 
@@ -140,3 +146,75 @@ TEST_CASE( "find_overmap_path_bridge", "[pathfinding]" )
     CHECK( pth.points[0] == Point( 2, 0, 0 ) );
 }
 
+
+TEST_CASE( "overmap_path_graph_routes_over_the_bridge", "[pathfinding]" )
+{
+    using Point = tripoint_abs_omt;
+    const inclusive_cuboid<Point> bounds( Point( 0, 0, 0 ), Point( 149, 99, 1 ) );
+    // A river blocks x 70 to 72 on the surface, the bridge over it is at y = bridge_y
+    int bridge_y = 40;
+    uint64_t revision = 1;
+    const auto passable = [&]( const Point & p ) {
+        if( !bounds.contains( p ) ) {
+            return false;
+        }
+        if( p.z() == 1 ) {
+            return p.y() == bridge_y && p.x() >= 69 && p.x() <= 73;
+        }
+        return p.x() < 70 || p.x() > 72;
+    };
+    const auto is_ramp = [&]( const Point & p ) {
+        return p.y() == bridge_y && ( p.x() == 69 || p.x() == 73 );
+    };
+    overmap_path_graph graph( [&]( const Point & p ) {
+        return passable( p ) ? 10 : -1;
+    }, is_ramp, [&]( const point_abs_om & ) {
+        return revision;
+    } );
+
+    const Point start( 5, 5, 0 );
+    const Point finish( 140, 90, 0 );
+    const auto check_route = [&]( const std::vector<Point> &path ) {
+        REQUIRE( path.size() > 1 );
+        CHECK( path.front() == finish );
+        CHECK( path.back() == start );
+        bool crossed = false;
+        for( size_t i = 0; i + 1 < path.size(); i++ ) {
+            CAPTURE( path[i] );
+            CHECK( passable( path[i] ) );
+            const tripoint step = ( path[i] - path[i + 1] ).raw();
+            CHECK( std::abs( step.x ) + std::abs( step.y ) + std::abs( step.z ) == 1 );
+            if( step.z != 0 ) {
+                CHECK( is_ramp( path[i].z() == 0 ? path[i] : path[i + 1] ) );
+            }
+            crossed |= path[i].z() == 1 && path[i].y() == bridge_y;
+        }
+        CHECK( crossed );
+        // Not much longer than going straight to the bridge and on from there
+        const int direct = manhattan_dist( start.xy(), point_abs_omt( 70, bridge_y ) ) +
+                           manhattan_dist( point_abs_omt( 72, bridge_y ), finish.xy() ) + 4;
+        CHECK( static_cast<int>( path.size() ) <= direct * 5 / 4 );
+    };
+
+    std::optional<std::vector<Point>> path = graph.find_path( start, finish, 4 * 180 );
+    REQUIRE( path );
+    check_route( *path );
+    CHECK( graph.cluster_count() > 0 );
+
+    // The bridge moves once the terrain changes
+    bridge_y = 80;
+    revision++;
+    path = graph.find_path( start, finish, 4 * 180 );
+    REQUIRE( path );
+    check_route( *path );
+
+    // Short routes and routes below the surface are left to the flat search
+    CHECK_FALSE( graph.find_path( start, start + point( 10, 10 ), 4 * 180 ) );
+    CHECK_FALSE( graph.find_path( start + tripoint_below, finish, 4 * 180 ) );
+    // Nothing if the river can't be crossed at all
+    bridge_y = -10;
+    revision++;
+    path = graph.find_path( start, finish, 4 * 180 );
+    REQUIRE( path );
+    CHECK( path->empty() );
+}
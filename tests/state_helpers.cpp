@@ -1,12 +1,101 @@
 #include "state_helpers.h"
 
+#include <cassert>
+
+#include "avatar.h"
 #include "calendar.h"
 #include "cata_arena.h"
+#include "color.h"
+#include "debug.h"
+#include "distribution_grid.h"
+#include "filesystem.h"
+#include "game.h"
+#include "init.h"
+#include "language.h"
+#include "loading_ui.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "name.h"
+#include "options.h"
+#include "path_info.h"
 #include "player_helpers.h"
+#include "pldata.h"
 #include "weather.h"
+#include "worldfactory.h"
+
+void init_global_game_state( const std::vector<mod_id> &mods,
+                             const option_overrides_t &option_overrides,
+                             const std::string &user_dir )
+{
+    if( !remove_tree( user_dir ) ) {
+        assert( !"Unable to remove user_dir directory.  Check permissions." );
+    }
+    if( !assure_dir_exist( user_dir ) ) {
+        assert( !"Unable to make user_dir directory.  Check permissions." );
+    }
+
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( user_dir );
+    PATH_INFO::set_standard_filenames();
+
+    if( !assure_dir_exist( PATH_INFO::config_dir() ) ) {
+        assert( !"Unable to make config directory.  Check permissions." );
+    }
+
+    if( !assure_dir_exist( PATH_INFO::savedir() ) ) {
+        assert( !"Unable to make save directory.  Check permissions." );
+    }
+
+    if( !assure_dir_exist( PATH_INFO::templatedir() ) ) {
+        assert( !"Unable to make templates directory.  Check permissions." );
+    }
+
+    if( !init_language_system() ) {
+        DebugLog( DL::Error, DC::Main ) << "Failed to init language system.";
+    }
+
+    get_options().init();
+    get_options().load();
+
+    // Apply command-line option overrides for test suite execution.
+    if( !option_overrides.empty() ) {
+        for( const name_value_pair_t &option : option_overrides ) {
+            if( get_options().has_option( option.first ) ) {
+                options_manager::cOpt &opt = get_options().get_option( option.first );
+                opt.setValue( option.second );
+            }
+        }
+    }
+    init_colors();
+
+    g = std::make_unique<game>( );
+    g->new_game = true;
+    g->load_static_data();
+
+    world_generator->set_active_world( nullptr );
+    world_generator->init();
+    WORLDINFO *test_world = world_generator->make_new_world( mods );
+    assert( test_world != nullptr );
+    world_generator->set_active_world( test_world );
+    assert( world_generator->active_world != nullptr );
+
+    calendar::set_eternal_season( get_option<bool>( "ETERNAL_SEASON" ) );
+    calendar::set_season_length( get_option<int>( "SEASON_LENGTH" ) );
+
+    loading_ui ui( false );
+    init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
+
+    g->u = avatar();
+    g->u.create( character_type::NOW );
+
+    g->m = map();
+    disable_mapgen = true;
+
+    g->m.load( tripoint( g->get_levx(), g->get_levy(), g->get_levz() ), false );
+    get_distribution_grid_tracker().load( g->m );
+
+    get_weather().update_weather();
+}
 
 void clear_all_state( )
 {
@@ -2,6 +2,20 @@
 #ifndef CATA_TESTS_STATE_HELPERS_H
 #define CATA_TESTS_STATE_HELPERS_H
 
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "type_id.h"
+
+using name_value_pair_t = std::pair<std::string, std::string>;
+using option_overrides_t = std::vector<name_value_pair_t>;
+
+// Creates a fresh world in user_dir with the given mods and loads the game data.
+void init_global_game_state( const std::vector<mod_id> &mods,
+                             const option_overrides_t &option_overrides,
+                             const std::string &user_dir );
+
 void clear_all_state();
 
 #endif // CATA_TESTS_STATE_HELPERS_H
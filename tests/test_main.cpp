@@ -60,9 +60,6 @@
 #include "weather.h"
 #include "worldfactory.h"
 
-using name_value_pair_t = std::pair<std::string, std::string>;
-using option_overrides_t = std::vector<name_value_pair_t>;
-
 // If tag is found as a prefix of any argument in arg_vec, the argument is
 // removed from arg_vec and the argument suffix after tag is returned.
 // Otherwise, an empty string is returned and arg_vec is unchanged.
@@ -96,80 +93,6 @@ static std::vector<mod_id> extract_mod_selection( std::vector<const char *> &arg
     return ret;
 }
 
-static void init_global_game_state( const std::vector<mod_id> &mods,
-                                    option_overrides_t &option_overrides,
-                                    const std::string &user_dir )
-{
-    if( !remove_tree( user_dir ) ) {
-        assert( !"Unable to remove user_dir directory.  Check permissions." );
-    }
-    if( !assure_dir_exist( user_dir ) ) {
-        assert( !"Unable to make user_dir directory.  Check permissions." );
-    }
-
-    PATH_INFO::init_base_path( "" );
-    PATH_INFO::init_user_dir( user_dir );
-    PATH_INFO::set_standard_filenames();
-
-    if( !assure_dir_exist( PATH_INFO::config_dir() ) ) {
-        assert( !"Unable to make config directory.  Check permissions." );
-    }
-
-    if( !assure_dir_exist( PATH_INFO::savedir() ) ) {
-        assert( !"Unable to make save directory.  Check permissions." );
-    }
-
-    if( !assure_dir_exist( PATH_INFO::templatedir() ) ) {
-        assert( !"Unable to make templates directory.  Check permissions." );
-    }
-
-    if( !init_language_system() ) {
-        DebugLog( DL::Error, DC::Main ) << "Failed to init language system.";
-    }
-
-    get_options().init();
-    get_options().load();
-
-    // Apply command-line option overrides for test suite execution.
-    if( !option_overrides.empty() ) {
-        for( const name_value_pair_t &option : option_overrides ) {
-            if( get_options().has_option( option.first ) ) {
-                options_manager::cOpt &opt = get_options().get_option( option.first );
-                opt.setValue( option.second );
-            }
-        }
-    }
-    init_colors();
-
-    g = std::make_unique<game>( );
-    g->new_game = true;
-    g->load_static_data();
-
-    world_generator->set_active_world( nullptr );
-    world_generator->init();
-    WORLDINFO *test_world = world_generator->make_new_world( mods );
-    assert( test_world != nullptr );
-    world_generator->set_active_world( test_world );
-    assert( world_generator->active_world != nullptr );
-
-    calendar::set_eternal_season( get_option<bool>( "ETERNAL_SEASON" ) );
-    calendar::set_season_length( get_option<int>( "SEASON_LENGTH" ) );
-
-    loading_ui ui( false );
-    init::load_world_modfiles( ui, g->get_active_world(), SAVE_ARTIFACTS );
-
-    g->u = avatar();
-    g->u.create( character_type::NOW );
-
-    g->m = map();
-    disable_mapgen = true;
-
-    g->m.load( tripoint( g->get_levx(), g->get_levy(), g->get_levz() ), false );
-    get_distribution_grid_tracker().load( g->m );
-
-    get_weather().update_weather();
-}
-
 // Checks if any of the flags are in container, removes them all
 static bool check_remove_flags( std::vector<const char *> &cont,
                                 const std::vector<const char *> &flags )
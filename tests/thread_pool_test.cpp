@@ -0,0 +1,66 @@
+#include "catch/catch.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST_CASE( "task_group_runs_its_tasks_and_then_the_continuations", "[thread_pool]" )
+{
+    thread_pool pool( GENERATE( 0, 1, 3 ) );
+    std::atomic<int> ran{ 0 };
+    std::atomic<int> ran_before_continuation{ -1 };
+    bool ran_on_main_thread = false;
+    {
+        task_group group( pool );
+        for( int i = 0; i < 100; i++ ) {
+            group.run( [&]() {
+                // Tasks may queue more tasks of their own
+                pool.submit( []() {} );
+                ran++;
+            } );
+        }
+        group.then( [&]() {
+            ran_before_continuation = ran.load();
+            ran_on_main_thread = pool.on_main_thread();
+        }, true );
+        group.wait();
+        CHECK( ran == 100 );
+    }
+    // The continuation was queued for the main thread once the last task was done
+    pool.run_main_thread_tasks();
+    CHECK( ran_before_continuation == 100 );
+    CHECK( ran_on_main_thread );
+}
+
+TEST_CASE( "task_group_rethrows_errors_of_its_tasks", "[thread_pool]" )
+{
+    thread_pool pool( 2 );
+    task_group group( pool );
+    std::atomic<int> ran{ 0 };
+    for( int i = 0; i < 10; i++ ) {
+        group.run( [&ran, i]() {
+            ran++;
+            if( i == 5 ) {
+                throw std::runtime_error( "task failed" );
+            }
+        } );
+    }
+    CHECK_THROWS_AS( group.wait(), std::runtime_error );
+    CHECK( ran == 10 );
+    CHECK( group.done() );
+}
+
+TEST_CASE( "parallel_for_visits_every_index_once", "[thread_pool]" )
+{
+    thread_pool pool( 3 );
+    std::vector<std::atomic<int>> visits( 1000 );
+    pool.parallel_for( visits.size(), [&]( size_t i ) {
+        visits[i]++;
+    } );
+    for( size_t i = 0; i < visits.size(); i++ ) {
+        CHECK( visits[i] == 1 );
+    }
+}
@@ -240,3 +240,44 @@ TEST_CASE( "Vehicle charging station", "[vehicle][power]" )
     }
 
 }
+
+TEST_CASE( "batteries_charge_and_discharge_evenly", "[vehicle][power]" )
+{
+    clear_all_state();
+    build_test_map( ter_id( "t_pavement" ) );
+
+    vehicle *veh_ptr = g->m.add_vehicle( vproto_id( "none" ), tripoint( 10, 10, 0 ), 0_degrees, 0,
+                                         0 );
+    REQUIRE( veh_ptr != nullptr );
+    const int big_idx = veh_ptr->install_part( point_zero, vpart_id( "storage_battery" ), true );
+    const int small_idx = veh_ptr->install_part( point_zero, vpart_id( "small_storage_battery" ),
+                          true );
+    REQUIRE( big_idx >= 0 );
+    REQUIRE( small_idx >= 0 );
+    REQUIRE( veh_ptr->batteries.size() == 2 );
+    vehicle_part &big_part = veh_ptr->part( big_idx );
+    vehicle_part &small_part = veh_ptr->part( small_idx );
+    veh_ptr->discharge_battery( veh_ptr->fuel_left( fuel_type_battery ), false );
+    REQUIRE( veh_ptr->fuel_left( fuel_type_battery ) == 0 );
+
+    const int capacity = big_part.ammo_capacity() + small_part.ammo_capacity();
+    const auto percent = []( const vehicle_part & p ) {
+        return p.ammo_remaining() * 100 / p.ammo_capacity();
+    };
+
+    CHECK( veh_ptr->charge_battery( capacity / 2, false ) == 0 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == capacity / 2 );
+    CHECK( std::abs( percent( big_part ) - percent( small_part ) ) <= 1 );
+
+    CHECK( veh_ptr->discharge_battery( capacity / 4, false ) == 0 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == capacity / 2 - capacity / 4 );
+    CHECK( std::abs( percent( big_part ) - percent( small_part ) ) <= 1 );
+
+    // What doesn't fit is handed back
+    const int stored = veh_ptr->fuel_left( fuel_type_battery );
+    CHECK( veh_ptr->charge_battery( capacity, false ) == stored );
+    CHECK( big_part.ammo_remaining() == big_part.ammo_capacity() );
+    CHECK( small_part.ammo_remaining() == small_part.ammo_capacity() );
+    CHECK( veh_ptr->discharge_battery( capacity + 5, false ) == 5 );
+    CHECK( veh_ptr->fuel_left( fuel_type_battery ) == 0 );
+}